@@ -8,6 +8,8 @@ import {
 import {
   download,
   exists,
+  hashFile,
+  HashAlgorithm,
   stat,
   mkdir,
   unlink,
@@ -20,6 +22,11 @@ import type { DownloadProgress } from 'react-native-buffered-blob';
 // Small public test file for download tests
 const TEST_URL = 'https://httpbin.org/bytes/1024';
 const TEST_TEXT_URL = 'https://httpbin.org/robots.txt';
+// Streams 64KB of 'a'-'z' slowly and honours Range requests
+const TEST_RANGE_URL =
+  'https://httpbin.org/range/65536?duration=4&chunk_size=1024';
+const TEST_RANGE_SHA256 =
+  '62b3a2ef06cf977623a5936a8fa653e3caecbf69b5f393ebdfe5022affc5331f';
 
 describe('Download', () => {
   let testDir: string;
@@ -87,6 +94,144 @@ describe('Download', () => {
     }
   });
 
+  test('resumable download continues after cancel', async () => {
+    const destPath = join(testDir, 'resumed.bin');
+
+    let cancelled = false;
+    const first = download({
+      url: TEST_RANGE_URL,
+      destPath,
+      resume: true,
+      progressInterval: 0,
+      onProgress: ({ bytesDownloaded }) => {
+        if (!cancelled && bytesDownloaded >= 8192) {
+          cancelled = true;
+          first.cancel();
+        }
+      },
+    });
+    await expect(first.promise).rejects.toThrow();
+    expect(await exists(`${destPath}.resume`)).toBe(true);
+
+    const events: DownloadProgress[] = [];
+    const second = download({
+      url: TEST_RANGE_URL,
+      destPath,
+      resume: true,
+      onProgress: (progress) => {
+        events.push({ ...progress });
+      },
+    });
+    await second.promise;
+
+    expect(await exists(`${destPath}.resume`)).toBe(false);
+    expect((await stat(destPath)).size).toBe(65536);
+    expect(await hashFile(destPath, HashAlgorithm.SHA256)).toBe(
+      TEST_RANGE_SHA256
+    );
+    expect(events[events.length - 1]?.progress).toBe(1);
+  });
+
+  test('segmented download matches a single-stream download', async () => {
+    const url = 'https://httpbin.org/range/262144';
+    const singlePath = join(testDir, 'single.bin');
+    const segmentedPath = join(testDir, 'segmented.bin');
+
+    await download({ url, destPath: singlePath }).promise;
+
+    const events: DownloadProgress[] = [];
+    await download({
+      url,
+      destPath: segmentedPath,
+      segments: 4,
+      minSegmentSize: 65536,
+      onProgress: (progress) => {
+        events.push({ ...progress });
+      },
+    }).promise;
+
+    expect((await stat(segmentedPath)).size).toBe(262144);
+    expect(await hashFile(segmentedPath, HashAlgorithm.SHA256)).toBe(
+      await hashFile(singlePath, HashAlgorithm.SHA256)
+    );
+    expect(events[events.length - 1]?.bytesDownloaded).toBe(262144);
+  });
+
+  test('download verifies expectedHash and expectedSize inline', async () => {
+    const destPath = join(testDir, 'verified.bin');
+
+    await download({
+      url: TEST_RANGE_URL,
+      destPath,
+      expectedHash: {
+        algorithm: HashAlgorithm.SHA256,
+        digest: TEST_RANGE_SHA256,
+      },
+      expectedSize: 65536,
+    }).promise;
+
+    expect((await stat(destPath)).size).toBe(65536);
+  });
+
+  test('download with a wrong digest rejects and removes the file', async () => {
+    const destPath = join(testDir, 'mismatch.bin');
+
+    let error: unknown;
+    try {
+      await download({
+        url: TEST_URL,
+        destPath,
+        expectedHash: { algorithm: HashAlgorithm.SHA256, digest: '00' },
+      }).promise;
+    } catch (e) {
+      error = e;
+    }
+
+    expect(String(error)).toContain('INTEGRITY_MISMATCH');
+    expect(await exists(destPath)).toBe(false);
+  });
+
+  test('stream download delivers the body without a file', async () => {
+    const { promise, stream } = download({
+      url: TEST_RANGE_URL,
+      stream: true,
+      streamBufferSize: 4096,
+    });
+
+    let total = 0;
+    let first: Uint8Array | undefined;
+    let chunk: ArrayBuffer | null;
+    while ((chunk = await stream!.readNextChunk()) !== null) {
+      first ??= new Uint8Array(chunk.slice(0, 4));
+      total += chunk.byteLength;
+    }
+    await promise;
+
+    expect(total).toBe(65536);
+    expect(stream!.bytesRead).toBe(65536);
+    expect(Array.from(first ?? [])).toEqual([97, 98, 99, 100]);
+    expect(await ls(testDir)).toEqual([]);
+  });
+
+  test('stream download can also save to destPath', async () => {
+    const destPath = join(testDir, 'streamed.bin');
+    const { promise, stream } = download({
+      url: TEST_URL,
+      destPath,
+      stream: true,
+    });
+
+    let total = 0;
+    let chunk: ArrayBuffer | null;
+    while ((chunk = await stream!.readNextChunk()) !== null) {
+      total += chunk.byteLength;
+    }
+    await promise;
+
+    expect(total).toBe(1024);
+    expect((await stat(destPath)).size).toBe(1024);
+  });
+
   test('download with custom headers', async () => {
     const destPath = join(testDir, 'headers.bin');
 
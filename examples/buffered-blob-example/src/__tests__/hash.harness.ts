@@ -7,6 +7,9 @@ import {
 } from 'react-native-harness';
 import {
   hashFile,
+  hashFileTree,
+  createHasher,
+  createReader,
   createWriter,
   mkdir,
   unlink,
@@ -78,6 +81,35 @@ describe('Hash', () => {
     expect(hash1).toMatch(/^[a-f0-9]+$/);
   });
 
+  test('hashFile supports BLAKE3, XXH3 and CRC32C', async () => {
+    const filePath = join(testDir, 'fast.txt');
+    await writeText(filePath, 'hello world');
+
+    // Known digests of "hello world"
+    expect(await hashFile(filePath, HashAlgorithm.BLAKE3)).toBe(
+      'd74981efa70a0c880b8d8c1985d075dbcbf679b99a5f9914e5aaf96b831a9e24'
+    );
+    expect(await hashFile(filePath, HashAlgorithm.XXH3)).toBe(
+      'd447b1ea40e6988b'
+    );
+    expect(await hashFile(filePath, HashAlgorithm.CRC32C)).toBe('c99465aa');
+  });
+
+  test('hashFile matches across chunk boundaries on large files', async () => {
+    const filePath = join(testDir, 'large.bin');
+    const data = new Uint8Array(3 * 1024 * 1024 + 17);
+    for (let i = 0; i < data.length; i++) data[i] = i & 0xff;
+    const writer = createWriter(filePath);
+    await writer.write(data.buffer as ArrayBuffer);
+    await writer.flush();
+    writer.close();
+
+    const hash1 = await hashFile(filePath, HashAlgorithm.SHA256);
+    const hash2 = await hashFile(filePath, HashAlgorithm.SHA256);
+    expect(hash1).toBe(hash2);
+    expect(hash1.length).toBe(64);
+  });
+
   test('same content produces same hash', async () => {
     const file1 = join(testDir, 'same1.txt');
     const file2 = join(testDir, 'same2.txt');
@@ -102,4 +134,104 @@ describe('Hash', () => {
 
     expect(hash1).not.toBe(hash2);
   });
+
+  test('createHasher digests incremental updates', async () => {
+    const hasher = createHasher(HashAlgorithm.SHA256);
+    hasher.update(encoder.encode('hello ').buffer as ArrayBuffer);
+    hasher.update(encoder.encode('world').buffer as ArrayBuffer);
+
+    expect(hasher.digest()).toBe(
+      'b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9'
+    );
+    // Digest is final and repeatable
+    expect(hasher.digest()).toBe(
+      'b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9'
+    );
+    hasher.close();
+  });
+
+  test('hasher attached to a writer matches hashFile', async () => {
+    const filePath = join(testDir, 'hashed-write.bin');
+    const hasher = createHasher(HashAlgorithm.XXH3);
+    const writer = createWriter(filePath, false, { hasher });
+    for (let i = 0; i < 8; i++) {
+      const chunk = new Uint8Array(10000).fill(i);
+      await writer.write(chunk.buffer as ArrayBuffer);
+    }
+    await writer.flush();
+    writer.close();
+
+    expect(hasher.digest()).toBe(
+      await hashFile(filePath, HashAlgorithm.XXH3)
+    );
+    hasher.close();
+  });
+
+  test('hasher attached to a reader matches hashFile', async () => {
+    const filePath = join(testDir, 'hashed-read.bin');
+    const data = new Uint8Array(300000);
+    for (let i = 0; i < data.length; i++) data[i] = (i * 7) & 0xff;
+    const writer = createWriter(filePath);
+    await writer.write(data.buffer as ArrayBuffer);
+    await writer.flush();
+    writer.close();
+
+    const hasher = createHasher(HashAlgorithm.BLAKE3);
+    const reader = createReader(filePath, 65536, { readAhead: 2, hasher });
+    let bytes = 0;
+    let chunk: ArrayBuffer | null;
+    while ((chunk = await reader.readNextChunk()) !== null) {
+      bytes += chunk.byteLength;
+    }
+    reader.close();
+
+    expect(bytes).toBe(data.length);
+    expect(hasher.digest()).toBe(
+      await hashFile(filePath, HashAlgorithm.BLAKE3)
+    );
+    hasher.close();
+  });
+
+  test('hashFileTree BLAKE3 matches the standard BLAKE3 digest', async () => {
+    const filePath = join(testDir, 'tree-small.txt');
+    await writeText(filePath, 'hello world');
+
+    const result = await hashFileTree(filePath);
+
+    expect(result.digest).toBe(
+      'd74981efa70a0c880b8d8c1985d075dbcbf679b99a5f9914e5aaf96b831a9e24'
+    );
+  });
+
+  test('hashFileTree SHA256 of a single chunk is plain SHA-256', async () => {
+    const filePath = join(testDir, 'tree-sha.txt');
+    await writeText(filePath, 'hello world');
+
+    const result = await hashFileTree(filePath, {
+      algorithm: HashAlgorithm.SHA256,
+    });
+
+    expect(result.digest).toBe(
+      'b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9'
+    );
+  });
+
+  test('hashFileTree over many chunks matches hashFile', async () => {
+    const filePath = join(testDir, 'tree-large.bin');
+    const data = new Uint8Array(1024 * 1024 + 4099);
+    for (let i = 0; i < data.length; i++) data[i] = (i * 13) & 0xff;
+    const writer = createWriter(filePath);
+    await writer.write(data.buffer as ArrayBuffer);
+    await writer.flush();
+    writer.close();
+
+    const result = await hashFileTree(filePath, {
+      chunkSize: 65536,
+      includeChunkDigests: true,
+    });
+
+    expect(result.digest).toBe(await hashFile(filePath, HashAlgorithm.BLAKE3));
+    expect(result.chunkSize).toBe(65536);
+    expect(result.chunkDigests?.length).toBe(17);
+  });
 });
@@ -8,13 +8,16 @@ import {
 import {
   createWriter,
   createReader,
+  createMappedReader,
   mkdir,
+  stat,
   unlink,
   ls,
   Dirs,
   join,
   BlobError,
   ErrorCode,
+  CompressionFormat,
 } from 'react-native-buffered-blob';
 
 const encoder = new TextEncoder();
@@ -73,6 +76,221 @@ describe('Streaming I/O', () => {
     expect(result).toBe(content);
   });
 
+  test('read-ahead reader returns chunks in order', async () => {
+    const filePath = join(testDir, 'read-ahead.txt');
+    let content = '';
+    for (let i = 0; i < 2000; i++) {
+      content += `line ${i}\n`;
+    }
+    const data = encoder.encode(content);
+
+    const writer = createWriter(filePath);
+    await writer.write(data.buffer as ArrayBuffer);
+    await writer.flush();
+    writer.close();
+
+    const reader = createReader(filePath, 4096, { readAhead: 3 });
+    const chunks: ArrayBuffer[] = [];
+    while (!reader.isEOF) {
+      const chunk = await reader.readNextChunk();
+      if (chunk) chunks.push(chunk);
+    }
+    expect(reader.bytesRead).toBe(data.byteLength);
+    reader.close();
+
+    expect(chunks.length).toBeGreaterThan(1);
+    expect(mergeChunks(chunks)).toBe(content);
+  });
+
+  test('readChunks returns the file in batches', async () => {
+    const filePath = join(testDir, 'read-chunks.txt');
+    let content = '';
+    for (let i = 0; i < 2000; i++) {
+      content += `line ${i}\n`;
+    }
+    const data = encoder.encode(content);
+
+    const writer = createWriter(filePath);
+    await writer.write(data.buffer as ArrayBuffer);
+    await writer.flush();
+    writer.close();
+
+    const reader = createReader(filePath, 4096);
+    const chunks: ArrayBuffer[] = [];
+    let batches = 0;
+    while (true) {
+      const batch = await reader.readChunks(4);
+      if (batch.length === 0) break;
+      expect(batch.length).toBeLessThanOrEqual(4);
+      chunks.push(...batch);
+      batches++;
+    }
+    expect(reader.isEOF).toBe(true);
+    expect(batches).toBeLessThan(chunks.length);
+    expect(mergeChunks(chunks)).toBe(content);
+    reader.close();
+  });
+
+  test('readAt reads ranges without moving the position', async () => {
+    const filePath = join(testDir, 'read-at.txt');
+    const content = '0123456789abcdefghijklmnopqrstuvwxyz';
+    const data = encoder.encode(content);
+
+    const writer = createWriter(filePath);
+    await writer.write(data.buffer as ArrayBuffer);
+    await writer.flush();
+    writer.close();
+
+    const reader = createReader(filePath);
+    const [a, b, tail] = await Promise.all([
+      reader.readAt(10, 6),
+      reader.readAt(0, 4),
+      reader.readAt(30, 100),
+    ]);
+    expect(decoder.decode(new Uint8Array(a))).toBe('abcdef');
+    expect(decoder.decode(new Uint8Array(b))).toBe('0123');
+    expect(decoder.decode(new Uint8Array(tail))).toBe('uvwxyz');
+    expect(reader.bytesRead).toBe(0);
+
+    const first = await reader.readNextChunk();
+    expect(mergeChunks(first ? [first] : [])).toBe(content);
+    reader.close();
+  });
+
+  test('mapped reader returns file contents and slices', async () => {
+    const filePath = join(testDir, 'mapped.txt');
+    const content = 'The quick brown fox jumps over the lazy dog';
+    const data = encoder.encode(content);
+
+    const writer = createWriter(filePath);
+    await writer.write(data.buffer as ArrayBuffer);
+    await writer.flush();
+    writer.close();
+
+    const reader = createMappedReader(filePath, 8);
+    expect(reader.fileSize).toBe(data.byteLength);
+
+    const chunks: ArrayBuffer[] = [];
+    while (!reader.isEOF) {
+      const chunk = await reader.readNextChunk();
+      if (chunk) chunks.push(chunk);
+    }
+    expect(mergeChunks(chunks)).toBe(content);
+    expect(decoder.decode(new Uint8Array(reader.slice(4, 5)))).toBe('quick');
+    expect(reader.slice(40, 100).byteLength).toBe(3);
+    reader.close();
+  });
+
+  test('write-behind writer coalesces small writes', async () => {
+    const filePath = join(testDir, 'write-behind.ndjson');
+    const writer = createWriter(filePath, false, {
+      writeBehind: true,
+      highWaterMark: 4096,
+    });
+    let expected = '';
+    for (let i = 0; i < 1000; i++) {
+      const line = `{"i":${i}}\n`;
+      expected += line;
+      await writer.write(encoder.encode(line).buffer as ArrayBuffer);
+    }
+    await writer.flush();
+    expect(writer.pendingBytes).toBe(0);
+    expect(writer.bytesWritten).toBe(encoder.encode(expected).byteLength);
+    writer.close();
+
+    const reader = createReader(filePath);
+    const chunks: ArrayBuffer[] = [];
+    while (!reader.isEOF) {
+      const chunk = await reader.readNextChunk();
+      if (chunk) chunks.push(chunk);
+    }
+    reader.close();
+    expect(mergeChunks(chunks)).toBe(expected);
+  });
+
+  test('writev writes all buffers in order', async () => {
+    const filePath = join(testDir, 'writev.txt');
+    const parts = ['alpha,', '', 'beta,', 'gamma'];
+    const writer = createWriter(filePath);
+    const total = await writer.writev(
+      parts.map((p) => encoder.encode(p).buffer as ArrayBuffer)
+    );
+    await writer.flush();
+    writer.close();
+    expect(total).toBe(parts.join('').length);
+    expect(writer.bytesWritten).toBe(total);
+
+    const reader = createReader(filePath);
+    const chunks: ArrayBuffer[] = [];
+    while (!reader.isEOF) {
+      const chunk = await reader.readNextChunk();
+      if (chunk) chunks.push(chunk);
+    }
+    reader.close();
+    expect(mergeChunks(chunks)).toBe(parts.join(''));
+  });
+
+  test('gzip writer and reader round-trip natively', async () => {
+    const filePath = join(testDir, 'log.ndjson.gz');
+    const line = '{"level":"info","message":"request served"}\n';
+    const lines = 5000;
+
+    const writer = createWriter(filePath, false, {
+      compress: CompressionFormat.GZIP,
+      writeBehind: true,
+    });
+    for (let i = 0; i < lines; i++) {
+      await writer.write(encoder.encode(line).buffer as ArrayBuffer);
+    }
+    await writer.flush();
+    expect(writer.bytesWritten).toBe(line.length * lines);
+    writer.close();
+
+    const info = await stat(filePath);
+    expect(info.size < line.length * lines).toBe(true);
+
+    const reader = createReader(filePath, 16384, {
+      decompress: CompressionFormat.GZIP,
+      readAhead: 2,
+    });
+    const chunks: ArrayBuffer[] = [];
+    let chunk: ArrayBuffer | null;
+    while ((chunk = await reader.readNextChunk()) !== null) {
+      chunks.push(chunk);
+    }
+    reader.close();
+
+    expect(mergeChunks(chunks)).toBe(line.repeat(lines));
+  });
+
+  test('decompressing reader rejects a truncated stream', async () => {
+    const filePath = join(testDir, 'truncated.deflate');
+    const data = new Uint8Array(100000);
+    for (let i = 0; i < data.length; i++) data[i] = (i * 31) & 0xff;
+    const writer = createWriter(filePath, false, {
+      compress: CompressionFormat.DEFLATE,
+    });
+    await writer.write(data.buffer as ArrayBuffer);
+    // Flushed but never closed before reading: no end-of-stream marker yet.
+    await writer.flush();
+
+    const reader = createReader(filePath, 65536, {
+      decompress: CompressionFormat.DEFLATE,
+    });
+    try {
+      while ((await reader.readNextChunk()) !== null) {
+        // drain
+      }
+      expect(true).toBe(false); // Should not reach here
+    } catch (e) {
+      expect(e instanceof BlobError).toBe(true);
+      expect((e as BlobError).code).toBe(ErrorCode.IO_ERROR);
+    } finally {
+      reader.close();
+      writer.close();
+    }
+  });
+
   test('written bytes match read bytes', async () => {
     const filePath = join(testDir, 'bytes-match.txt');
     const chunks = ['chunk1', 'chunk2', 'chunk3'];
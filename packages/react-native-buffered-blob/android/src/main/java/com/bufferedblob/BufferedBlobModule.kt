@@ -8,9 +8,6 @@ import com.facebook.react.bridge.ReadableMap
 import com.facebook.react.bridge.WritableNativeArray
 import com.facebook.react.bridge.WritableNativeMap
 import java.io.File
-import java.io.FileInputStream
-import java.io.FileOutputStream
-import java.security.MessageDigest
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.SupervisorJob
@@ -22,9 +19,6 @@ class BufferedBlobModule(reactContext: ReactApplicationContext)
 
   companion object {
     const val NAME = "BufferedBlob"
-    private const val MIN_BUFFER_SIZE = 4096
-    private const val MAX_BUFFER_SIZE = 4194304 // 4MB
-    private const val HASH_CHUNK_SIZE = 8192
   }
 
   private val scope = CoroutineScope(Dispatchers.IO + SupervisorJob())
@@ -49,31 +43,21 @@ class BufferedBlobModule(reactContext: ReactApplicationContext)
     System.loadLibrary("bufferedblobstreaming")
   }
 
+  private external fun nativeOpenRead(path: String, bufferSize: Int): Int
+  private external fun nativeOpenWrite(path: String, append: Boolean): Int
+  private external fun nativeCloseHandle(handleId: Int): Boolean
+  private external fun nativeClearHandles()
+
+  // Reader/writer handles are file descriptors registered in C++
+  // (NativeHandleRegistry), so streaming I/O never re-enters the JVM.
   @ReactMethod(isBlockingSynchronousMethod = true)
   override fun openRead(path: String, bufferSize: Double): Double {
-    val size = bufferSize.toInt()
-    if (size < MIN_BUFFER_SIZE || size > MAX_BUFFER_SIZE) {
-      throw RuntimeException("[INVALID_ARGUMENT] Buffer size must be $MIN_BUFFER_SIZE-$MAX_BUFFER_SIZE: $size")
-    }
-    val file = File(path)
-    if (!file.exists()) throw RuntimeException("[FILE_NOT_FOUND] File does not exist: $path")
-    if (!file.isFile) throw RuntimeException("[INVALID_ARGUMENT] Path is not a file: $path")
-    val stream = try {
-      FileInputStream(file)
-    } catch (e: java.io.FileNotFoundException) {
-      throw RuntimeException("[FILE_NOT_FOUND] File was removed during open: $path")
-    }
-    val reader = ReaderHandle(stream, size, file.length())
-    return HandleRegistry.register(reader).toDouble()
+    return nativeOpenRead(path, bufferSize.toInt()).toDouble()
   }
 
   @ReactMethod(isBlockingSynchronousMethod = true)
   override fun openWrite(path: String, append: Boolean): Double {
-    val file = File(path)
-    file.parentFile?.mkdirs()
-    val stream = FileOutputStream(file, append)
-    val writer = WriterHandle(stream)
-    return HandleRegistry.register(writer).toDouble()
+    return nativeOpenWrite(path, append).toDouble()
   }
 
   @ReactMethod(isBlockingSynchronousMethod = true)
@@ -90,7 +74,10 @@ class BufferedBlobModule(reactContext: ReactApplicationContext)
 
   @ReactMethod(isBlockingSynchronousMethod = true)
   override fun closeHandle(handleId: Double) {
-    HandleRegistry.remove(handleId.toInt())
+    val id = handleId.toInt()
+    if (!nativeCloseHandle(id)) {
+      HandleRegistry.remove(id)
+    }
   }
 
   override fun getTypedExportedConstants(): Map<String, Any> {
@@ -240,35 +227,10 @@ class BufferedBlobModule(reactContext: ReactApplicationContext)
     }
   }
 
-  override fun hashFile(path: String, algorithm: String, promise: Promise) {
-    scope.launch {
-      try {
-        val file = File(path)
-        if (!file.exists()) throw RuntimeException("[FILE_NOT_FOUND] File does not exist: $path")
-        if (!file.isFile) throw RuntimeException("[INVALID_ARGUMENT] Path is not a file: $path")
-        val algoName = when (algorithm) {
-          "sha256" -> "SHA-256"
-          "md5" -> "MD5"
-          else -> throw RuntimeException("[INVALID_ARGUMENT] Unknown algorithm: $algorithm")
-        }
-        val digest = MessageDigest.getInstance(algoName)
-        FileInputStream(file).use { stream ->
-          val buffer = ByteArray(HASH_CHUNK_SIZE)
-          var bytesRead: Int
-          while (stream.read(buffer).also { bytesRead = it } != -1) {
-            digest.update(buffer, 0, bytesRead)
-          }
-        }
-        promise.resolve(digest.digest().joinToString("") { "%02x".format(it) })
-      } catch (e: Exception) {
-        promise.reject("ERR_FS", e.message, e)
-      }
-    }
-  }
-
   override fun invalidate() {
     scope.cancel()
     HandleRegistry.clear()
+    nativeClearHandles()
     super.invalidate()
   }
 }
@@ -1,10 +1,7 @@
 package com.bufferedblob
 
 import java.io.Closeable
-import java.io.FileInputStream
-import java.io.FileOutputStream
 import java.util.concurrent.ConcurrentHashMap
-import java.util.concurrent.atomic.AtomicBoolean
 import java.util.concurrent.atomic.AtomicInteger
 
 object HandleRegistry {
@@ -36,35 +33,6 @@ object HandleRegistry {
   }
 }
 
-data class ReaderHandle(
-  val stream: FileInputStream,
-  val bufferSize: Int,
-  val fileSize: Long,
-  @Volatile var bytesRead: Long = 0L,
-  @Volatile var isEOF: Boolean = false
-) : Closeable {
-  private val closed = AtomicBoolean(false)
-  val isClosed: Boolean get() = closed.get()
-  override fun close() {
-    if (closed.compareAndSet(false, true)) {
-      try { stream.close() } catch (_: Exception) {}
-    }
-  }
-}
-
-data class WriterHandle(
-  val stream: FileOutputStream,
-  @Volatile var bytesWritten: Long = 0L
-) : Closeable {
-  private val closed = AtomicBoolean(false)
-  val isClosed: Boolean get() = closed.get()
-  override fun close() {
-    if (closed.compareAndSet(false, true)) {
-      try { stream.flush(); stream.close() } catch (_: Exception) {}
-    }
-  }
-}
-
 data class DownloaderHandle(
   val url: String,
   val destPath: String,
@@ -72,11 +40,14 @@ data class DownloaderHandle(
   @Volatile var isCancelled: Boolean = false,
   @Volatile var call: okhttp3.Call? = null,
   @Volatile var bytesDownloaded: Long = 0L,
-  @Volatile var totalBytes: Long = -1L
+  @Volatile var totalBytes: Long = -1L,
+  /** In-flight range requests of a segmented download. */
+  val segmentCalls: MutableSet<okhttp3.Call> = ConcurrentHashMap.newKeySet()
 ) : Closeable {
   fun cancel() {
     isCancelled = true
     call?.cancel()
+    segmentCalls.forEach { it.cancel() }
   }
   override fun close() {
     cancel()
@@ -2,6 +2,7 @@ package com.bufferedblob
 
 import okhttp3.OkHttpClient
 import okhttp3.Request
+import okhttp3.Response
 import java.io.File
 import java.io.FileOutputStream
 import java.io.IOException
@@ -10,9 +11,12 @@ import java.util.concurrent.TimeUnit
 /**
  * Static bridge methods called from C++ via JNI.
  * All methods operate on handles from HandleRegistry.
+ * Reader/writer I/O is handled natively by PosixPlatformBridge.
  */
 object StreamingBridge {
 
+  private const val COPY_BUFFER_SIZE = 64 * 1024
+
   private val httpClient = OkHttpClient.Builder()
     .connectTimeout(30, TimeUnit.SECONDS)
     .readTimeout(60, TimeUnit.SECONDS)
@@ -20,71 +24,7 @@ object StreamingBridge {
     .build()
 
   /**
-   * Read the next chunk from a ReaderHandle.
-   * Returns null when EOF is reached.
-   */
-  @JvmStatic
-  fun readNextChunk(handleId: Int): ByteArray? {
-    val reader = HandleRegistry.get<ReaderHandle>(handleId)
-      ?: throw RuntimeException("[READER_CLOSED] Reader handle not found: $handleId")
-
-    synchronized(reader) {
-      if (reader.isClosed) throw RuntimeException("[READER_CLOSED] Reader is closed")
-      if (reader.isEOF) return null
-
-      val buffer = ByteArray(reader.bufferSize)
-      val bytesRead = reader.stream.read(buffer)
-
-      if (bytesRead == -1) {
-        reader.isEOF = true
-        return null
-      }
-
-      reader.bytesRead += bytesRead
-
-      return if (bytesRead == buffer.size) {
-        buffer
-      } else {
-        buffer.copyOf(bytesRead)
-      }
-    }
-  }
-
-  /**
-   * Write data to a WriterHandle.
-   * Returns the number of bytes written.
-   */
-  @JvmStatic
-  fun write(handleId: Int, data: ByteArray): Int {
-    val writer = HandleRegistry.get<WriterHandle>(handleId)
-      ?: throw RuntimeException("[WRITER_CLOSED] Writer handle not found: $handleId")
-
-    synchronized(writer) {
-      if (writer.isClosed) throw RuntimeException("[WRITER_CLOSED] Writer is closed")
-
-      writer.stream.write(data)
-      writer.bytesWritten += data.size
-      return data.size
-    }
-  }
-
-  /**
-   * Flush a WriterHandle.
-   */
-  @JvmStatic
-  fun flush(handleId: Int) {
-    val writer = HandleRegistry.get<WriterHandle>(handleId)
-      ?: throw RuntimeException("[WRITER_CLOSED] Writer handle not found: $handleId")
-
-    synchronized(writer) {
-      if (writer.isClosed) throw RuntimeException("[WRITER_CLOSED] Writer is closed")
-
-      writer.stream.flush()
-    }
-  }
-
-  /**
-   * Close a handle (reader, writer, or downloader).
+   * Close a handle from the Kotlin registry (downloader).
    */
   @JvmStatic
   fun close(handleId: Int) {
@@ -93,11 +33,16 @@ object StreamingBridge {
 
   /**
    * Start a download synchronously (blocking the calling thread).
-   * Updates handle.bytesDownloaded and handle.totalBytes during download
-   * for progress polling from the C++ layer.
+   * [nativeTransfer] is the C++ transfer state owned by that thread; the
+   * response and every received buffer are pushed to it, where they are
+   * hashed (if a hasher is attached), counted for throttled progress
+   * reports and checkpointed for resumable downloads. A resumable
+   * download that has a checkpoint asks for the remaining range and
+   * appends to destPath. With [writeFile] off the body only goes to the
+   * C++ download stream.
    */
   @JvmStatic
-  fun startDownload(handleId: Int) {
+  fun startDownload(handleId: Int, nativeTransfer: Long, writeFile: Boolean) {
     val handle = HandleRegistry.get<DownloaderHandle>(handleId)
       ?: throw RuntimeException("[DOWNLOAD_FAILED] Download handle not found: $handleId")
 
@@ -109,6 +54,10 @@ object StreamingBridge {
     for ((key, value) in handle.headers) {
       requestBuilder.addHeader(key, value)
     }
+    val resumeHeaders = nativeOnDownloadRequest(nativeTransfer, handle.url, handle.destPath)
+    for (i in resumeHeaders.indices step 2) {
+      requestBuilder.header(resumeHeaders[i], resumeHeaders[i + 1])
+    }
     val request = requestBuilder.build()
 
     val call = httpClient.newCall(request)
@@ -124,21 +73,37 @@ object StreamingBridge {
     }
 
     response.use { resp ->
+      val body = resp.body
+      val contentLength = body?.contentLength() ?: -1L
+      val offset = nativeOnDownloadResponse(
+        nativeTransfer,
+        resp.code,
+        contentLength,
+        resp.header("Content-Range"),
+        resp.header("ETag"),
+        resp.header("Last-Modified")
+      )
       if (!resp.isSuccessful) {
         throw RuntimeException("[DOWNLOAD_FAILED] HTTP ${resp.code}")
       }
+      if (body == null) {
+        throw RuntimeException("[DOWNLOAD_FAILED] Empty response body")
+      }
 
-      val body = resp.body
-        ?: throw RuntimeException("[DOWNLOAD_FAILED] Empty response body")
-
-      val contentLength = body.contentLength()
-      handle.totalBytes = contentLength
-
-      val destFile = File(handle.destPath)
-      destFile.parentFile?.mkdirs()
+      handle.totalBytes = if (contentLength >= 0) offset + contentLength else -1L
+      handle.bytesDownloaded = offset
 
-      FileOutputStream(destFile).use { fos ->
-        val buffer = ByteArray(8192)
+      // Stream-only downloads hand every buffer to C++ and keep no file.
+      val fos = if (writeFile) {
+        val destFile = File(handle.destPath)
+        destFile.parentFile?.mkdirs()
+        // A non-zero offset means the file already holds exactly that prefix.
+        FileOutputStream(destFile, offset > 0)
+      } else {
+        null
+      }
+      fos.use {
+        val buffer = ByteArray(COPY_BUFFER_SIZE)
         var bytesRead: Int
 
         body.byteStream().use { inputStream ->
@@ -146,7 +111,11 @@ object StreamingBridge {
             if (handle.isCancelled) {
               throw RuntimeException("[DOWNLOAD_CANCELLED] Download was cancelled")
             }
-            fos.write(buffer, 0, bytesRead)
+            fos?.write(buffer, 0, bytesRead)
+            // Blocks while a stream reader is behind; false once it closed.
+            if (!nativeOnDownloadData(nativeTransfer, buffer, bytesRead)) {
+              throw RuntimeException("[DOWNLOAD_CANCELLED] Download stream was closed")
+            }
             handle.bytesDownloaded += bytesRead
           }
         }
@@ -154,6 +123,107 @@ object StreamingBridge {
     }
   }
 
+  /**
+   * Probe a segmented download with a one-byte range request. The response
+   * goes to [nativeOnDownloadProbe], which prepares the segments when the
+   * server serves ranges; otherwise C++ falls back to [startDownload].
+   */
+  @JvmStatic
+  fun probeDownload(handleId: Int, nativeTransfer: Long) {
+    val handle = HandleRegistry.get<DownloaderHandle>(handleId)
+      ?: throw RuntimeException("[DOWNLOAD_FAILED] Download handle not found: $handleId")
+
+    val destFile = File(handle.destPath)
+    destFile.parentFile?.mkdirs()
+
+    withRange(handle, "bytes=0-0", null) { resp ->
+      nativeOnDownloadProbe(
+        nativeTransfer,
+        resp.code,
+        resp.header("Content-Range"),
+        resp.header("ETag"),
+        resp.header("Last-Modified"),
+        handle.destPath
+      )
+    }
+  }
+
+  /**
+   * Fetch one segment of a segmented download, blocking the calling
+   * thread. C++ runs one of these per segment concurrently and retries a
+   * failed segment by calling again with the range it still needs.
+   */
+  @JvmStatic
+  fun fetchSegment(handleId: Int, nativeTransfer: Long, index: Int, range: String, ifRange: String?) {
+    val handle = HandleRegistry.get<DownloaderHandle>(handleId)
+      ?: throw RuntimeException("[DOWNLOAD_FAILED] Download handle not found: $handleId")
+
+    withRange(handle, range, ifRange) { resp ->
+      nativeOnSegmentResponse(nativeTransfer, index, resp.code, resp.header("Content-Range"))
+      val body = resp.body
+        ?: throw RuntimeException("[DOWNLOAD_FAILED] Empty response body")
+      val buffer = ByteArray(COPY_BUFFER_SIZE)
+      var bytesRead: Int
+      try {
+        body.byteStream().use { inputStream ->
+          while (inputStream.read(buffer).also { bytesRead = it } != -1) {
+            if (handle.isCancelled) {
+              throw RuntimeException("[DOWNLOAD_CANCELLED] Download was cancelled")
+            }
+            nativeOnSegmentData(nativeTransfer, index, buffer, bytesRead)
+          }
+        }
+      } catch (e: IOException) {
+        if (handle.isCancelled) {
+          throw RuntimeException("[DOWNLOAD_CANCELLED] Download was cancelled")
+        }
+        throw RuntimeException("[DOWNLOAD_FAILED] ${e.message}")
+      }
+    }
+  }
+
+  /**
+   * Run a range request and hand its response to [block]. The call stays
+   * registered for cancellation until [block] returns.
+   */
+  private fun withRange(
+    handle: DownloaderHandle,
+    range: String,
+    ifRange: String?,
+    block: (Response) -> Unit
+  ) {
+    if (handle.isCancelled) {
+      throw RuntimeException("[DOWNLOAD_CANCELLED] Download was cancelled")
+    }
+    val requestBuilder = Request.Builder().url(handle.url)
+    for ((key, value) in handle.headers) {
+      requestBuilder.addHeader(key, value)
+    }
+    requestBuilder.header("Range", range)
+    requestBuilder.header("Accept-Encoding", "identity")
+    if (ifRange != null) {
+      requestBuilder.header("If-Range", ifRange)
+    }
+
+    val call = httpClient.newCall(requestBuilder.build())
+    handle.segmentCalls.add(call)
+    try {
+      // Cancel may have run before the call was registered.
+      if (handle.isCancelled) call.cancel()
+      val response = try {
+        call.execute()
+      } catch (e: IOException) {
+        if (handle.isCancelled) {
+          throw RuntimeException("[DOWNLOAD_CANCELLED] Download was cancelled")
+        }
+        throw RuntimeException("[DOWNLOAD_FAILED] ${e.message}")
+      }
+      response.use(block)
+    } finally {
+      handle.segmentCalls.remove(call)
+    }
+  }
+
   /**
    * Cancel a download.
    */
@@ -163,45 +233,64 @@ object StreamingBridge {
     handle.cancel()
   }
 
-  // --- Reader info getters ---
-
+  /**
+   * URL of a created download, for the native scheduler's per-host limits.
+   */
   @JvmStatic
-  fun getReaderFileSize(handleId: Int): Long {
-    val reader = HandleRegistry.get<ReaderHandle>(handleId) ?: return 0L
-    return reader.fileSize
-  }
+  fun downloadUrl(handleId: Int): String? =
+    HandleRegistry.get<DownloaderHandle>(handleId)?.url
 
-  @JvmStatic
-  fun getReaderBytesRead(handleId: Int): Long {
-    val reader = HandleRegistry.get<ReaderHandle>(handleId) ?: return 0L
-    return reader.bytesRead
-  }
+  // --- Transfer callbacks into C++ (see AndroidDownloadTransfer) ---
 
   @JvmStatic
-  fun getReaderIsEOF(handleId: Int): Boolean {
-    val reader = HandleRegistry.get<ReaderHandle>(handleId) ?: return true
-    return reader.isEOF
-  }
+  private external fun nativeOnDownloadRequest(
+    nativeTransfer: Long,
+    url: String,
+    destPath: String
+  ): Array<String>
 
-  // --- Writer info getters ---
+  @JvmStatic
+  private external fun nativeOnDownloadResponse(
+    nativeTransfer: Long,
+    status: Int,
+    contentLength: Long,
+    contentRange: String?,
+    etag: String?,
+    lastModified: String?
+  ): Long
 
   @JvmStatic
-  fun getWriterBytesWritten(handleId: Int): Long {
-    val writer = HandleRegistry.get<WriterHandle>(handleId) ?: return 0L
-    return writer.bytesWritten
-  }
+  private external fun nativeOnDownloadData(
+    nativeTransfer: Long,
+    buffer: ByteArray,
+    length: Int
+  ): Boolean
 
-  // --- Download progress getters (polled from C++ via JNI) ---
+  @JvmStatic
+  private external fun nativeOnDownloadProbe(
+    nativeTransfer: Long,
+    status: Int,
+    contentRange: String?,
+    etag: String?,
+    lastModified: String?,
+    destPath: String
+  )
 
   @JvmStatic
-  fun getDownloadBytesDownloaded(handleId: Int): Long {
-    return HandleRegistry.get<DownloaderHandle>(handleId)?.bytesDownloaded ?: 0L
-  }
+  private external fun nativeOnSegmentResponse(
+    nativeTransfer: Long,
+    index: Int,
+    status: Int,
+    contentRange: String?
+  )
 
   @JvmStatic
-  fun getDownloadTotalBytes(handleId: Int): Long {
-    return HandleRegistry.get<DownloaderHandle>(handleId)?.totalBytes ?: -1L
-  }
+  private external fun nativeOnSegmentData(
+    nativeTransfer: Long,
+    index: Int,
+    buffer: ByteArray,
+    length: Int
+  )
 
   interface DownloadCallback {
     fun onProgress(bytesDownloaded: Long, totalBytes: Long, progress: Double)
@@ -1,62 +1,55 @@
 #include "AndroidPlatformBridge.h"
 #include <fbjni/fbjni.h>
-#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <thread>
-#include <chrono>
 
 namespace bufferedblob {
 
 using namespace facebook;
 
-// --- Thread Pool ---
-
-void AndroidPlatformBridge::initThreadPool() {
-  for (size_t i = 0; i < kPoolThreads; ++i) {
-    poolWorkers_.emplace_back([this]() {
-      // Use fbjni::ThreadScope to attach this worker thread to the JVM.
-      // This registers the thread with fbjni's thread-local tracking so
-      // that Environment::current() works -- which is required by
-      // CallInvoker::invokeAsync() internally.
-      jni::ThreadScope threadScope;
-      while (true) {
-        std::function<void()> task;
-        {
-          std::unique_lock<std::mutex> lock(queueMutex_);
-          queueCV_.wait(lock, [this]() {
-            return shutdown_.load() || !taskQueue_.empty();
-          });
-          if (shutdown_.load() && taskQueue_.empty()) return;
-          task = std::move(taskQueue_.front());
-          taskQueue_.pop();
-        }
-        task();
-      }
-    });
+namespace {
+
+// Clear a pending Java exception and return its message.
+bool takeJavaException(JNIEnv* env, std::string& message) {
+  if (!env->ExceptionCheck()) return false;
+  jthrowable ex = env->ExceptionOccurred();
+  env->ExceptionClear();
+  jclass throwableClass = env->FindClass("java/lang/Throwable");
+  jmethodID getMessage = env->GetMethodID(
+      throwableClass, "getMessage", "()Ljava/lang/String;");
+  auto msg = (jstring)env->CallObjectMethod(ex, getMessage);
+  if (msg) {
+    const char* msgChars = env->GetStringUTFChars(msg, nullptr);
+    message = msgChars ? msgChars : "";
+    env->ReleaseStringUTFChars(msg, msgChars);
+    env->DeleteLocalRef(msg);
+  } else {
+    message = "[DOWNLOAD_FAILED] Unknown error";
   }
+  env->DeleteLocalRef(throwableClass);
+  env->DeleteLocalRef(ex);
+  return true;
 }
 
-void AndroidPlatformBridge::submitTask(std::function<void()> task) {
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    taskQueue_.push(std::move(task));
-  }
-  queueCV_.notify_one();
-}
-
-AndroidPlatformBridge::AndroidPlatformBridge(JNIEnv* env) {
+} // namespace
+
+AndroidPlatformBridge::AndroidPlatformBridge(JNIEnv* env)
+    : PosixPlatformBridge([](const std::function<void()>& body) {
+        // Use fbjni::ThreadScope to attach each worker thread to the JVM.
+        // This registers the thread with fbjni's thread-local tracking so
+        // that Environment::current() works -- which is required by
+        // CallInvoker::invokeAsync() internally.
+        jni::ThreadScope threadScope;
+        body();
+      }) {
   env->GetJavaVM(&vm_);
   auto clazz = env->FindClass("com/bufferedblob/StreamingBridge");
   bridgeClass_ = (jclass)env->NewGlobalRef(clazz);
   env->DeleteLocalRef(clazz);
-  initThreadPool();
 }
 
 AndroidPlatformBridge::~AndroidPlatformBridge() {
-  shutdown_.store(true);
-  queueCV_.notify_all();
-  for (auto& worker : poolWorkers_) {
-    if (worker.joinable()) worker.join();
-  }
   // Clean up global ref
   if (bridgeClass_) {
     JNIEnv* env = nullptr;
@@ -66,167 +59,12 @@ AndroidPlatformBridge::~AndroidPlatformBridge() {
   }
 }
 
-// --- Read (uses thread pool) ---
-
-void AndroidPlatformBridge::readNextChunk(
-    int handleId,
-    std::function<void(std::vector<uint8_t>)> onSuccess,
-    std::function<void()> onEOF,
-    std::function<void(std::string)> onError) {
-  // Capture raw jclass (global ref) -- no fbjni copy, safe from any thread.
-  jclass cls = bridgeClass_;
-  submitTask([cls, handleId, onSuccess = std::move(onSuccess),
-               onEOF = std::move(onEOF), onError = std::move(onError)]() {
-    try {
-      JNIEnv* env = jni::Environment::current();
-
-      jmethodID method = env->GetStaticMethodID(cls, "readNextChunk", "(I)[B");
-      if (!method) {
-        onError("readNextChunk method not found");
-        return;
-      }
-
-      auto result = (jbyteArray)env->CallStaticObjectMethod(cls, method, handleId);
-
-      if (env->ExceptionCheck()) {
-        jthrowable ex = env->ExceptionOccurred();
-        env->ExceptionClear();
-        jclass throwableClass = env->FindClass("java/lang/Throwable");
-        jmethodID getMessage = env->GetMethodID(
-            throwableClass, "getMessage", "()Ljava/lang/String;");
-        auto msg = (jstring)env->CallObjectMethod(ex, getMessage);
-        const char* msgChars = env->GetStringUTFChars(msg, nullptr);
-        std::string errorMsg(msgChars);
-        env->ReleaseStringUTFChars(msg, msgChars);
-        env->DeleteLocalRef(ex);
-        env->DeleteLocalRef(msg);
-        onError(errorMsg);
-        return;
-      }
-
-      if (result == nullptr) {
-        onEOF();
-        return;
-      }
-
-      jsize len = env->GetArrayLength(result);
-      std::vector<uint8_t> data(len);
-      jbyte* rawBytes = static_cast<jbyte*>(
-          env->GetPrimitiveArrayCritical(result, nullptr));
-      if (rawBytes) {
-        std::memcpy(data.data(), rawBytes, len);
-        env->ReleasePrimitiveArrayCritical(result, rawBytes, JNI_ABORT);
-      } else {
-        env->GetByteArrayRegion(
-            result, 0, len, reinterpret_cast<jbyte*>(data.data()));
-      }
-      env->DeleteLocalRef(result);
-      onSuccess(std::move(data));
-    } catch (const std::exception& e) {
-      onError(std::string("JNI error: ") + e.what());
-    }
-  });
-}
-
-// --- Write (uses thread pool) ---
-
-void AndroidPlatformBridge::write(
-    int handleId,
-    std::vector<uint8_t> data,
-    std::function<void(int)> onSuccess,
-    std::function<void(std::string)> onError) {
-  jclass cls = bridgeClass_;
-
-  submitTask([cls, handleId, dataCopy = std::move(data),
-               onSuccess = std::move(onSuccess),
-               onError = std::move(onError)]() {
-    try {
-      JNIEnv* env = jni::Environment::current();
-
-      jmethodID method = env->GetStaticMethodID(cls, "write", "(I[B)I");
-      if (!method) {
-        onError("write method not found");
-        return;
-      }
-
-      jbyteArray arr = env->NewByteArray(static_cast<jsize>(dataCopy.size()));
-      env->SetByteArrayRegion(
-          arr, 0, static_cast<jsize>(dataCopy.size()),
-          reinterpret_cast<const jbyte*>(dataCopy.data()));
-
-      jint result = env->CallStaticIntMethod(cls, method, handleId, arr);
-      env->DeleteLocalRef(arr);
-
-      if (env->ExceptionCheck()) {
-        jthrowable ex = env->ExceptionOccurred();
-        env->ExceptionClear();
-        jclass throwableClass = env->FindClass("java/lang/Throwable");
-        jmethodID getMessage = env->GetMethodID(
-            throwableClass, "getMessage", "()Ljava/lang/String;");
-        auto msg = (jstring)env->CallObjectMethod(ex, getMessage);
-        const char* msgChars = env->GetStringUTFChars(msg, nullptr);
-        std::string errorMsg(msgChars);
-        env->ReleaseStringUTFChars(msg, msgChars);
-        env->DeleteLocalRef(ex);
-        env->DeleteLocalRef(msg);
-        onError(errorMsg);
-        return;
-      }
-
-      onSuccess(static_cast<int>(result));
-    } catch (const std::exception& e) {
-      onError(std::string("JNI error: ") + e.what());
-    }
-  });
-}
-
-// --- Flush (uses thread pool) ---
-
-void AndroidPlatformBridge::flush(
-    int handleId,
-    std::function<void()> onSuccess,
-    std::function<void(std::string)> onError) {
-  jclass cls = bridgeClass_;
-
-  submitTask([cls, handleId, onSuccess = std::move(onSuccess),
-               onError = std::move(onError)]() {
-    try {
-      JNIEnv* env = jni::Environment::current();
-
-      jmethodID method = env->GetStaticMethodID(cls, "flush", "(I)V");
-      if (!method) {
-        onError("flush method not found");
-        return;
-      }
-
-      env->CallStaticVoidMethod(cls, method, handleId);
-
-      if (env->ExceptionCheck()) {
-        jthrowable ex = env->ExceptionOccurred();
-        env->ExceptionClear();
-        jclass throwableClass = env->FindClass("java/lang/Throwable");
-        jmethodID getMessage = env->GetMethodID(
-            throwableClass, "getMessage", "()Ljava/lang/String;");
-        auto msg = (jstring)env->CallObjectMethod(ex, getMessage);
-        const char* msgChars = env->GetStringUTFChars(msg, nullptr);
-        std::string errorMsg(msgChars);
-        env->ReleaseStringUTFChars(msg, msgChars);
-        env->DeleteLocalRef(ex);
-        env->DeleteLocalRef(msg);
-        onError(errorMsg);
-        return;
-      }
-
-      onSuccess();
-    } catch (const std::exception& e) {
-      onError(std::string("JNI error: ") + e.what());
-    }
-  });
-}
-
 // --- Close (synchronous, called from JS thread) ---
 
 void AndroidPlatformBridge::close(int handleId) {
+  // Native reader/writer handles never reach the Kotlin registry.
+  if (NativeHandleRegistry::shared().remove(handleId)) return;
+
   try {
     // Use raw JNI GetEnv -- this may be called from the JS thread which
     // is not registered with fbjni's thread-local tracking.
@@ -247,10 +85,11 @@ void AndroidPlatformBridge::close(int handleId) {
   }
 }
 
-// --- Download (dedicated managed threads, NOT in pool) ---
+// --- Download (dedicated managed thread, NOT in pool) ---
 
 void AndroidPlatformBridge::startDownload(
     int handleId,
+    const DownloadConfig& config,
     std::function<void(double, double, double)> onProgress,
     std::function<void()> onSuccess,
     std::function<void(std::string)> onError) {
@@ -258,103 +97,97 @@ void AndroidPlatformBridge::startDownload(
   // Environment::current() and crashes on threads without fbjni TLData.
   jclass cls = bridgeClass_;
 
-  auto done = std::make_shared<std::atomic<bool>>(false);
-
-  // Progress polling: timer thread sleeps, then submits JNI work to pool.
-  auto self = this;
-  std::thread([self, cls, handleId, onProgress, done]() {
-    while (!done->load()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(200));
-      if (done->load()) break;
-
-      self->submitTask([cls, handleId, onProgress, done]() {
-        if (done->load()) return;
-        try {
-          JNIEnv* pEnv = jni::Environment::current();
-
-          jmethodID getBytesMethod = pEnv->GetStaticMethodID(
-              cls, "getDownloadBytesDownloaded", "(I)J");
-          jmethodID getTotalMethod = pEnv->GetStaticMethodID(
-              cls, "getDownloadTotalBytes", "(I)J");
-          if (!getBytesMethod || !getTotalMethod) return;
-
-          jlong downloaded = pEnv->CallStaticLongMethod(
-              cls, getBytesMethod, handleId);
-          jlong total = pEnv->CallStaticLongMethod(
-              cls, getTotalMethod, handleId);
-          if (pEnv->ExceptionCheck()) { pEnv->ExceptionClear(); return; }
-
-          if (total > 0) {
-            double progress = static_cast<double>(downloaded) / static_cast<double>(total);
-            onProgress(static_cast<double>(downloaded),
-                       static_cast<double>(total), progress);
-          } else if (downloaded > 0) {
-            onProgress(static_cast<double>(downloaded), -1.0, -1.0);
-          }
-        } catch (...) {
-          // Polling failure is non-fatal
-        }
-      });
-    }
-  }).detach();
+  // Kotlin pushes every received buffer into the transfer (hashing,
+  // progress and resume checkpoints) instead of being polled for its
+  // counters.
+  auto& registry = NativeHandleRegistry::shared();
+  auto transfer = std::make_shared<AndroidDownloadTransfer>(
+      registry.downloadHasher(handleId),
+      config.stream ? registry.downloadStream(handleId) : nullptr,
+      std::move(onProgress), config);
 
   // Download thread: uses ThreadScope for fbjni-compatible attachment.
-  auto downloadThread = std::thread([cls, handleId, done,
-               onProgress = std::move(onProgress),
+  auto downloadThread = std::thread([cls, handleId, transfer,
                onSuccess = std::move(onSuccess),
                onError = std::move(onError)]() {
     try {
       jni::ThreadScope threadScope;
       JNIEnv* env = jni::Environment::current();
+      auto transferPtr = reinterpret_cast<jlong>(transfer.get());
+      std::string errorMsg;
+
+      if (transfer->config.segments > 1 && !transfer->config.resume) {
+        jmethodID probe = env->GetStaticMethodID(cls, "probeDownload", "(IJ)V");
+        jmethodID fetch = env->GetStaticMethodID(
+            cls, "fetchSegment", "(IJILjava/lang/String;Ljava/lang/String;)V");
+        if (!probe || !fetch) {
+          onError("probeDownload method not found");
+          return;
+        }
+        env->CallStaticVoidMethod(cls, probe, handleId, transferPtr);
+        if (takeJavaException(env, errorMsg)) {
+          onError(errorMsg);
+          return;
+        }
+        if (transfer->segmented) {
+          auto& segmented = *transfer->segmented;
+          try {
+            segmented.run([&](size_t index) {
+              // Attaches the segment threads; a no-op on this one.
+              jni::ThreadScope segmentScope;
+              JNIEnv* segmentEnv = jni::Environment::current();
+              jstring range = segmentEnv->NewStringUTF(segmented.rangeHeader(index).c_str());
+              jstring ifRange = segmented.validator().empty()
+                  ? nullptr
+                  : segmentEnv->NewStringUTF(segmented.validator().c_str());
+              segmentEnv->CallStaticVoidMethod(cls, fetch, handleId, transferPtr,
+                                               static_cast<jint>(index), range, ifRange);
+              segmentEnv->DeleteLocalRef(range);
+              if (ifRange) segmentEnv->DeleteLocalRef(ifRange);
+              std::string segmentError;
+              if (takeJavaException(segmentEnv, segmentError)) {
+                throw std::runtime_error(segmentError);
+              }
+            });
+            // Segments arrive out of order, so hash the assembled file.
+            if (transfer->hasher) {
+              segmented.readAll([&](const uint8_t* data, size_t size) {
+                transfer->hasher->update(data, size);
+              });
+            }
+          } catch (const std::exception& e) {
+            transfer->segmented.reset();
+            onError(e.what());
+            return;
+          }
+          transfer->segmented.reset();
+          transfer->progress.complete();
+          onSuccess();
+          return;
+        }
+        // No ranges, unknown length or too small: one plain stream.
+      }
 
-      jmethodID method = env->GetStaticMethodID(cls, "startDownload", "(I)V");
+      jmethodID method = env->GetStaticMethodID(cls, "startDownload", "(IJZ)V");
       if (!method) {
-        done->store(true);
         onError("startDownload method not found");
         return;
       }
 
-      env->CallStaticVoidMethod(cls, method, handleId);
+      env->CallStaticVoidMethod(cls, method, handleId, transferPtr,
+                                static_cast<jboolean>(transfer->config.writeFile));
 
-      // Signal polling to stop
-      done->store(true);
-
-      if (env->ExceptionCheck()) {
-        jthrowable ex = env->ExceptionOccurred();
-        env->ExceptionClear();
-        jclass throwableClass = env->FindClass("java/lang/Throwable");
-        jmethodID getMessage = env->GetMethodID(
-            throwableClass, "getMessage", "()Ljava/lang/String;");
-        auto msg = (jstring)env->CallObjectMethod(ex, getMessage);
-        const char* msgChars = env->GetStringUTFChars(msg, nullptr);
-        std::string errorMsg(msgChars);
-        env->ReleaseStringUTFChars(msg, msgChars);
-        env->DeleteLocalRef(ex);
-        env->DeleteLocalRef(msg);
+      if (takeJavaException(env, errorMsg)) {
+        if (transfer->resume) transfer->resume->save();
         onError(errorMsg);
         return;
       }
 
-      // Read final progress values for a 100% callback
-      jmethodID getBytesMethod = env->GetStaticMethodID(
-          cls, "getDownloadBytesDownloaded", "(I)J");
-      jmethodID getTotalMethod = env->GetStaticMethodID(
-          cls, "getDownloadTotalBytes", "(I)J");
-      if (getBytesMethod && getTotalMethod) {
-        jlong finalDownloaded = env->CallStaticLongMethod(
-            cls, getBytesMethod, handleId);
-        jlong finalTotal = env->CallStaticLongMethod(
-            cls, getTotalMethod, handleId);
-        if (!env->ExceptionCheck() && finalTotal > 0) {
-          onProgress(static_cast<double>(finalDownloaded),
-                     static_cast<double>(finalTotal), 1.0);
-        }
-        if (env->ExceptionCheck()) env->ExceptionClear();
-      }
-
+      if (transfer->resume) transfer->resume->finish();
+      transfer->progress.complete();
       onSuccess();
     } catch (const std::exception& e) {
-      done->store(true);
+      if (transfer->resume) transfer->resume->save();
       onError(std::string("JNI error: ") + e.what());
     }
   });
@@ -380,58 +213,28 @@ void AndroidPlatformBridge::cancelDownload(int handleId) {
   }
 }
 
-PlatformBridge::ReaderInfo AndroidPlatformBridge::getReaderInfo(int handleId) {
-  ReaderInfo info{0, 0, false};
-  try {
-    JNIEnv* env = nullptr;
-    if (vm_->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK || !env) {
-      return info;
-    }
-
-    jmethodID method = env->GetStaticMethodID(bridgeClass_, "getReaderFileSize", "(I)J");
-    if (method) {
-      info.fileSize = static_cast<double>(
-          env->CallStaticLongMethod(bridgeClass_, method, handleId));
-      if (env->ExceptionCheck()) env->ExceptionClear();
-    }
-
-    method = env->GetStaticMethodID(bridgeClass_, "getReaderBytesRead", "(I)J");
-    if (method) {
-      info.bytesRead = static_cast<double>(
-          env->CallStaticLongMethod(bridgeClass_, method, handleId));
-      if (env->ExceptionCheck()) env->ExceptionClear();
-    }
-
-    method = env->GetStaticMethodID(bridgeClass_, "getReaderIsEOF", "(I)Z");
-    if (method) {
-      info.isEOF = env->CallStaticBooleanMethod(bridgeClass_, method, handleId);
-      if (env->ExceptionCheck()) env->ExceptionClear();
-    }
-  } catch (...) {
-    // Return default info
+std::string AndroidPlatformBridge::downloadUrl(int handleId) {
+  JNIEnv* env = nullptr;
+  if (vm_->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK || !env) {
+    return std::string();
   }
-  return info;
-}
-
-PlatformBridge::WriterInfo AndroidPlatformBridge::getWriterInfo(int handleId) {
-  WriterInfo info{0};
-  try {
-    JNIEnv* env = nullptr;
-    if (vm_->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK || !env) {
-      return info;
-    }
-
-    jmethodID method = env->GetStaticMethodID(
-        bridgeClass_, "getWriterBytesWritten", "(I)J");
-    if (method) {
-      info.bytesWritten = static_cast<double>(
-          env->CallStaticLongMethod(bridgeClass_, method, handleId));
-      if (env->ExceptionCheck()) env->ExceptionClear();
-    }
-  } catch (...) {
-    // Return default info
+  jmethodID method = env->GetStaticMethodID(
+      bridgeClass_, "downloadUrl", "(I)Ljava/lang/String;");
+  if (!method) {
+    env->ExceptionClear();
+    return std::string();
+  }
+  auto url = static_cast<jstring>(env->CallStaticObjectMethod(bridgeClass_, method, handleId));
+  if (env->ExceptionCheck()) {
+    env->ExceptionClear();
+    return std::string();
   }
-  return info;
+  if (!url) return std::string();
+  const char* chars = env->GetStringUTFChars(url, nullptr);
+  std::string result = chars ? chars : "";
+  if (chars) env->ReleaseStringUTFChars(url, chars);
+  env->DeleteLocalRef(url);
+  return result;
 }
 
 } // namespace bufferedblob
@@ -1,13 +1,9 @@
 #pragma once
 
-#include "BufferedBlobStreamingHostObject.h"
+#include "DownloadResume.h"
+#include "PosixPlatformBridge.h"
+#include "SegmentedDownload.h"
 #include <fbjni/fbjni.h>
-#include <jsi/jsi.h>
-#include <ReactCommon/CallInvoker.h>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
 #include <functional>
 #include <atomic>
 
@@ -15,41 +11,53 @@ namespace bufferedblob {
 
 using namespace facebook;
 
+/**
+ * Native state of a running Kotlin download. Lives on the C++ download
+ * thread for the whole StreamingBridge.startDownload call, which receives
+ * its address and passes it back to the nativeOnDownload* callbacks, so
+ * the copy loop reaches it without a handle lookup.
+ */
+struct AndroidDownloadTransfer {
+  AndroidDownloadTransfer(std::shared_ptr<NativeHasherHandle> hasher,
+                          std::shared_ptr<DownloadStream> stream,
+                          DownloadProgress::Callback onProgress,
+                          const PlatformBridge::DownloadConfig& config)
+      : hasher(std::move(hasher)),
+        stream(std::move(stream)),
+        progress(std::move(onProgress), config.progress),
+        config(config) {}
+
+  const std::shared_ptr<NativeHasherHandle> hasher;
+  /** Set when config.stream is; receives a copy of every buffer. */
+  const std::shared_ptr<DownloadStream> stream;
+  DownloadProgress progress;
+  const PlatformBridge::DownloadConfig config;
+  /** Loaded by nativeOnDownloadRequest when config.resume is set. */
+  std::unique_ptr<DownloadResume> resume;
+  /**
+   * Created by nativeOnDownloadProbe when the server serves ranges and the
+   * file is large enough to split.
+   */
+  std::unique_ptr<SegmentedDownload> segmented;
+};
+
 /**
  * Android implementation of PlatformBridge.
- * Calls into Kotlin/Java HandleRegistry via JNI to perform streaming operations.
- * Uses a bounded thread pool for read/write/flush; downloads use dedicated threads.
+ * Reader/writer I/O is inherited from PosixPlatformBridge and runs on raw
+ * file descriptors without entering the JVM. Downloads still call into the
+ * Kotlin StreamingBridge via JNI on a dedicated thread, and the copy loop
+ * pushes progress back through AndroidDownloadTransfer.
  */
-class AndroidPlatformBridge : public PlatformBridge {
+class AndroidPlatformBridge : public PosixPlatformBridge {
 public:
   AndroidPlatformBridge(JNIEnv* env);
   ~AndroidPlatformBridge() override;
 
-
-  void readNextChunk(
-    int handleId,
-    std::function<void(std::vector<uint8_t>)> onSuccess,
-    std::function<void()> onEOF,
-    std::function<void(std::string)> onError
-  ) override;
-
-  void write(
-    int handleId,
-    std::vector<uint8_t> data,
-    std::function<void(int)> onSuccess,
-    std::function<void(std::string)> onError
-  ) override;
-
-  void flush(
-    int handleId,
-    std::function<void()> onSuccess,
-    std::function<void(std::string)> onError
-  ) override;
-
   void close(int handleId) override;
 
   void startDownload(
     int handleId,
+    const DownloadConfig& config,
     std::function<void(double, double, double)> onProgress,
     std::function<void()> onSuccess,
     std::function<void(std::string)> onError
@@ -57,23 +65,11 @@ public:
 
   void cancelDownload(int handleId) override;
 
-  ReaderInfo getReaderInfo(int handleId) override;
-  WriterInfo getWriterInfo(int handleId) override;
+  std::string downloadUrl(int handleId) override;
 
 private:
   JavaVM* vm_;
   jclass bridgeClass_{nullptr};
-
-  // Thread pool for read/write/flush (not downloads)
-  static constexpr size_t kPoolThreads = 4;
-  std::vector<std::thread> poolWorkers_;
-  std::queue<std::function<void()>> taskQueue_;
-  std::mutex queueMutex_;
-  std::condition_variable queueCV_;
-  std::atomic<bool> shutdown_{false};
-
-  void initThreadPool();
-  void submitTask(std::function<void()> task);
 };
 
 } // namespace bufferedblob
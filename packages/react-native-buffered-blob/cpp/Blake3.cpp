@@ -0,0 +1,280 @@
+#include "Hasher.h"
+#include <algorithm>
+#include <cstring>
+
+namespace bufferedblob {
+
+namespace {
+
+// BLAKE3 (unkeyed hash mode, 32-byte output), structured like the
+// reference implementation: 1KB chunks of 64-byte blocks, merged into a
+// binary tree through a stack of chaining values.
+
+constexpr size_t kBlockLength = 64;
+constexpr size_t kChunkLength = 1024;
+constexpr size_t kMaxDepth = 54;
+
+constexpr uint32_t kChunkStart = 1 << 0;
+constexpr uint32_t kChunkEnd = 1 << 1;
+constexpr uint32_t kParent = 1 << 2;
+constexpr uint32_t kRoot = 1 << 3;
+
+constexpr uint32_t kIV[8] = {
+  0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+  0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+constexpr uint8_t kMessageSchedule[7][16] = {
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+  {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+  {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+  {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+  {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+  {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+  {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+inline uint32_t rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t loadLE32(const uint8_t* p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) |
+         (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline void g(uint32_t* v, int a, int b, int c, int d, uint32_t x, uint32_t y) {
+  v[a] = v[a] + v[b] + x;
+  v[d] = rotr(v[d] ^ v[a], 16);
+  v[c] = v[c] + v[d];
+  v[b] = rotr(v[b] ^ v[c], 12);
+  v[a] = v[a] + v[b] + y;
+  v[d] = rotr(v[d] ^ v[a], 8);
+  v[c] = v[c] + v[d];
+  v[b] = rotr(v[b] ^ v[c], 7);
+}
+
+// Compress one block; `out` receives the first 8 words of the state
+// (the chaining value, or the first 32 bytes of root output).
+void compress(const uint32_t cv[8], const uint8_t block[kBlockLength],
+              uint8_t blockLength, uint64_t counter, uint32_t flags,
+              uint32_t out[8]) {
+  uint32_t m[16];
+  for (int i = 0; i < 16; ++i) m[i] = loadLE32(block + i * 4);
+
+  uint32_t v[16] = {
+    cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+    kIV[0], kIV[1], kIV[2], kIV[3],
+    static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+    blockLength, flags,
+  };
+#pragma GCC unroll 7
+  for (const auto& s : kMessageSchedule) {
+    g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+    g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+    g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+    g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+    g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+    g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+  }
+  for (int i = 0; i < 8; ++i) out[i] = v[i] ^ v[i + 8];
+}
+
+// Inputs to a final compression, kept so it can be run with or without
+// ROOT. This is the Blake3Node record handed out for tree hashing.
+using Output = Blake3Node;
+
+void chainingValue(const Output& output, uint32_t out[8]) {
+  compress(output.cv, output.block, output.blockLength, output.counter,
+           output.flags, out);
+}
+
+void rootBytes(const Output& output, uint8_t out[32]) {
+  uint32_t words[8];
+  compress(output.cv, output.block, output.blockLength, 0,
+           output.flags | kRoot, words);
+  for (int i = 0; i < 8; ++i) {
+    out[i * 4] = static_cast<uint8_t>(words[i]);
+    out[i * 4 + 1] = static_cast<uint8_t>(words[i] >> 8);
+    out[i * 4 + 2] = static_cast<uint8_t>(words[i] >> 16);
+    out[i * 4 + 3] = static_cast<uint8_t>(words[i] >> 24);
+  }
+}
+
+Output parentOutput(const uint32_t left[8], const uint32_t right[8]) {
+  Output output;
+  std::memcpy(output.cv, kIV, sizeof(kIV));
+  for (int i = 0; i < 8; ++i) {
+    uint32_t l = left[i], r = right[i];
+    for (int b = 0; b < 4; ++b) {
+      output.block[i * 4 + b] = static_cast<uint8_t>(l >> (b * 8));
+      output.block[32 + i * 4 + b] = static_cast<uint8_t>(r >> (b * 8));
+    }
+  }
+  output.blockLength = kBlockLength;
+  output.counter = 0;
+  output.flags = kParent;
+  return output;
+}
+
+class ChunkState {
+public:
+  explicit ChunkState(uint64_t counter) : counter_(counter) {
+    std::memcpy(cv_, kIV, sizeof(kIV));
+  }
+
+  size_t length() const {
+    return blocksCompressed_ * kBlockLength + blockLength_;
+  }
+
+  uint64_t counter() const { return counter_; }
+
+  void update(const uint8_t* data, size_t size) {
+    while (size > 0) {
+      // Hold the last block back: it is compressed with CHUNK_END.
+      if (blockLength_ == kBlockLength) {
+        compress(cv_, block_, kBlockLength, counter_, startFlag(), cv_);
+        ++blocksCompressed_;
+        blockLength_ = 0;
+      }
+      // Compress whole blocks straight from the input while more follows.
+      while (blockLength_ == 0 && size > kBlockLength) {
+        compress(cv_, data, kBlockLength, counter_, startFlag(), cv_);
+        ++blocksCompressed_;
+        data += kBlockLength;
+        size -= kBlockLength;
+      }
+      size_t take = std::min(size, kBlockLength - blockLength_);
+      std::memcpy(block_ + blockLength_, data, take);
+      blockLength_ += take;
+      data += take;
+      size -= take;
+    }
+  }
+
+  Output output() const {
+    Output output;
+    std::memcpy(output.cv, cv_, sizeof(cv_));
+    std::memset(output.block, 0, sizeof(output.block));
+    std::memcpy(output.block, block_, blockLength_);
+    output.blockLength = static_cast<uint8_t>(blockLength_);
+    output.counter = counter_;
+    output.flags = startFlag() | kChunkEnd;
+    return output;
+  }
+
+private:
+  uint32_t startFlag() const { return blocksCompressed_ == 0 ? kChunkStart : 0; }
+
+  uint32_t cv_[8];
+  uint64_t counter_;
+  uint8_t block_[kBlockLength] = {};
+  size_t blockLength_ = 0;
+  size_t blocksCompressed_ = 0;
+};
+
+class Blake3Hasher : public Blake3RangeHasher {
+public:
+  explicit Blake3Hasher(uint64_t firstChunk = 0) : chunk_(firstChunk) {}
+
+  void update(const uint8_t* data, size_t size) override {
+    while (size > 0) {
+      if (chunk_.length() == kChunkLength) {
+        uint32_t cv[8];
+        chainingValue(chunk_.output(), cv);
+        uint64_t totalChunks = chunk_.counter() + 1;
+        pushChunk(cv, totalChunks);
+        chunk_ = ChunkState(totalChunks);
+      }
+      size_t take = std::min(size, kChunkLength - chunk_.length());
+      chunk_.update(data, take);
+      data += take;
+      size -= take;
+    }
+  }
+
+  std::vector<uint8_t> digest() override {
+    std::vector<uint8_t> out(32);
+    rootBytes(node(), out.data());
+    return out;
+  }
+
+  Blake3Node node() override {
+    Output output = chunk_.output();
+    for (size_t i = stackSize_; i > 0; --i) {
+      uint32_t right[8];
+      chainingValue(output, right);
+      output = parentOutput(stack_[i - 1], right);
+    }
+    return output;
+  }
+
+private:
+  // Merge completed subtrees: one merge per trailing zero bit of the
+  // chunk count, so the stack only holds the tree's right edge. Counts
+  // are absolute, which is equivalent inside an aligned power-of-two range.
+  void pushChunk(uint32_t cv[8], uint64_t totalChunks) {
+    while ((totalChunks & 1) == 0) {
+      chainingValue(parentOutput(stack_[--stackSize_], cv), cv);
+      totalChunks >>= 1;
+    }
+    std::memcpy(stack_[stackSize_++], cv, sizeof(stack_[0]));
+  }
+
+  ChunkState chunk_;
+  uint32_t stack_[kMaxDepth][8];
+  size_t stackSize_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<Hasher> createBlake3Hasher() {
+  return std::make_unique<Blake3Hasher>();
+}
+
+std::unique_ptr<Blake3RangeHasher> createBlake3RangeHasher(uint64_t firstChunk) {
+  return std::make_unique<Blake3Hasher>(firstChunk);
+}
+
+std::vector<uint8_t> blake3ChainingValue(const Blake3Node& node) {
+  uint32_t words[8];
+  chainingValue(node, words);
+  std::vector<uint8_t> out(32);
+  for (int i = 0; i < 8; ++i) {
+    for (int b = 0; b < 4; ++b) out[i * 4 + b] = static_cast<uint8_t>(words[i] >> (b * 8));
+  }
+  return out;
+}
+
+std::vector<uint8_t> blake3CombineRanges(const std::vector<Blake3Node>& ranges) {
+  // Every range but the last is a complete subtree of the same
+  // power-of-two size, so merging them follows the same stack rule as
+  // single chunks one level up. The last node stays unfinalized until it
+  // is known whether it is the root.
+  uint32_t stack[kMaxDepth][8];
+  size_t stackSize = 0;
+  for (size_t i = 0; i + 1 < ranges.size(); ++i) {
+    uint32_t cv[8];
+    chainingValue(ranges[i], cv);
+    uint64_t totalRanges = i + 1;
+    while ((totalRanges & 1) == 0) {
+      chainingValue(parentOutput(stack[--stackSize], cv), cv);
+      totalRanges >>= 1;
+    }
+    std::memcpy(stack[stackSize++], cv, sizeof(stack[0]));
+  }
+
+  Output output = ranges.back();
+  for (size_t i = stackSize; i > 0; --i) {
+    uint32_t right[8];
+    chainingValue(output, right);
+    output = parentOutput(stack[i - 1], right);
+  }
+  std::vector<uint8_t> out(32);
+  rootBytes(output, out.data());
+  return out;
+}
+
+} // namespace bufferedblob
@@ -1,6 +1,16 @@
 #include "BufferedBlobStreamingHostObject.h"
+#include "DownloadScheduler.h"
+#include "DownloadStream.h"
+#include "DownloadVerifier.h"
+#include "Hasher.h"
+#include "NativeHandleRegistry.h"
+#include "OperationStats.h"
+#include "SegmentedDownload.h"
 #include <ReactCommon/TurboModuleUtils.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -16,9 +26,51 @@ static int safeHandleId(const facebook::jsi::Value& val) {
 
 using namespace facebook;
 
+// Optional integer argument: undefined/null (or a missing argument) means
+// "use the default".
+static std::optional<int> optionalInt(jsi::Runtime& rt, const jsi::Value* args,
+                                      size_t count, size_t index,
+                                      const char* name) {
+  if (index >= count || args[index].isUndefined() || args[index].isNull()) {
+    return std::nullopt;
+  }
+  double value = args[index].asNumber();
+  if (!std::isfinite(value) || value != std::floor(value) ||
+      value < INT32_MIN || value > INT32_MAX) {
+    throw jsi::JSError(
+        rt, std::string("[INVALID_ARGUMENT] ") + name + " must be an integer");
+  }
+  return static_cast<int>(value);
+}
+
+// Write from the ArrayBuffer's own memory instead of copying it. Holding
+// the jsi::ArrayBuffer keeps it reachable for the GC until the write
+// completes; it must be released on the JS thread.
+static WriteBuffer pinArrayBuffer(
+    jsi::Runtime& rt,
+    jsi::ArrayBuffer buffer,
+    const std::shared_ptr<react::CallInvoker>& callInvoker,
+    const std::shared_ptr<std::atomic<bool>>& alive) {
+  auto arrayBuffer = std::shared_ptr<jsi::ArrayBuffer>(
+      new jsi::ArrayBuffer(std::move(buffer)),
+      [callInvoker, alive](jsi::ArrayBuffer* ptr) {
+        callInvoker->invokeAsync([ptr, alive]() {
+          // After runtime teardown the value can no longer be
+          // released safely; leak it instead.
+          if (!*alive) return;
+          delete ptr;
+        });
+      });
+  WriteBuffer data;
+  data.data = arrayBuffer->data(rt);
+  data.size = arrayBuffer->size(rt);
+  data.keepAlive = std::move(arrayBuffer);
+  return data;
+}
+
 // --- OwnedMutableBuffer ---
 
-OwnedMutableBuffer::OwnedMutableBuffer(std::vector<uint8_t> data)
+OwnedMutableBuffer::OwnedMutableBuffer(ChunkBuffer data)
     : data_(std::move(data)) {}
 
 size_t OwnedMutableBuffer::size() const {
@@ -29,6 +81,20 @@ uint8_t* OwnedMutableBuffer::data() {
   return data_.data();
 }
 
+// --- MappedMutableBuffer ---
+
+MappedMutableBuffer::MappedMutableBuffer(
+    std::shared_ptr<MappedFile> mapping, size_t offset, size_t length)
+    : mapping_(std::move(mapping)), offset_(offset), length_(length) {}
+
+size_t MappedMutableBuffer::size() const {
+  return length_;
+}
+
+uint8_t* MappedMutableBuffer::data() {
+  return mapping_->data() + offset_;
+}
+
 // --- BufferedBlobStreamingHostObject ---
 
 BufferedBlobStreamingHostObject::BufferedBlobStreamingHostObject(
@@ -48,13 +114,36 @@ std::vector<jsi::PropNameID> BufferedBlobStreamingHostObject::getPropertyNames(
     jsi::Runtime& rt) {
   std::vector<jsi::PropNameID> names;
   names.push_back(jsi::PropNameID::forAscii(rt, "readNextChunk"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "readChunks"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "readAt"));
   names.push_back(jsi::PropNameID::forAscii(rt, "write"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "writev"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "setWriteBehind"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "setCompression"));
   names.push_back(jsi::PropNameID::forAscii(rt, "flush"));
   names.push_back(jsi::PropNameID::forAscii(rt, "close"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "setReadAhead"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "setDecompression"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "openMapped"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "readMapped"));
   names.push_back(jsi::PropNameID::forAscii(rt, "startDownload"));
   names.push_back(jsi::PropNameID::forAscii(rt, "cancelDownload"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "setDownloadPriority"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "setDownloadLimits"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "getDownloadQueueStats"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "verifyDownload"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "hashFile"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "hashFileTree"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "createHasher"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "updateHasher"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "digestHasher"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "attachHasher"));
   names.push_back(jsi::PropNameID::forAscii(rt, "getReaderInfo"));
   names.push_back(jsi::PropNameID::forAscii(rt, "getWriterInfo"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "getBufferPoolStats"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "setBufferPoolLimit"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "getStats"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "resetStats"));
   return names;
 }
 
@@ -73,41 +162,179 @@ jsi::Value BufferedBlobStreamingHostObject::get(
             throw jsi::JSError(rt, "readNextChunk requires 1 argument");
           }
           int handleId = safeHandleId(args[0]);
+          OperationTimer timer(StatsOperation::ReadNextChunk, handleId);
           auto callInvoker = callInvoker_;
           auto bridge = bridge_;
           auto alive = alive_;
 
           return react::createPromiseAsJSIValue(
               rt,
-              [handleId, callInvoker, bridge, alive](
+              [handleId, callInvoker, bridge, alive, timer](
                   jsi::Runtime& rt2,
                   std::shared_ptr<react::Promise> promise) {
                 bridge->readNextChunk(
                     handleId,
                     // onSuccess: data available
-                    [callInvoker, promise, rtPtr = &rt2, alive](std::vector<uint8_t> data) {
+                    [callInvoker, promise, rtPtr = &rt2, alive, timer](ChunkBuffer data) {
+                      auto done = timer.completed();
+                      // Wrap on the worker thread: ChunkBuffer is move-only and
+                      // invokeAsync requires a copyable callable.
+                      auto buffer = std::make_shared<OwnedMutableBuffer>(
+                          std::move(data));
                       callInvoker->invokeAsync(
-                          [promise, rtPtr, data = std::move(data), alive]() mutable {
+                          [promise, rtPtr, buffer = std::move(buffer), alive, done]() mutable {
                             if (!*alive) return;
-                            auto buffer = std::make_shared<OwnedMutableBuffer>(
-                                std::move(data));
+                            done.delivered(true, buffer->size());
                             auto arrayBuffer = jsi::ArrayBuffer(
                                 *rtPtr, std::move(buffer));
                             promise->resolve(std::move(arrayBuffer));
                           });
                     },
                     // onEOF: no more data
-                    [callInvoker, promise, alive]() {
-                      callInvoker->invokeAsync([promise, alive]() {
+                    [callInvoker, promise, alive, timer]() {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync([promise, alive, done]() {
                         if (!*alive) return;
+                        done.delivered(true);
                         promise->resolve(jsi::Value::null());
                       });
                     },
                     // onError
-                    [callInvoker, promise, alive](std::string error) {
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
                       callInvoker->invokeAsync(
-                          [promise, error = std::move(error), alive]() {
+                          [promise, error = std::move(error), alive, done]() {
                             if (!*alive) return;
+                            done.delivered(false);
+                            promise->reject(error);
+                          });
+                    });
+              });
+        });
+  }
+
+  // --- readChunks(handleId, maxChunks, maxBytes): Promise<ArrayBuffer[]> ---
+  // One promise and one JS-thread hop for a whole batch; [] means EOF.
+  if (propName == "readChunks") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 3,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 3) {
+            throw jsi::JSError(rt, "readChunks requires 3 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          OperationTimer timer(StatsOperation::ReadChunks, handleId);
+          double maxChunks = args[1].asNumber();
+          double maxBytes = args[2].asNumber();
+          if (std::isnan(maxChunks) || maxChunks < 1 || maxChunks > 1024) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] maxChunks must be between 1 and 1024");
+          }
+          if (std::isnan(maxBytes) || maxBytes < 1) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] maxBytes must be >= 1");
+          }
+          auto callInvoker = callInvoker_;
+          auto bridge = bridge_;
+          auto alive = alive_;
+
+          return react::createPromiseAsJSIValue(
+              rt,
+              [handleId, maxChunks = static_cast<size_t>(maxChunks),
+               maxBytes = std::isinf(maxBytes) ? SIZE_MAX : static_cast<size_t>(maxBytes),
+               callInvoker, bridge, alive, timer](
+                  jsi::Runtime& rt2,
+                  std::shared_ptr<react::Promise> promise) {
+                bridge->readChunks(
+                    handleId, maxChunks, maxBytes,
+                    [callInvoker, promise, rtPtr = &rt2, alive, timer](
+                        std::vector<ChunkBuffer> chunks) {
+                      auto done = timer.completed();
+                      std::vector<std::shared_ptr<OwnedMutableBuffer>> buffers;
+                      buffers.reserve(chunks.size());
+                      size_t bytes = 0;
+                      for (auto& chunk : chunks) {
+                        bytes += chunk.size();
+                        buffers.push_back(
+                            std::make_shared<OwnedMutableBuffer>(std::move(chunk)));
+                      }
+                      callInvoker->invokeAsync(
+                          [promise, rtPtr, buffers = std::move(buffers), alive, done,
+                           bytes]() mutable {
+                            if (!*alive) return;
+                            done.delivered(true, bytes);
+                            auto array = jsi::Array(*rtPtr, buffers.size());
+                            for (size_t i = 0; i < buffers.size(); ++i) {
+                              array.setValueAtIndex(
+                                  *rtPtr, i,
+                                  jsi::ArrayBuffer(*rtPtr, std::move(buffers[i])));
+                            }
+                            promise->resolve(std::move(array));
+                          });
+                    },
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync(
+                          [promise, error = std::move(error), alive, done]() {
+                            if (!*alive) return;
+                            done.delivered(false);
+                            promise->reject(error);
+                          });
+                    });
+              });
+        });
+  }
+
+  // --- readAt(handleId, offset, length): Promise<ArrayBuffer> ---
+  if (propName == "readAt") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 3,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 3) {
+            throw jsi::JSError(rt, "readAt requires 3 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          OperationTimer timer(StatsOperation::ReadAt, handleId);
+          double offset = args[1].asNumber();
+          double length = args[2].asNumber();
+          if (!std::isfinite(offset) || offset < 0 || offset > 9007199254740991.0) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] offset must be a non-negative integer");
+          }
+          if (!std::isfinite(length) || length < 0 || length > 4194304.0) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] length must be between 0 and 4194304");
+          }
+          auto callInvoker = callInvoker_;
+          auto bridge = bridge_;
+          auto alive = alive_;
+
+          return react::createPromiseAsJSIValue(
+              rt,
+              [handleId, offset = static_cast<int64_t>(offset),
+               length = static_cast<size_t>(length), callInvoker, bridge, alive,
+               timer](
+                  jsi::Runtime& rt2,
+                  std::shared_ptr<react::Promise> promise) {
+                bridge->readAt(
+                    handleId, offset, length,
+                    [callInvoker, promise, rtPtr = &rt2, alive, timer](ChunkBuffer data) {
+                      auto done = timer.completed();
+                      auto buffer = std::make_shared<OwnedMutableBuffer>(
+                          std::move(data));
+                      callInvoker->invokeAsync(
+                          [promise, rtPtr, buffer = std::move(buffer), alive, done]() mutable {
+                            if (!*alive) return;
+                            done.delivered(true, buffer->size());
+                            auto arrayBuffer = jsi::ArrayBuffer(
+                                *rtPtr, std::move(buffer));
+                            promise->resolve(std::move(arrayBuffer));
+                          });
+                    },
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync(
+                          [promise, error = std::move(error), alive, done]() {
+                            if (!*alive) return;
+                            done.delivered(false);
                             promise->reject(error);
                           });
                     });
@@ -125,37 +352,97 @@ jsi::Value BufferedBlobStreamingHostObject::get(
             throw jsi::JSError(rt, "write requires 2 arguments");
           }
           int handleId = safeHandleId(args[0]);
-          auto arrayBuffer =
-              args[1].asObject(rt).getArrayBuffer(rt);
-          auto dataPtr = arrayBuffer.data(rt);
-          auto dataSize = arrayBuffer.size(rt);
+          OperationTimer timer(StatsOperation::Write, handleId);
+          auto callInvoker = callInvoker_;
+          auto bridge = bridge_;
+          auto alive = alive_;
+
+          WriteBuffer data = pinArrayBuffer(
+              rt, args[1].asObject(rt).getArrayBuffer(rt), callInvoker, alive);
 
-          // Copy data since the ArrayBuffer may be GC'd
-          std::vector<uint8_t> dataCopy(dataPtr, dataPtr + dataSize);
+          return react::createPromiseAsJSIValue(
+              rt,
+              [handleId, callInvoker, bridge, alive, timer,
+               data = std::move(data)](
+                  jsi::Runtime& rt2,
+                  std::shared_ptr<react::Promise> promise) {
+                bridge->write(
+                    handleId, data,
+                    [callInvoker, promise, alive, timer](int bytesWritten) {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync(
+                          [promise, bytesWritten, alive, done]() {
+                            if (!*alive) return;
+                            done.delivered(true, static_cast<uint64_t>(bytesWritten));
+                            promise->resolve(jsi::Value(static_cast<double>(bytesWritten)));
+                          });
+                    },
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync(
+                          [promise, error = std::move(error), alive, done]() {
+                            if (!*alive) return;
+                            done.delivered(false);
+                            promise->reject(error);
+                          });
+                    });
+              });
+        });
+  }
 
+  // --- writev(handleId, buffers): Promise<number> ---
+  if (propName == "writev") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 2,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "writev requires 2 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          OperationTimer timer(StatsOperation::Writev, handleId);
           auto callInvoker = callInvoker_;
           auto bridge = bridge_;
           auto alive = alive_;
 
+          auto array = args[1].asObject(rt).getArray(rt);
+          size_t length = array.size(rt);
+          std::vector<WriteBuffer> buffers;
+          buffers.reserve(length);
+          size_t total = 0;
+          for (size_t i = 0; i < length; ++i) {
+            buffers.push_back(pinArrayBuffer(
+                rt, array.getValueAtIndex(rt, i).asObject(rt).getArrayBuffer(rt),
+                callInvoker, alive));
+            total += buffers.back().size;
+          }
+          if (total > static_cast<size_t>(INT32_MAX)) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] writev batch must be under 2GB");
+          }
+
           return react::createPromiseAsJSIValue(
               rt,
-              [handleId, callInvoker, bridge, alive,
-               dataCopy = std::move(dataCopy)](
+              [handleId, callInvoker, bridge, alive, timer,
+               buffers = std::move(buffers)](
                   jsi::Runtime& rt2,
                   std::shared_ptr<react::Promise> promise) {
-                bridge->write(
-                    handleId, std::move(dataCopy),
-                    [callInvoker, promise, alive](int bytesWritten) {
+                bridge->writev(
+                    handleId, buffers,
+                    [callInvoker, promise, alive, timer](int bytesWritten) {
+                      auto done = timer.completed();
                       callInvoker->invokeAsync(
-                          [promise, bytesWritten, alive]() {
+                          [promise, bytesWritten, alive, done]() {
                             if (!*alive) return;
+                            done.delivered(true, static_cast<uint64_t>(bytesWritten));
                             promise->resolve(jsi::Value(static_cast<double>(bytesWritten)));
                           });
                     },
-                    [callInvoker, promise, alive](std::string error) {
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
                       callInvoker->invokeAsync(
-                          [promise, error = std::move(error), alive]() {
+                          [promise, error = std::move(error), alive, done]() {
                             if (!*alive) return;
+                            done.delivered(false);
                             promise->reject(error);
                           });
                     });
@@ -163,6 +450,52 @@ jsi::Value BufferedBlobStreamingHostObject::get(
         });
   }
 
+  // --- setWriteBehind(handleId, highWaterMark, lowWaterMark): void (synchronous) ---
+  if (propName == "setWriteBehind") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 3,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 3) {
+            throw jsi::JSError(rt, "setWriteBehind requires 3 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          double highWaterMark = args[1].asNumber();
+          double lowWaterMark = args[2].asNumber();
+          if (!std::isfinite(highWaterMark) || highWaterMark < 1 ||
+              !std::isfinite(lowWaterMark) || lowWaterMark < 0 ||
+              lowWaterMark > highWaterMark) {
+            throw jsi::JSError(
+                rt, "[INVALID_ARGUMENT] Expected 0 <= lowWaterMark <= highWaterMark");
+          }
+          bridge_->setWriteBehind(handleId, static_cast<size_t>(highWaterMark),
+                                  static_cast<size_t>(lowWaterMark));
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- setCompression(handleId, format, level?, windowBits?): void (synchronous) ---
+  if (propName == "setCompression") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 4,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "setCompression requires at least 2 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          auto format = args[1].asString(rt).utf8(rt);
+          auto level = optionalInt(rt, args, count, 2, "level");
+          auto windowBits = optionalInt(rt, args, count, 3, "windowBits");
+          try {
+            bridge_->setCompression(handleId, format, level, windowBits);
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
+          return jsi::Value::undefined();
+        });
+  }
+
   // --- flush(handleId): Promise<void> ---
   if (propName == "flush") {
     return jsi::Function::createFromHostFunction(
@@ -173,27 +506,32 @@ jsi::Value BufferedBlobStreamingHostObject::get(
             throw jsi::JSError(rt, "flush requires 1 argument");
           }
           int handleId = safeHandleId(args[0]);
+          OperationTimer timer(StatsOperation::Flush, handleId);
           auto callInvoker = callInvoker_;
           auto bridge = bridge_;
           auto alive = alive_;
 
           return react::createPromiseAsJSIValue(
               rt,
-              [handleId, callInvoker, bridge, alive](
+              [handleId, callInvoker, bridge, alive, timer](
                   jsi::Runtime& rt2,
                   std::shared_ptr<react::Promise> promise) {
                 bridge->flush(
                     handleId,
-                    [callInvoker, promise, alive]() {
-                      callInvoker->invokeAsync([promise, alive]() {
+                    [callInvoker, promise, alive, timer]() {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync([promise, alive, done]() {
                         if (!*alive) return;
+                        done.delivered(true);
                         promise->resolve(jsi::Value::undefined());
                       });
                     },
-                    [callInvoker, promise, alive](std::string error) {
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
                       callInvoker->invokeAsync(
-                          [promise, error = std::move(error), alive]() {
+                          [promise, error = std::move(error), alive, done]() {
                             if (!*alive) return;
+                            done.delivered(false);
                             promise->reject(error);
                           });
                     });
@@ -216,10 +554,113 @@ jsi::Value BufferedBlobStreamingHostObject::get(
         });
   }
 
-  // --- startDownload(handleId, onProgress): Promise<void> ---
-  if (propName == "startDownload") {
+  // --- setReadAhead(handleId, depth): void (synchronous) ---
+  if (propName == "setReadAhead") {
     return jsi::Function::createFromHostFunction(
         rt, name, 2,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "setReadAhead requires 2 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          double depth = args[1].asNumber();
+          if (std::isnan(depth) || depth < 0) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] readAhead must be >= 0");
+          }
+          bridge_->setReadAhead(handleId, static_cast<int>(std::min(depth, 1024.0)));
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- setDecompression(handleId, format, windowBits?): void (synchronous) ---
+  if (propName == "setDecompression") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 3,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "setDecompression requires at least 2 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          auto format = args[1].asString(rt).utf8(rt);
+          auto windowBits = optionalInt(rt, args, count, 2, "windowBits");
+          try {
+            bridge_->setDecompression(handleId, format, windowBits);
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- openMapped(path): { handleId, fileSize } (synchronous) ---
+  if (propName == "openMapped") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 1,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 1) {
+            throw jsi::JSError(rt, "openMapped requires 1 argument");
+          }
+          auto path = args[0].asString(rt).utf8(rt);
+          int handleId;
+          try {
+            handleId = bridge_->openMapped(path);
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
+          auto mapping = bridge_->getMapping(handleId);
+          auto obj = jsi::Object(rt);
+          obj.setProperty(rt, "handleId", handleId);
+          obj.setProperty(rt, "fileSize",
+                          static_cast<double>(mapping ? mapping->size() : 0));
+          return obj;
+        });
+  }
+
+  // --- readMapped(handleId, offset, length): ArrayBuffer (synchronous) ---
+  // Returns a view into the mapping clamped to the end of the file.
+  if (propName == "readMapped") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 3,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 3) {
+            throw jsi::JSError(rt, "readMapped requires 3 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          double offset = args[1].asNumber();
+          double length = args[2].asNumber();
+          if (std::isnan(offset) || offset < 0 || std::isnan(length) || length < 0) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] offset and length must be >= 0");
+          }
+          auto mapping = bridge_->getMapping(handleId);
+          if (!mapping) {
+            throw jsi::JSError(rt, "[READER_CLOSED] Mapped reader handle not found: " +
+                                       std::to_string(handleId));
+          }
+          double fileSize = static_cast<double>(mapping->size());
+          double start = std::min(offset, fileSize);
+          double end = std::min(start + length, fileSize);
+          auto buffer = std::make_shared<MappedMutableBuffer>(
+              std::move(mapping), static_cast<size_t>(start),
+              static_cast<size_t>(end - start));
+          return jsi::ArrayBuffer(rt, std::move(buffer));
+        });
+  }
+
+  // --- startDownload(handleId, onProgress, progressInterval?, progressBytes?, resume?,
+  //                   segments?, minSegmentSize?, priority?, stream?, writeFile?,
+  //                   streamBufferSize?): Promise<void> ---
+  // The transfer starts once the DownloadScheduler has a slot for it. With
+  // `stream` the body is also queued in a DownloadStream that
+  // readNextChunk(handleId) drains; a full queue stalls the transfer.
+  // Progress is pushed by the transfer and throttled natively; at most one
+  // report is queued on the JS thread at a time, carrying the latest counts.
+  if (propName == "startDownload") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 11,
         [this](jsi::Runtime& rt, const jsi::Value&,
                const jsi::Value* args, size_t count) -> jsi::Value {
           if (count < 2) {
@@ -228,6 +669,58 @@ jsi::Value BufferedBlobStreamingHostObject::get(
           int handleId = safeHandleId(args[0]);
           auto progressFn =
               std::make_shared<jsi::Function>(args[1].asObject(rt).asFunction(rt));
+          PlatformBridge::DownloadConfig config;
+          if (auto interval = optionalInt(rt, args, count, 2, "progressInterval")) {
+            if (*interval < 0) {
+              throw jsi::JSError(rt, "[INVALID_ARGUMENT] progressInterval must not be negative");
+            }
+            config.progress.minIntervalMs = *interval;
+          }
+          if (auto bytes = optionalInt(rt, args, count, 3, "progressBytes")) {
+            if (*bytes < 0) {
+              throw jsi::JSError(rt, "[INVALID_ARGUMENT] progressBytes must not be negative");
+            }
+            config.progress.minBytes = *bytes;
+          }
+          config.resume = count > 4 && args[4].isBool() && args[4].getBool();
+          if (auto segments = optionalInt(rt, args, count, 5, "segments")) {
+            if (*segments < 1 || *segments > SegmentedDownload::kMaxSegments) {
+              throw jsi::JSError(rt, "[INVALID_ARGUMENT] segments must be between 1 and 16");
+            }
+            config.segments = *segments;
+          }
+          if (auto size = optionalInt(rt, args, count, 6, "minSegmentSize")) {
+            if (*size < SegmentedDownload::kMinSegmentSize) {
+              throw jsi::JSError(rt, "[INVALID_ARGUMENT] minSegmentSize must be >= 65536");
+            }
+            config.minSegmentSize = *size;
+          }
+          auto priority = DownloadPriority::Normal;
+          if (auto value = optionalInt(rt, args, count, 7, "priority")) {
+            if (*value < 0 || *value > 2) {
+              throw jsi::JSError(rt, "[INVALID_ARGUMENT] priority must be 0, 1 or 2");
+            }
+            priority = static_cast<DownloadPriority>(*value);
+          }
+          std::shared_ptr<DownloadStream> stream;
+          if (count > 8 && args[8].isBool() && args[8].getBool()) {
+            size_t bufferBytes = DownloadStream::kDefaultMaxBufferedBytes;
+            if (auto size = optionalInt(rt, args, count, 10, "streamBufferSize")) {
+              if (*size < 1) {
+                throw jsi::JSError(rt, "[INVALID_ARGUMENT] streamBufferSize must be >= 1");
+              }
+              bufferBytes = static_cast<size_t>(*size);
+            }
+            config.stream = true;
+            config.writeFile = !(count > 9 && args[9].isBool() && !args[9].getBool());
+            // The reader gets every byte once, in order.
+            config.resume = false;
+            config.segments = 1;
+            stream = std::make_shared<DownloadStream>(bufferBytes);
+            NativeHandleRegistry::shared().attachDownloadStream(handleId, stream);
+          }
+          auto verifier = NativeHandleRegistry::shared().downloadVerifier(handleId);
+          std::string host = DownloadScheduler::hostKey(bridge_->downloadUrl(handleId));
           auto callInvoker = callInvoker_;
           auto bridge = bridge_;
           auto alive = alive_;
@@ -235,40 +728,253 @@ jsi::Value BufferedBlobStreamingHostObject::get(
           // Safe because invokeAsync runs on JS thread where runtime is valid.
           jsi::Runtime* rtPtr = &rt;
 
+          struct PendingProgress {
+            std::mutex mutex;
+            bool scheduled = false;
+            double bytesDownloaded = 0;
+            double totalBytes = -1;
+            double progress = -1;
+          };
+          auto pending = std::make_shared<PendingProgress>();
+
           return react::createPromiseAsJSIValue(
               rt,
-              [handleId, callInvoker, bridge, progressFn, rtPtr, alive](
+              [handleId, config, priority, host = std::move(host), stream, verifier,
+               callInvoker, bridge, progressFn, pending, rtPtr, alive](
                   jsi::Runtime& rt2,
                   std::shared_ptr<react::Promise> promise) {
-                bridge->startDownload(
-                    handleId,
-                    // onProgress callback - invoke on JS thread
-                    [callInvoker, progressFn, rtPtr, alive](
-                        double bytesDownloaded, double totalBytes,
-                        double progress) {
-                      callInvoker->invokeAsync(
-                          [progressFn, rtPtr, bytesDownloaded, totalBytes,
-                           progress, alive]() {
-                            if (!*alive) return;
-                            progressFn->call(
-                                *rtPtr,
-                                jsi::Value(bytesDownloaded),
-                                jsi::Value(totalBytes),
-                                jsi::Value(progress));
-                          });
+                // onProgress callback - coalesced onto the JS thread
+                auto onProgress = [callInvoker, progressFn, pending, rtPtr, alive](
+                                      double bytesDownloaded, double totalBytes,
+                                      double progress) {
+                  {
+                    std::lock_guard<std::mutex> lock(pending->mutex);
+                    pending->bytesDownloaded = bytesDownloaded;
+                    pending->totalBytes = totalBytes;
+                    pending->progress = progress;
+                    if (pending->scheduled) return;
+                    pending->scheduled = true;
+                  }
+                  callInvoker->invokeAsync(
+                      [progressFn, pending, rtPtr, alive]() {
+                        double bytesDownloaded, totalBytes, progress;
+                        {
+                          std::lock_guard<std::mutex> lock(pending->mutex);
+                          pending->scheduled = false;
+                          bytesDownloaded = pending->bytesDownloaded;
+                          totalBytes = pending->totalBytes;
+                          progress = pending->progress;
+                        }
+                        if (!*alive) return;
+                        progressFn->call(
+                            *rtPtr,
+                            jsi::Value(bytesDownloaded),
+                            jsi::Value(totalBytes),
+                            jsi::Value(progress));
+                      });
+                };
+                // Free the slot before settling, so a download started from
+                // the promise's continuation does not queue behind this one.
+                auto onError = [handleId, stream, callInvoker, promise, alive](
+                                   std::string error) {
+                  if (stream) stream->fail(error);
+                  DownloadScheduler::shared().release(handleId);
+                  callInvoker->invokeAsync(
+                      [promise, error = std::move(error), alive]() {
+                        if (!*alive) return;
+                        promise->reject(error);
+                      });
+                };
+                auto onSuccess = [handleId, stream, verifier, onError, callInvoker,
+                                  promise, alive]() {
+                  if (verifier) {
+                    std::string error = verifier->verify();
+                    if (!error.empty()) {
+                      onError(std::move(error));
+                      return;
+                    }
+                  }
+                  if (stream) stream->finish();
+                  DownloadScheduler::shared().release(handleId);
+                  callInvoker->invokeAsync([promise, alive]() {
+                    if (!*alive) return;
+                    promise->resolve(jsi::Value::undefined());
+                  });
+                };
+
+                DownloadScheduler::shared().submit(
+                    handleId, host, priority,
+                    [handleId, config, bridge, onProgress, onSuccess, onError]() {
+                      bridge->startDownload(handleId, config, onProgress, onSuccess, onError);
                     },
-                    // onSuccess
-                    [callInvoker, promise, alive]() {
+                    [stream, callInvoker, promise, alive]() {
+                      if (stream) stream->fail("[DOWNLOAD_CANCELLED] Download was cancelled");
                       callInvoker->invokeAsync([promise, alive]() {
                         if (!*alive) return;
-                        promise->resolve(jsi::Value::undefined());
+                        promise->reject("[DOWNLOAD_CANCELLED] Download was cancelled");
                       });
+                    });
+              });
+        });
+  }
+
+  // --- cancelDownload(handleId): void (synchronous) ---
+  if (propName == "cancelDownload") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 1,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 1) {
+            throw jsi::JSError(rt, "cancelDownload requires 1 argument");
+          }
+          int handleId = safeHandleId(args[0]);
+          // A queued download is dropped without ever opening a connection.
+          DownloadScheduler::shared().cancel(handleId);
+          // Wakes a transfer blocked on a full stream so it sees the cancel.
+          if (auto stream = NativeHandleRegistry::shared().downloadStream(handleId)) {
+            stream->close();
+          }
+          bridge_->cancelDownload(handleId);
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- setDownloadPriority(handleId, priority): boolean (synchronous) ---
+  // False once the download has left the queue.
+  if (propName == "setDownloadPriority") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 2,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "setDownloadPriority requires 2 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          auto priority = optionalInt(rt, args, count, 1, "priority");
+          if (!priority || *priority < 0 || *priority > 2) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] priority must be 0, 1 or 2");
+          }
+          return jsi::Value(DownloadScheduler::shared().setPriority(
+              handleId, static_cast<DownloadPriority>(*priority)));
+        });
+  }
+
+  // --- setDownloadLimits(maxConcurrent, maxPerHost): void (synchronous) ---
+  if (propName == "setDownloadLimits") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 2,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "setDownloadLimits requires 2 arguments");
+          }
+          auto maxConcurrent = optionalInt(rt, args, count, 0, "maxConcurrent");
+          auto maxPerHost = optionalInt(rt, args, count, 1, "maxPerHost");
+          if (!maxConcurrent || !maxPerHost || *maxConcurrent < 1 || *maxPerHost < 1) {
+            throw jsi::JSError(
+                rt, "[INVALID_ARGUMENT] maxConcurrent and maxPerHost must be >= 1");
+          }
+          DownloadScheduler::shared().setLimits(*maxConcurrent, *maxPerHost);
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- getDownloadQueueStats(): { running, queued, ... } (synchronous) ---
+  if (propName == "getDownloadQueueStats") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 0,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value*, size_t) -> jsi::Value {
+          auto stats = DownloadScheduler::shared().stats();
+          auto obj = jsi::Object(rt);
+          obj.setProperty(rt, "running", static_cast<double>(stats.running));
+          obj.setProperty(rt, "queued", static_cast<double>(stats.queued));
+          obj.setProperty(rt, "started", static_cast<double>(stats.started));
+          obj.setProperty(rt, "cancelledWhileQueued",
+                          static_cast<double>(stats.cancelledWhileQueued));
+          obj.setProperty(rt, "totalWaitMs", static_cast<double>(stats.totalWaitMs));
+          obj.setProperty(rt, "maxWaitMs", static_cast<double>(stats.maxWaitMs));
+          obj.setProperty(rt, "maxConcurrent", stats.maxConcurrent);
+          obj.setProperty(rt, "maxPerHost", stats.maxPerHost);
+          return obj;
+        });
+  }
+
+  // --- verifyDownload(handleId, destPath, algorithm, digest, expectedSize):
+  //     void (synchronous) ---
+  // Call before startDownload. algorithm may be "" and expectedSize -1 to
+  // skip that check; a mismatch rejects the download and removes destPath.
+  if (propName == "verifyDownload") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 5,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 5) {
+            throw jsi::JSError(rt, "verifyDownload requires 5 arguments");
+          }
+          int handleId = safeHandleId(args[0]);
+          std::string destPath = args[1].asString(rt).utf8(rt);
+          std::string algorithm = args[2].asString(rt).utf8(rt);
+          std::string digest = args[3].asString(rt).utf8(rt);
+          double expectedSize = args[4].asNumber();
+          if (!std::isfinite(expectedSize) || expectedSize < -1 ||
+              expectedSize != std::floor(expectedSize)) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] expectedSize must be a non-negative integer");
+          }
+          try {
+            NativeHandleRegistry::shared().attachDownloadVerifier(
+                handleId, std::make_shared<DownloadVerifier>(
+                              std::move(destPath), algorithm, std::move(digest),
+                              static_cast<int64_t>(expectedSize)));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- hashFile(path, algorithm): Promise<string> ---
+  if (propName == "hashFile") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 2,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          OperationTimer timer(StatsOperation::HashFile);
+          if (count < 2) {
+            throw jsi::JSError(rt, "hashFile requires 2 arguments");
+          }
+          auto path = args[0].asString(rt).utf8(rt);
+          auto algorithm = args[1].asString(rt).utf8(rt);
+          if (!Hasher::isSupported(algorithm)) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] Unsupported hash algorithm: " + algorithm);
+          }
+          auto callInvoker = callInvoker_;
+          auto bridge = bridge_;
+          auto alive = alive_;
+
+          return react::createPromiseAsJSIValue(
+              rt,
+              [path, algorithm, callInvoker, bridge, alive, timer](
+                  jsi::Runtime& rt2,
+                  std::shared_ptr<react::Promise> promise) {
+                bridge->hashFile(
+                    path, algorithm,
+                    [callInvoker, promise, rtPtr = &rt2, alive, timer](std::string hex) {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync(
+                          [promise, rtPtr, hex = std::move(hex), alive, done]() {
+                            if (!*alive) return;
+                            done.delivered(true);
+                            promise->resolve(
+                                jsi::String::createFromUtf8(*rtPtr, hex));
+                          });
                     },
-                    // onError
-                    [callInvoker, promise, alive](std::string error) {
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
                       callInvoker->invokeAsync(
-                          [promise, error = std::move(error), alive]() {
+                          [promise, error = std::move(error), alive, done]() {
                             if (!*alive) return;
+                            done.delivered(false);
                             promise->reject(error);
                           });
                     });
@@ -276,17 +982,156 @@ jsi::Value BufferedBlobStreamingHostObject::get(
         });
   }
 
-  // --- cancelDownload(handleId): void (synchronous) ---
-  if (propName == "cancelDownload") {
+  // --- hashFileTree(path, algorithm, chunkSize, includeChunkDigests):
+  //     Promise<{ digest, chunkSize, chunkDigests? }> ---
+  if (propName == "hashFileTree") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 4,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          OperationTimer timer(StatsOperation::HashFileTree);
+          if (count < 4) {
+            throw jsi::JSError(rt, "hashFileTree requires 4 arguments");
+          }
+          auto path = args[0].asString(rt).utf8(rt);
+          auto algorithm = args[1].asString(rt).utf8(rt);
+          double chunkSizeArg = args[2].asNumber();
+          bool includeChunkDigests = args[3].getBool();
+          if (!TreeHashJob::isSupported(algorithm)) {
+            throw jsi::JSError(
+                rt, "[INVALID_ARGUMENT] Tree hashing supports blake3 and sha256, got: " + algorithm);
+          }
+          if (!std::isfinite(chunkSizeArg) || chunkSizeArg < TreeHashJob::kMinChunkSize ||
+              chunkSizeArg > TreeHashJob::kMaxChunkSize) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] chunkSize out of range");
+          }
+          size_t chunkSize = static_cast<size_t>(chunkSizeArg);
+          auto callInvoker = callInvoker_;
+          auto bridge = bridge_;
+          auto alive = alive_;
+
+          return react::createPromiseAsJSIValue(
+              rt,
+              [path, algorithm, chunkSize, includeChunkDigests, callInvoker,
+               bridge, alive, timer](
+                  jsi::Runtime& rt2,
+                  std::shared_ptr<react::Promise> promise) {
+                bridge->hashFileTree(
+                    path, algorithm, chunkSize, includeChunkDigests,
+                    [callInvoker, promise, rtPtr = &rt2, chunkSize,
+                     includeChunkDigests, alive, timer](TreeHashResult result) {
+                      auto done = timer.completed();
+                      auto shared = std::make_shared<TreeHashResult>(std::move(result));
+                      callInvoker->invokeAsync(
+                          [promise, rtPtr, shared, chunkSize,
+                           includeChunkDigests, alive, done]() {
+                            if (!*alive) return;
+                            done.delivered(true);
+                            auto& rt = *rtPtr;
+                            auto obj = jsi::Object(rt);
+                            obj.setProperty(rt, "digest",
+                                            jsi::String::createFromUtf8(rt, shared->digest));
+                            obj.setProperty(rt, "chunkSize", static_cast<double>(chunkSize));
+                            if (includeChunkDigests) {
+                              auto digests = jsi::Array(rt, shared->chunkDigests.size());
+                              for (size_t i = 0; i < shared->chunkDigests.size(); ++i) {
+                                digests.setValueAtIndex(
+                                    rt, i,
+                                    jsi::String::createFromUtf8(rt, shared->chunkDigests[i]));
+                              }
+                              obj.setProperty(rt, "chunkDigests", digests);
+                            }
+                            promise->resolve(std::move(obj));
+                          });
+                    },
+                    [callInvoker, promise, alive, timer](std::string error) {
+                      auto done = timer.completed();
+                      callInvoker->invokeAsync(
+                          [promise, error = std::move(error), alive, done]() {
+                            if (!*alive) return;
+                            done.delivered(false);
+                            promise->reject(error);
+                          });
+                    });
+              });
+        });
+  }
+
+  // --- createHasher(algorithm): number (synchronous) ---
+  if (propName == "createHasher") {
     return jsi::Function::createFromHostFunction(
         rt, name, 1,
         [this](jsi::Runtime& rt, const jsi::Value&,
                const jsi::Value* args, size_t count) -> jsi::Value {
           if (count < 1) {
-            throw jsi::JSError(rt, "cancelDownload requires 1 argument");
+            throw jsi::JSError(rt, "createHasher requires 1 argument");
+          }
+          auto algorithm = args[0].asString(rt).utf8(rt);
+          try {
+            return jsi::Value(bridge_->createHasher(algorithm));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
+        });
+  }
+
+  // --- updateHasher(hasherId, data): void (synchronous) ---
+  // Hashes the ArrayBuffer's memory in place; nothing is copied.
+  if (propName == "updateHasher") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 2,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "updateHasher requires 2 arguments");
+          }
+          int hasherId = safeHandleId(args[0]);
+          auto buffer = args[1].asObject(rt).getArrayBuffer(rt);
+          try {
+            bridge_->updateHasher(hasherId, buffer.data(rt), buffer.size(rt));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- digestHasher(hasherId): string (synchronous) ---
+  if (propName == "digestHasher") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 1,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 1) {
+            throw jsi::JSError(rt, "digestHasher requires 1 argument");
+          }
+          int hasherId = safeHandleId(args[0]);
+          std::string hex;
+          try {
+            hex = bridge_->digestHasher(hasherId);
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
+          return jsi::String::createFromUtf8(rt, hex);
+        });
+  }
+
+  // --- attachHasher(handleId, hasherId): void (synchronous) ---
+  if (propName == "attachHasher") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 2,
+        [this](jsi::Runtime& rt, const jsi::Value&,
+               const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 2) {
+            throw jsi::JSError(rt, "attachHasher requires 2 arguments");
           }
           int handleId = safeHandleId(args[0]);
-          bridge_->cancelDownload(handleId);
+          int hasherId = safeHandleId(args[1]);
+          try {
+            bridge_->attachHasher(handleId, hasherId);
+          } catch (const std::exception& e) {
+            throw jsi::JSError(rt, e.what());
+          }
           return jsi::Value::undefined();
         });
   }
@@ -310,7 +1155,7 @@ jsi::Value BufferedBlobStreamingHostObject::get(
         });
   }
 
-  // --- getWriterInfo(handleId): { bytesWritten } (synchronous) ---
+  // --- getWriterInfo(handleId): { bytesWritten, pendingBytes } (synchronous) ---
   if (propName == "getWriterInfo") {
     return jsi::Function::createFromHostFunction(
         rt, name, 1,
@@ -323,10 +1168,100 @@ jsi::Value BufferedBlobStreamingHostObject::get(
           auto info = bridge_->getWriterInfo(handleId);
           auto obj = jsi::Object(rt);
           obj.setProperty(rt, "bytesWritten", info.bytesWritten);
+          obj.setProperty(rt, "pendingBytes", info.pendingBytes);
+          return obj;
+        });
+  }
+
+  // --- getBufferPoolStats(): { hits, misses, ... } (synchronous) ---
+  if (propName == "getBufferPoolStats") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 0,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value*, size_t) -> jsi::Value {
+          auto stats = ChunkPool::shared().stats();
+          auto obj = jsi::Object(rt);
+          obj.setProperty(rt, "hits", static_cast<double>(stats.hits));
+          obj.setProperty(rt, "misses", static_cast<double>(stats.misses));
+          obj.setProperty(rt, "releases", static_cast<double>(stats.releases));
+          obj.setProperty(rt, "discards", static_cast<double>(stats.discards));
+          obj.setProperty(rt, "retainedBytes", static_cast<double>(stats.retainedBytes));
+          obj.setProperty(rt, "maxRetainedBytes", static_cast<double>(stats.maxRetainedBytes));
+          return obj;
+        });
+  }
+
+  // --- setBufferPoolLimit(maxRetainedBytes): void (synchronous) ---
+  if (propName == "setBufferPoolLimit") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 1,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value* args, size_t count) -> jsi::Value {
+          if (count < 1) {
+            throw jsi::JSError(rt, "setBufferPoolLimit requires 1 argument");
+          }
+          double bytes = args[0].asNumber();
+          if (std::isnan(bytes) || bytes < 0) {
+            throw jsi::JSError(rt, "[INVALID_ARGUMENT] maxRetainedBytes must be >= 0");
+          }
+          ChunkPool::shared().setMaxRetainedBytes(
+              std::isinf(bytes) ? SIZE_MAX : static_cast<size_t>(bytes));
+          return jsi::Value::undefined();
+        });
+  }
+
+  // --- getStats(): { windowMs, operations: { [name]: { completed, failed,
+  //     bytes, latency: { [phase]: { count, minUs, ... } } } } } (synchronous) ---
+  if (propName == "getStats") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 0,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value*, size_t) -> jsi::Value {
+          auto& stats = OperationStats::shared();
+          auto operations = jsi::Object(rt);
+          for (int i = 0; i < static_cast<int>(StatsOperation::Count); ++i) {
+            auto operation = static_cast<StatsOperation>(i);
+            auto counters = stats.counters(operation);
+            auto latency = jsi::Object(rt);
+            for (int j = 0; j < static_cast<int>(StatsPhase::Count); ++j) {
+              auto phase = static_cast<StatsPhase>(j);
+              auto summary = stats.latency(operation, phase);
+              auto histogram = jsi::Object(rt);
+              histogram.setProperty(rt, "count", static_cast<double>(summary.count));
+              histogram.setProperty(rt, "minUs", static_cast<double>(summary.min));
+              histogram.setProperty(rt, "meanUs", summary.mean);
+              histogram.setProperty(rt, "p50Us", static_cast<double>(summary.p50));
+              histogram.setProperty(rt, "p90Us", static_cast<double>(summary.p90));
+              histogram.setProperty(rt, "p99Us", static_cast<double>(summary.p99));
+              histogram.setProperty(rt, "p999Us", static_cast<double>(summary.p999));
+              histogram.setProperty(rt, "maxUs", static_cast<double>(summary.max));
+              latency.setProperty(rt, OperationStats::name(phase), histogram);
+            }
+            auto entry = jsi::Object(rt);
+            entry.setProperty(rt, "completed", static_cast<double>(counters.completed));
+            entry.setProperty(rt, "failed", static_cast<double>(counters.failed));
+            entry.setProperty(rt, "bytes", static_cast<double>(counters.bytes));
+            entry.setProperty(rt, "latency", latency);
+            operations.setProperty(rt, OperationStats::name(operation), entry);
+          }
+          auto obj = jsi::Object(rt);
+          obj.setProperty(rt, "windowMs", static_cast<double>(stats.windowMs()));
+          obj.setProperty(rt, "operations", operations);
           return obj;
         });
   }
 
+  // --- resetStats(): void (synchronous) ---
+  if (propName == "resetStats") {
+    return jsi::Function::createFromHostFunction(
+        rt, name, 0,
+        [](jsi::Runtime& rt, const jsi::Value&,
+           const jsi::Value*, size_t) -> jsi::Value {
+          OperationStats::shared().reset();
+          return jsi::Value::undefined();
+        });
+  }
+
   return jsi::Value::undefined();
 }
 
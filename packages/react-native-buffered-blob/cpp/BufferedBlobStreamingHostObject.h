@@ -2,6 +2,7 @@
 
 #include <jsi/jsi.h>
 #include <ReactCommon/CallInvoker.h>
+#include "PlatformBridge.h"
 #include <memory>
 #include <functional>
 #include <vector>
@@ -11,64 +12,6 @@ namespace bufferedblob {
 
 using namespace facebook;
 
-/**
- * Platform bridge abstraction.
- * Each platform (Android/iOS) implements this interface to provide
- * native streaming operations that the JSI HostObject delegates to.
- */
-struct PlatformBridge {
-  virtual ~PlatformBridge() = default;
-
-  // Reader operations
-  virtual void readNextChunk(
-    int handleId,
-    std::function<void(std::vector<uint8_t>)> onSuccess,
-    std::function<void()> onEOF,
-    std::function<void(std::string)> onError
-  ) = 0;
-
-  // Writer operations
-  virtual void write(
-    int handleId,
-    std::vector<uint8_t> data,
-    std::function<void(int)> onSuccess,
-    std::function<void(std::string)> onError
-  ) = 0;
-
-  virtual void flush(
-    int handleId,
-    std::function<void()> onSuccess,
-    std::function<void(std::string)> onError
-  ) = 0;
-
-  // Close (sync)
-  virtual void close(int handleId) = 0;
-
-  // Download operations
-  virtual void startDownload(
-    int handleId,
-    std::function<void(double, double, double)> onProgress,
-    std::function<void()> onSuccess,
-    std::function<void(std::string)> onError
-  ) = 0;
-
-  virtual void cancelDownload(int handleId) = 0;
-
-  // Reader info (sync)
-  struct ReaderInfo {
-    double fileSize;
-    double bytesRead;
-    bool isEOF;
-  };
-  virtual ReaderInfo getReaderInfo(int handleId) = 0;
-
-  // Writer info (sync)
-  struct WriterInfo {
-    double bytesWritten;
-  };
-  virtual WriterInfo getWriterInfo(int handleId) = 0;
-};
-
 /**
  * JSI HostObject that exposes streaming operations to JavaScript.
  * Installed on global.__BufferedBlobStreaming by the install() method.
@@ -104,15 +47,32 @@ private:
 
 /**
  * MutableBuffer subclass that owns its data for zero-copy ArrayBuffer creation.
+ * Takes over the ChunkBuffer the platform bridge read into.
  */
 class OwnedMutableBuffer : public jsi::MutableBuffer {
 public:
-  explicit OwnedMutableBuffer(std::vector<uint8_t> data);
+  explicit OwnedMutableBuffer(ChunkBuffer data);
+  size_t size() const override;
+  uint8_t* data() override;
+
+private:
+  ChunkBuffer data_;
+};
+
+/**
+ * MutableBuffer over a range of a MappedFile. Holding the mapping keeps it
+ * mapped until the JS ArrayBuffer is garbage collected; no bytes are copied.
+ */
+class MappedMutableBuffer : public jsi::MutableBuffer {
+public:
+  MappedMutableBuffer(std::shared_ptr<MappedFile> mapping, size_t offset, size_t length);
   size_t size() const override;
   uint8_t* data() override;
 
 private:
-  std::vector<uint8_t> data_;
+  std::shared_ptr<MappedFile> mapping_;
+  size_t offset_;
+  size_t length_;
 };
 
 } // namespace bufferedblob
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ChunkPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace bufferedblob {
+
+/**
+ * Move-only byte buffer used for read chunks.
+ *
+ * Storage comes from ChunkPool uninitialized and is filled in place by the
+ * read syscall, then handed to OwnedMutableBuffer to back the
+ * jsi::ArrayBuffer returned to JS. The only copy on the read path is the
+ * kernel copy into this storage. Storage goes back to the pool when the
+ * buffer is destroyed.
+ */
+class ChunkBuffer {
+public:
+  ChunkBuffer() = default;
+
+  /** Acquire storage for at least `size` bytes from ChunkPool::shared(). */
+  explicit ChunkBuffer(size_t size) {
+    // Assigned in the body: capacity_ is an out-param of acquire() and its
+    // default member initializer would otherwise run after data_.
+    size_t capacity = 0;
+    data_ = ChunkPool::shared().acquire(size, capacity);
+    capacity_ = capacity;
+  }
+
+  ~ChunkBuffer() {
+    ChunkPool::shared().release(std::move(data_), capacity_);
+  }
+
+  ChunkBuffer(ChunkBuffer&& other) noexcept
+      : data_(std::move(other.data_)),
+        capacity_(other.capacity_),
+        size_(other.size_) {
+    other.capacity_ = 0;
+    other.size_ = 0;
+  }
+
+  ChunkBuffer& operator=(ChunkBuffer&& other) noexcept {
+    if (this != &other) {
+      ChunkPool::shared().release(std::move(data_), capacity_);
+      data_ = std::move(other.data_);
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.capacity_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  ChunkBuffer(const ChunkBuffer&) = delete;
+  ChunkBuffer& operator=(const ChunkBuffer&) = delete;
+
+  uint8_t* data() { return data_.get(); }
+  const uint8_t* data() const { return data_.get(); }
+
+  /** Number of valid bytes. */
+  size_t size() const { return size_; }
+
+  /** Allocated bytes; may exceed the requested size (size-class rounding). */
+  size_t capacity() const { return capacity_; }
+
+  /** Set the number of valid bytes after filling. Clamped to capacity. */
+  void setSize(size_t size) { size_ = size < capacity_ ? size : capacity_; }
+
+private:
+  std::unique_ptr<uint8_t[]> data_;
+  size_t capacity_{0};
+  size_t size_{0};
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,107 @@
+#include "ChunkPool.h"
+
+namespace bufferedblob {
+
+ChunkPool& ChunkPool::shared() {
+  static ChunkPool instance;
+  return instance;
+}
+
+int ChunkPool::classIndex(size_t size) {
+  if (size == 0 || size > kMaxClassSize) return -1;
+  int index = 0;
+  size_t classSize = kMinClassSize;
+  while (classSize < size) {
+    classSize <<= 1;
+    ++index;
+  }
+  return index;
+}
+
+std::unique_ptr<uint8_t[]> ChunkPool::acquire(size_t size, size_t& capacity) {
+  int index = classIndex(size);
+  if (index < 0) {
+    // Outside the pooled range: plain uninitialized allocation.
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    capacity = size;
+    return std::unique_ptr<uint8_t[]>(size > 0 ? new uint8_t[size] : nullptr);
+  }
+
+  capacity = kMinClassSize << index;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& freeList = freeLists_[index];
+    if (!freeList.empty()) {
+      auto storage = std::move(freeList.back());
+      freeList.pop_back();
+      retainedBytes_ -= capacity;
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return storage;
+    }
+  }
+
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return std::unique_ptr<uint8_t[]>(new uint8_t[capacity]);
+}
+
+void ChunkPool::release(std::unique_ptr<uint8_t[]> storage, size_t capacity) {
+  if (!storage) return;
+  releases_.fetch_add(1, std::memory_order_relaxed);
+
+  int index = classIndex(capacity);
+  if (index >= 0 && (kMinClassSize << index) == capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (retainedBytes_ + capacity <= maxRetainedBytes_) {
+      freeLists_[index].push_back(std::move(storage));
+      retainedBytes_ += capacity;
+      return;
+    }
+  }
+
+  // Pool full or odd-sized block: let unique_ptr free it.
+  discards_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ChunkPool::setMaxRetainedBytes(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  maxRetainedBytes_ = bytes;
+  trimLocked(bytes);
+}
+
+ChunkPool::Stats ChunkPool::stats() const {
+  Stats stats{};
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  stats.releases = releases_.load(std::memory_order_relaxed);
+  stats.discards = discards_.load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.retainedBytes = retainedBytes_;
+  stats.maxRetainedBytes = maxRetainedBytes_;
+  return stats;
+}
+
+void ChunkPool::resetStats() {
+  hits_ = 0;
+  misses_ = 0;
+  releases_ = 0;
+  discards_ = 0;
+}
+
+void ChunkPool::trim() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  trimLocked(0);
+}
+
+void ChunkPool::trimLocked(size_t targetBytes) {
+  // Drop the largest blocks first; they free the most memory per release.
+  for (size_t i = kClassCount; i-- > 0 && retainedBytes_ > targetBytes;) {
+    auto& freeList = freeLists_[i];
+    size_t classSize = kMinClassSize << i;
+    while (!freeList.empty() && retainedBytes_ > targetBytes) {
+      freeList.pop_back();
+      retainedBytes_ -= classSize;
+    }
+  }
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * Process-wide pool of chunk storage, bucketed into power-of-two size
+ * classes covering the 4KB-4MB range accepted by openRead.
+ *
+ * ChunkBuffer acquires its storage here and returns it on destruction
+ * (i.e. when the JS GC finalizes the ArrayBuffer), so a steady-state
+ * reader recycles the same blocks instead of hitting the allocator.
+ * Retained memory is capped by maxRetainedBytes; storage released while
+ * the pool is full is freed.
+ */
+class ChunkPool {
+public:
+  static constexpr size_t kMinClassSize = 4096;            // 2^12
+  static constexpr size_t kMaxClassSize = 4194304;         // 2^22
+  static constexpr size_t kClassCount = 11;
+  static constexpr size_t kDefaultMaxRetainedBytes = 16 * 1024 * 1024;
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t releases;
+    uint64_t discards;
+    size_t retainedBytes;
+    size_t maxRetainedBytes;
+  };
+
+  static ChunkPool& shared();
+
+  /**
+   * Get storage of at least `size` bytes. `capacity` receives the actual
+   * size of the block, which must be passed back to release().
+   */
+  std::unique_ptr<uint8_t[]> acquire(size_t size, size_t& capacity);
+
+  /** Return storage to the pool, or free it if the pool is full. */
+  void release(std::unique_ptr<uint8_t[]> storage, size_t capacity);
+
+  /** Change the retention cap. Shrinking frees cached blocks immediately. */
+  void setMaxRetainedBytes(size_t bytes);
+
+  Stats stats() const;
+  void resetStats();
+
+  /** Free all cached blocks. */
+  void trim();
+
+private:
+  ChunkPool() = default;
+
+  /** Size class index for `size`, or -1 if outside the pooled range. */
+  static int classIndex(size_t size);
+
+  void trimLocked(size_t targetBytes);
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<std::unique_ptr<uint8_t[]>>, kClassCount> freeLists_;
+  size_t retainedBytes_{0};
+  size_t maxRetainedBytes_{kDefaultMaxRetainedBytes};
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> releases_{0};
+  std::atomic<uint64_t> discards_{0};
+};
+
+} // namespace bufferedblob
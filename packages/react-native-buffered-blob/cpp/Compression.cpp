@@ -0,0 +1,364 @@
+#include "Compression.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include <zlib.h>
+
+#if BUFFEREDBLOB_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace bufferedblob {
+
+namespace {
+
+constexpr size_t kCompressedBufferSize = 65536;
+
+enum class ZlibFormat { Gzip, Deflate, DeflateRaw };
+
+bool parseZlibFormat(const std::string& format, ZlibFormat& result) {
+  if (format == "gzip") {
+    result = ZlibFormat::Gzip;
+  } else if (format == "deflate") {
+    result = ZlibFormat::Deflate;
+  } else if (format == "deflate-raw") {
+    result = ZlibFormat::DeflateRaw;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+[[noreturn]] void throwUnsupported(const std::string& format) {
+  if (format == "zstd") {
+    throw std::invalid_argument(
+        "[INVALID_ARGUMENT] zstd support is not compiled into this build");
+  }
+  throw std::invalid_argument(
+      "[INVALID_ARGUMENT] Unsupported compression format: " + format);
+}
+
+// zlib selects the container through the sign and offset of windowBits.
+int zlibWindowBits(ZlibFormat format, std::optional<int> windowBits) {
+  int bits = windowBits.value_or(MAX_WBITS);
+  if (bits < 9 || bits > MAX_WBITS) {
+    throw std::invalid_argument(
+        "[INVALID_ARGUMENT] windowBits must be between 9 and 15, got " +
+        std::to_string(bits));
+  }
+  switch (format) {
+    case ZlibFormat::Gzip: return bits + 16;
+    case ZlibFormat::Deflate: return bits;
+    case ZlibFormat::DeflateRaw: return -bits;
+  }
+  return bits;
+}
+
+std::string zlibError(const z_stream& stream) {
+  std::string error = "[IO_ERROR] Invalid compressed data";
+  if (stream.msg) error += std::string(": ") + stream.msg;
+  return error;
+}
+
+uInt clampSize(size_t size) {
+  return static_cast<uInt>(std::min<size_t>(size, UINT_MAX));
+}
+
+class ZlibDecompressor : public Decompressor {
+public:
+  ZlibDecompressor(ZlibFormat format, int windowBits)
+      : multiMember_(format == ZlibFormat::Gzip) {
+    std::memset(&stream_, 0, sizeof(stream_));
+    if (inflateInit2(&stream_, windowBits) != Z_OK) {
+      throw std::runtime_error("[IO_ERROR] Failed to initialize decompressor");
+    }
+  }
+
+  ~ZlibDecompressor() override { inflateEnd(&stream_); }
+
+  void decompress(const uint8_t*& in, size_t& inSize,
+                  uint8_t*& out, size_t& outSize) override {
+    if (ended_) {
+      if (inSize == 0) return;
+      if (!multiMember_) {
+        throw std::runtime_error(
+            "[IO_ERROR] Unexpected data after the end of the compressed stream");
+      }
+      // gzip allows several members back to back (e.g. appended logs).
+      inflateReset(&stream_);
+      ended_ = false;
+    }
+
+    stream_.next_in = const_cast<Bytef*>(in);
+    stream_.avail_in = clampSize(inSize);
+    stream_.next_out = out;
+    stream_.avail_out = clampSize(outSize);
+    uInt availIn = stream_.avail_in;
+    uInt availOut = stream_.avail_out;
+
+    int ret = inflate(&stream_, Z_NO_FLUSH);
+
+    size_t consumed = availIn - stream_.avail_in;
+    size_t produced = availOut - stream_.avail_out;
+    in += consumed;
+    inSize -= consumed;
+    out += produced;
+    outSize -= produced;
+
+    if (ret == Z_STREAM_END) {
+      ended_ = true;
+    } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      throw std::runtime_error(zlibError(stream_));
+    }
+  }
+
+  bool atEnd() const override { return ended_; }
+
+private:
+  z_stream stream_;
+  const bool multiMember_;
+  bool ended_{false};
+};
+
+class ZlibCompressor : public Compressor {
+public:
+  ZlibCompressor(int level, int windowBits) {
+    std::memset(&stream_, 0, sizeof(stream_));
+    if (deflateInit2(&stream_, level, Z_DEFLATED, windowBits, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw std::runtime_error("[IO_ERROR] Failed to initialize compressor");
+    }
+  }
+
+  ~ZlibCompressor() override { deflateEnd(&stream_); }
+
+  bool compress(const uint8_t*& in, size_t& inSize,
+                uint8_t*& out, size_t& outSize, Flush flush) override {
+    int mode = flush == Flush::Finish ? Z_FINISH
+               : flush == Flush::Sync ? Z_SYNC_FLUSH
+                                      : Z_NO_FLUSH;
+    stream_.next_in = const_cast<Bytef*>(in);
+    stream_.avail_in = clampSize(inSize);
+    stream_.next_out = out;
+    stream_.avail_out = clampSize(outSize);
+    uInt availIn = stream_.avail_in;
+    uInt availOut = stream_.avail_out;
+
+    int ret = deflate(&stream_, mode);
+    if (ret == Z_STREAM_ERROR) {
+      throw std::runtime_error("[IO_ERROR] Compression failed");
+    }
+
+    size_t consumed = availIn - stream_.avail_in;
+    size_t produced = availOut - stream_.avail_out;
+    in += consumed;
+    inSize -= consumed;
+    out += produced;
+    outSize -= produced;
+
+    if (inSize > 0) return false;
+    switch (flush) {
+      case Flush::None: return true;
+      // deflate() has flushed everything once it stops short of the
+      // space it was given (Z_BUF_ERROR: nothing left to flush).
+      case Flush::Sync: return stream_.avail_out > 0;
+      case Flush::Finish: return ret == Z_STREAM_END;
+    }
+    return true;
+  }
+
+private:
+  z_stream stream_;
+};
+
+#if BUFFEREDBLOB_HAVE_ZSTD
+
+// Frames larger than this need an explicit windowBits when decoding
+// (zstd's own default limit).
+constexpr int kZstdDefaultWindowLogMax = 27;
+constexpr int kZstdDefaultLevel = 3;
+
+std::string zstdError(size_t code) {
+  return std::string("[IO_ERROR] Invalid compressed data: ") +
+         ZSTD_getErrorName(code);
+}
+
+void setZstdParameter(size_t result, const char* name, int value) {
+  if (ZSTD_isError(result)) {
+    throw std::invalid_argument(std::string("[INVALID_ARGUMENT] Invalid zstd ") +
+                                name + ": " + std::to_string(value));
+  }
+}
+
+class ZstdDecompressor : public Decompressor {
+public:
+  explicit ZstdDecompressor(std::optional<int> windowBits)
+      : context_(ZSTD_createDCtx()) {
+    if (!context_) {
+      throw std::runtime_error("[IO_ERROR] Failed to initialize decompressor");
+    }
+    int windowLogMax = windowBits.value_or(kZstdDefaultWindowLogMax);
+    try {
+      setZstdParameter(
+          ZSTD_DCtx_setParameter(context_, ZSTD_d_windowLogMax, windowLogMax),
+          "windowBits", windowLogMax);
+    } catch (...) {
+      ZSTD_freeDCtx(context_);
+      throw;
+    }
+  }
+
+  ~ZstdDecompressor() override { ZSTD_freeDCtx(context_); }
+
+  void decompress(const uint8_t*& in, size_t& inSize,
+                  uint8_t*& out, size_t& outSize) override {
+    ZSTD_inBuffer input{in, inSize, 0};
+    ZSTD_outBuffer output{out, outSize, 0};
+    size_t ret = ZSTD_decompressStream(context_, &output, &input);
+    if (ZSTD_isError(ret)) throw std::runtime_error(zstdError(ret));
+
+    in += input.pos;
+    inSize -= input.pos;
+    out += output.pos;
+    outSize -= output.pos;
+    // 0 means a frame just ended and all of it has been flushed; the next
+    // call starts a new frame if more input follows.
+    if (input.pos > 0 || output.pos > 0) frameDone_ = ret == 0;
+  }
+
+  bool atEnd() const override { return frameDone_; }
+
+private:
+  ZSTD_DCtx* context_;
+  bool frameDone_{false};
+};
+
+class ZstdCompressor : public Compressor {
+public:
+  ZstdCompressor(std::optional<int> level, std::optional<int> windowBits)
+      : context_(ZSTD_createCCtx()) {
+    if (!context_) {
+      throw std::runtime_error("[IO_ERROR] Failed to initialize compressor");
+    }
+    try {
+      int compressionLevel = level.value_or(kZstdDefaultLevel);
+      if (compressionLevel < ZSTD_minCLevel() || compressionLevel > ZSTD_maxCLevel()) {
+        throw std::invalid_argument(
+            "[INVALID_ARGUMENT] zstd level must be between " +
+            std::to_string(ZSTD_minCLevel()) + " and " +
+            std::to_string(ZSTD_maxCLevel()) + ", got " +
+            std::to_string(compressionLevel));
+      }
+      setZstdParameter(
+          ZSTD_CCtx_setParameter(context_, ZSTD_c_compressionLevel, compressionLevel),
+          "level", compressionLevel);
+      if (windowBits) {
+        setZstdParameter(
+            ZSTD_CCtx_setParameter(context_, ZSTD_c_windowLog, *windowBits),
+            "windowBits", *windowBits);
+      }
+    } catch (...) {
+      ZSTD_freeCCtx(context_);
+      throw;
+    }
+  }
+
+  ~ZstdCompressor() override { ZSTD_freeCCtx(context_); }
+
+  bool compress(const uint8_t*& in, size_t& inSize,
+                uint8_t*& out, size_t& outSize, Flush flush) override {
+    ZSTD_EndDirective mode = flush == Flush::Finish ? ZSTD_e_end
+                             : flush == Flush::Sync ? ZSTD_e_flush
+                                                    : ZSTD_e_continue;
+    ZSTD_inBuffer input{in, inSize, 0};
+    ZSTD_outBuffer output{out, outSize, 0};
+    size_t ret = ZSTD_compressStream2(context_, &output, &input, mode);
+    if (ZSTD_isError(ret)) {
+      throw std::runtime_error(std::string("[IO_ERROR] Compression failed: ") +
+                               ZSTD_getErrorName(ret));
+    }
+
+    in += input.pos;
+    inSize -= input.pos;
+    out += output.pos;
+    outSize -= output.pos;
+    if (inSize > 0) return false;
+    // For flush and end, the return value is what is still buffered.
+    return flush == Flush::None || ret == 0;
+  }
+
+private:
+  ZSTD_CCtx* context_;
+};
+
+#endif // BUFFEREDBLOB_HAVE_ZSTD
+
+} // namespace
+
+std::unique_ptr<Decompressor> Decompressor::create(
+    const std::string& format, std::optional<int> windowBits) {
+  ZlibFormat zlibFormat;
+  if (parseZlibFormat(format, zlibFormat)) {
+    return std::make_unique<ZlibDecompressor>(
+        zlibFormat, zlibWindowBits(zlibFormat, windowBits));
+  }
+#if BUFFEREDBLOB_HAVE_ZSTD
+  if (format == "zstd") return std::make_unique<ZstdDecompressor>(windowBits);
+#endif
+  throwUnsupported(format);
+}
+
+std::unique_ptr<Compressor> Compressor::create(
+    const std::string& format, std::optional<int> level,
+    std::optional<int> windowBits) {
+  ZlibFormat zlibFormat;
+  if (parseZlibFormat(format, zlibFormat)) {
+    int compressionLevel = level.value_or(Z_DEFAULT_COMPRESSION);
+    if (compressionLevel != Z_DEFAULT_COMPRESSION &&
+        (compressionLevel < 0 || compressionLevel > 9)) {
+      throw std::invalid_argument(
+          "[INVALID_ARGUMENT] level must be between 0 and 9, got " +
+          std::to_string(compressionLevel));
+    }
+    return std::make_unique<ZlibCompressor>(
+        compressionLevel, zlibWindowBits(zlibFormat, windowBits));
+  }
+#if BUFFEREDBLOB_HAVE_ZSTD
+  if (format == "zstd") return std::make_unique<ZstdCompressor>(level, windowBits);
+#endif
+  throwUnsupported(format);
+}
+
+bool writeCompressed(int fd, Compressor& compressor,
+                     std::vector<uint8_t>& scratch, const uint8_t* data,
+                     size_t size, Compressor::Flush flush, std::string& error) {
+  if (scratch.empty()) scratch.resize(kCompressedBufferSize);
+  try {
+    while (true) {
+      uint8_t* out = scratch.data();
+      size_t outSize = scratch.size();
+      bool done = compressor.compress(data, size, out, outSize, flush);
+
+      size_t pending = scratch.size() - outSize;
+      size_t written = 0;
+      while (written < pending) {
+        ssize_t n = ::write(fd, scratch.data() + written, pending - written);
+        if (n < 0) {
+          if (errno == EINTR) continue;
+          error = std::string("[IO_ERROR] ") + std::strerror(errno);
+          return false;
+        }
+        written += static_cast<size_t>(n);
+      }
+      if (done) return true;
+    }
+  } catch (const std::exception& e) {
+    error = e.what();
+    return false;
+  }
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * Streaming compression stages for readers and writers.
+ *
+ * Supported formats:
+ *   gzip        - RFC 1952 (zlib); concatenated members decode as one stream
+ *   deflate     - RFC 1950 zlib-wrapped deflate (zlib)
+ *   deflate-raw - RFC 1951 raw deflate (zlib)
+ *   zstd        - Zstandard frames; only when built with libzstd
+ *                 (BUFFEREDBLOB_HAVE_ZSTD), concatenated frames decode
+ *                 as one stream
+ *
+ * `windowBits` is log2 of the window: 9-15 for the zlib formats (default
+ * 15), 10-31 for zstd (default: the level's window when compressing, a
+ * 27-bit limit when decompressing). Levels are 0-9 for zlib (default 6)
+ * and zstd's own range (default 3).
+ */
+class Decompressor {
+public:
+  virtual ~Decompressor() = default;
+
+  /**
+   * Decode from `in` into `out`, advancing both pointers and shrinking
+   * both sizes by what was consumed and produced. May make no progress
+   * when more input is needed. Throws std::runtime_error with
+   * "[IO_ERROR] ..." on corrupt data.
+   */
+  virtual void decompress(const uint8_t*& in, size_t& inSize,
+                          uint8_t*& out, size_t& outSize) = 0;
+
+  /** True once a complete stream has been decoded and fully delivered. */
+  virtual bool atEnd() const = 0;
+
+  /**
+   * Throws std::invalid_argument with "[INVALID_ARGUMENT] ..." for
+   * unknown formats or out-of-range settings.
+   */
+  static std::unique_ptr<Decompressor> create(const std::string& format,
+                                              std::optional<int> windowBits);
+};
+
+class Compressor {
+public:
+  enum class Flush {
+    /** Consume input; output may stay buffered inside the codec. */
+    None,
+    /** Also emit everything so far, keeping the stream open. */
+    Sync,
+    /** Also end the stream (trailer, checksum). */
+    Finish,
+  };
+
+  virtual ~Compressor() = default;
+
+  /**
+   * Encode from `in` into `out`, advancing both like
+   * Decompressor::decompress(). Returns true once all input has been
+   * consumed and, for Sync/Finish, everything it asks for has been
+   * written to `out`; call again with more room until it does.
+   */
+  virtual bool compress(const uint8_t*& in, size_t& inSize,
+                        uint8_t*& out, size_t& outSize, Flush flush) = 0;
+
+  /** Throws std::invalid_argument like Decompressor::create(). */
+  static std::unique_ptr<Compressor> create(const std::string& format,
+                                            std::optional<int> level,
+                                            std::optional<int> windowBits);
+};
+
+/**
+ * Compress `size` bytes and write the output to `fd`, staging it in
+ * `scratch` (sized on first use). Returns false with `error` set.
+ */
+bool writeCompressed(int fd, Compressor& compressor,
+                     std::vector<uint8_t>& scratch, const uint8_t* data,
+                     size_t size, Compressor::Flush flush, std::string& error);
+
+} // namespace bufferedblob
@@ -0,0 +1,154 @@
+#include "Hasher.h"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BUFFEREDBLOB_CRC32C_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+// On Android/Linux this file is compiled with +crc (see CMakeLists.txt)
+// and the instructions are only executed after a runtime check.
+#define BUFFEREDBLOB_CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace bufferedblob {
+
+namespace {
+
+// Castagnoli polynomial, reflected.
+constexpr uint32_t kPolynomial = 0x82f63b78;
+
+using Table = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Table makeTable() {
+  Table table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+    }
+    table[0][i] = crc;
+  }
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (size_t slice = 1; slice < 8; ++slice) {
+      uint32_t prev = table[slice - 1][i];
+      table[slice][i] = (prev >> 8) ^ table[0][prev & 0xff];
+    }
+  }
+  return table;
+}
+
+constexpr Table kTable = makeTable();
+
+using UpdateFunction = uint32_t (*)(uint32_t crc, const uint8_t* data, size_t size);
+
+// Slicing-by-8: one table lookup per byte, eight bytes per iteration.
+uint32_t updatePortable(uint32_t crc, const uint8_t* data, size_t size) {
+  while (size >= 8) {
+    uint32_t lo, hi;
+    std::memcpy(&lo, data, 4);
+    std::memcpy(&hi, data + 4, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    lo = __builtin_bswap32(lo);
+    hi = __builtin_bswap32(hi);
+#endif
+    lo ^= crc;
+    crc = kTable[7][lo & 0xff] ^ kTable[6][(lo >> 8) & 0xff] ^
+          kTable[5][(lo >> 16) & 0xff] ^ kTable[4][lo >> 24] ^
+          kTable[3][hi & 0xff] ^ kTable[2][(hi >> 8) & 0xff] ^
+          kTable[1][(hi >> 16) & 0xff] ^ kTable[0][hi >> 24];
+    data += 8;
+    size -= 8;
+  }
+  while (size--) {
+    crc = (crc >> 8) ^ kTable[0][(crc ^ *data++) & 0xff];
+  }
+  return crc;
+}
+
+#if BUFFEREDBLOB_CRC32C_X86
+
+__attribute__((target("sse4.2")))
+uint32_t updateSse42(uint32_t crc, const uint8_t* data, size_t size) {
+#if defined(__x86_64__)
+  uint64_t crc64 = crc;
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+    crc64 = _mm_crc32_u64(crc64, word);
+    data += 8;
+    size -= 8;
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif
+  while (size >= 4) {
+    uint32_t word;
+    std::memcpy(&word, data, 4);
+    crc = _mm_crc32_u32(crc, word);
+    data += 4;
+    size -= 4;
+  }
+  while (size--) {
+    crc = _mm_crc32_u8(crc, *data++);
+  }
+  return crc;
+}
+
+#endif // BUFFEREDBLOB_CRC32C_X86
+
+#if BUFFEREDBLOB_CRC32C_ARM
+
+uint32_t updateArm(uint32_t crc, const uint8_t* data, size_t size) {
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+    crc = __crc32cd(crc, word);
+    data += 8;
+    size -= 8;
+  }
+  while (size--) {
+    crc = __crc32cb(crc, *data++);
+  }
+  return crc;
+}
+
+#endif // BUFFEREDBLOB_CRC32C_ARM
+
+UpdateFunction selectUpdateFunction() {
+#if BUFFEREDBLOB_CRC32C_X86
+  if (cpuHasCrc32cInstructions()) return updateSse42;
+#elif BUFFEREDBLOB_CRC32C_ARM
+  if (cpuHasCrc32cInstructions()) return updateArm;
+#endif
+  return updatePortable;
+}
+
+class Crc32cHasher : public Hasher {
+public:
+  void update(const uint8_t* data, size_t size) override {
+    crc_ = update_(crc_, data, size);
+  }
+
+  std::vector<uint8_t> digest() override {
+    uint32_t value = ~crc_;
+    return {
+      static_cast<uint8_t>(value >> 24),
+      static_cast<uint8_t>(value >> 16),
+      static_cast<uint8_t>(value >> 8),
+      static_cast<uint8_t>(value),
+    };
+  }
+
+private:
+  uint32_t crc_ = 0xffffffff;
+  UpdateFunction update_ = selectUpdateFunction();
+};
+
+} // namespace
+
+std::unique_ptr<Hasher> createCrc32cHasher() {
+  return std::make_unique<Crc32cHasher>();
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,51 @@
+#include "DownloadProgress.h"
+#include <algorithm>
+
+namespace bufferedblob {
+
+DownloadProgress::DownloadProgress(Callback onProgress, ProgressThrottle throttle)
+    : onProgress_(std::move(onProgress)), throttle_(throttle) {}
+
+void DownloadProgress::setTotal(int64_t totalBytes) {
+  total_.store(totalBytes > 0 ? totalBytes : -1, std::memory_order_relaxed);
+}
+
+void DownloadProgress::add(size_t bytes) {
+  int64_t now = bytes_.fetch_add(static_cast<int64_t>(bytes),
+                                 std::memory_order_relaxed) +
+                static_cast<int64_t>(bytes);
+  if (!onProgress_) return;
+  // Cheap checks first; most buffers return here.
+  if (now - reportedBytes_.load(std::memory_order_relaxed) < throttle_.minBytes ||
+      now == reportedBytes_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Another thread reporting right now makes this one redundant.
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) return;
+  auto time = Clock::now();
+  if (time - lastReport_ < std::chrono::milliseconds(throttle_.minIntervalMs)) return;
+  lastReport_ = time;
+  report(bytes_.load(std::memory_order_relaxed), false);
+}
+
+void DownloadProgress::complete() {
+  if (!onProgress_) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  lastReport_ = Clock::now();
+  report(bytes_.load(std::memory_order_relaxed), true);
+}
+
+void DownloadProgress::report(int64_t bytes, bool final) {
+  reportedBytes_.store(bytes, std::memory_order_relaxed);
+  int64_t total = total_.load(std::memory_order_relaxed);
+  // Once finished, the byte count is the length even if it was unknown.
+  if (final) total = bytes;
+  double progress = total > 0
+      ? std::min(1.0, static_cast<double>(bytes) / static_cast<double>(total))
+      : final ? 1.0 : -1.0;
+  onProgress_(static_cast<double>(bytes), static_cast<double>(total), progress);
+}
+
+} // namespace bufferedblob
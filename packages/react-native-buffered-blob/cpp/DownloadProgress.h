@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace bufferedblob {
+
+/** When to report download progress: both thresholds must be met. */
+struct ProgressThrottle {
+  /** Minimum new bytes since the last report. */
+  int64_t minBytes{0};
+  /** Minimum time since the last report. */
+  int64_t minIntervalMs{100};
+};
+
+/**
+ * Byte counters for one running download, pushed by the transfer loop.
+ * add() is cheap enough to call for every received buffer and from
+ * several threads at once; `onProgress(bytesDownloaded, totalBytes,
+ * progress)` runs on the reporting thread whenever the throttle allows,
+ * and once more from complete(). totalBytes and progress are -1 while the
+ * length is unknown.
+ */
+class DownloadProgress {
+public:
+  using Callback = std::function<void(double, double, double)>;
+
+  DownloadProgress(Callback onProgress, ProgressThrottle throttle);
+
+  DownloadProgress(const DownloadProgress&) = delete;
+  DownloadProgress& operator=(const DownloadProgress&) = delete;
+
+  /** Expected length from the response, or -1 when unknown. */
+  void setTotal(int64_t totalBytes);
+
+  void add(size_t bytes);
+
+  /**
+   * Report the final count with progress 1. Call once the body has been
+   * fully received; totalBytes becomes the received length.
+   */
+  void complete();
+
+  int64_t bytesDownloaded() const { return bytes_.load(std::memory_order_relaxed); }
+
+private:
+  void report(int64_t bytes, bool final);
+
+  using Clock = std::chrono::steady_clock;
+
+  const Callback onProgress_;
+  const ProgressThrottle throttle_;
+  std::atomic<int64_t> bytes_{0};
+  std::atomic<int64_t> total_{-1};
+  std::atomic<int64_t> reportedBytes_{0};
+
+  /** Guards lastReport_ and orders reports. */
+  std::mutex mutex_;
+  Clock::time_point lastReport_{};
+};
+
+} // namespace bufferedblob
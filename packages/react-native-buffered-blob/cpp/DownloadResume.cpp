@@ -0,0 +1,252 @@
+#include "DownloadResume.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bufferedblob {
+
+namespace {
+
+constexpr const char* kSidecarHeader = "bufferedblob-resume 1";
+constexpr size_t kPrefixReadSize = 64 * 1024;
+
+bool parseInt64(const std::string& text, int64_t& value) {
+  if (text.empty()) return false;
+  char* end = nullptr;
+  errno = 0;
+  long long parsed = std::strtoll(text.c_str(), &end, 10);
+  if (errno != 0 || *end != '\0' || parsed < 0) return false;
+  value = static_cast<int64_t>(parsed);
+  return true;
+}
+
+bool writeAll(int fd, const std::string& data) {
+  size_t done = 0;
+  while (done < data.size()) {
+    ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    done += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+} // namespace
+
+bool parseContentRange(const std::string& value, int64_t& first, int64_t& last,
+                       int64_t& length) {
+  if (value.compare(0, 6, "bytes ") != 0) return false;
+  size_t dash = value.find('-', 6);
+  size_t slash = value.find('/', 6);
+  if (dash == std::string::npos || slash == std::string::npos || dash > slash) {
+    return false;
+  }
+  if (!parseInt64(value.substr(6, dash - 6), first) ||
+      !parseInt64(value.substr(dash + 1, slash - dash - 1), last) || last < first) {
+    return false;
+  }
+  std::string lengthText = value.substr(slash + 1);
+  if (lengthText == "*") {
+    length = -1;
+  } else if (!parseInt64(lengthText, length) || length <= last) {
+    return false;
+  }
+  return true;
+}
+
+std::string ifRangeValidator(const std::string& etag, const std::string& lastModified) {
+  // If-Range needs a strong validator; weak ETags fall back to the date.
+  if (!etag.empty() && etag.compare(0, 2, "W/") != 0) return etag;
+  return lastModified;
+}
+
+std::string DownloadResume::sidecarPath(const std::string& destPath) {
+  return destPath + ".resume";
+}
+
+DownloadResume::DownloadResume(std::string url, std::string destPath)
+    : url_(std::move(url)), destPath_(std::move(destPath)) {
+  FILE* file = std::fopen(sidecarPath(destPath_).c_str(), "r");
+  if (!file) return;
+
+  // "key=value" lines after the header; unknown keys are ignored.
+  std::string contents;
+  char buffer[1024];
+  size_t n;
+  while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.append(buffer, n);
+  }
+  std::fclose(file);
+
+  std::string savedUrl;
+  int64_t bytes = -1;
+  bool headerSeen = false;
+  size_t pos = 0;
+  while (pos < contents.size()) {
+    size_t end = contents.find('\n', pos);
+    if (end == std::string::npos) end = contents.size();
+    std::string line = contents.substr(pos, end - pos);
+    pos = end + 1;
+    if (!headerSeen) {
+      if (line != kSidecarHeader) break;
+      headerSeen = true;
+      continue;
+    }
+    size_t eq = line.find('=');
+    if (eq == std::string::npos) continue;
+    std::string key = line.substr(0, eq);
+    std::string value = line.substr(eq + 1);
+    if (key == "url") {
+      savedUrl = value;
+    } else if (key == "bytes") {
+      if (!parseInt64(value, bytes)) bytes = -1;
+    } else if (key == "etag") {
+      etag_ = value;
+    } else if (key == "last-modified") {
+      lastModified_ = value;
+    }
+  }
+
+  struct stat st;
+  if (!headerSeen || savedUrl != url_ || bytes < 0 || validator().empty() ||
+      ::stat(destPath_.c_str(), &st) != 0) {
+    discard();
+    return;
+  }
+
+  // Bytes past the checkpoint were never recorded as committed.
+  int64_t committed = std::min<int64_t>(bytes, st.st_size);
+  if (st.st_size > committed &&
+      ::truncate(destPath_.c_str(), static_cast<off_t>(committed)) != 0) {
+    discard();
+    return;
+  }
+  offset_ = committed_ = saved_ = committed;
+}
+
+std::vector<std::pair<std::string, std::string>> DownloadResume::requestHeaders() const {
+  std::vector<std::pair<std::string, std::string>> headers{
+      {"Accept-Encoding", "identity"},
+  };
+  if (offset_ > 0) {
+    headers.emplace_back("Range", "bytes=" + std::to_string(offset_) + "-");
+    headers.emplace_back("If-Range", validator());
+  }
+  return headers;
+}
+
+int64_t DownloadResume::onResponse(int status, const std::string& contentRange,
+                                   const std::string& etag,
+                                   const std::string& lastModified) {
+  if (status == 416) {
+    discard();
+    return -1;
+  }
+  if (status < 200 || status >= 300) return -1;
+
+  if (status == 206) {
+    int64_t first, last, length;
+    if (!parseContentRange(contentRange, first, last, length)) first = -1;
+    if (first != offset_) {
+      int64_t expected = offset_;
+      discard();
+      throw std::runtime_error(
+          "[DOWNLOAD_FAILED] Server resumed at byte " + std::to_string(first) +
+          ", expected " + std::to_string(expected));
+    }
+    if (!etag.empty()) etag_ = etag;
+    if (!lastModified.empty()) lastModified_ = lastModified;
+    return offset_;
+  }
+
+  // The whole body: the range was ignored or the resource changed.
+  etag_ = etag;
+  lastModified_ = lastModified;
+  offset_ = committed_ = saved_ = 0;
+  if (validator().empty()) {
+    ::unlink(sidecarPath(destPath_).c_str());
+  } else {
+    write();
+  }
+  return 0;
+}
+
+void DownloadResume::readPrefix(
+    const std::function<void(const uint8_t*, size_t)>& sink) const {
+  if (offset_ == 0) return;
+  int fd = ::open(destPath_.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error(std::string("[IO_ERROR] ") + std::strerror(errno));
+  }
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[kPrefixReadSize]);
+  int64_t remaining = offset_;
+  while (remaining > 0) {
+    size_t want = static_cast<size_t>(std::min<int64_t>(remaining, kPrefixReadSize));
+    ssize_t n = ::read(fd, buffer.get(), want);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      int err = errno;
+      ::close(fd);
+      throw std::runtime_error(std::string("[IO_ERROR] ") + std::strerror(err));
+    }
+    if (n == 0) {
+      ::close(fd);
+      throw std::runtime_error("[IO_ERROR] Partial download was truncated");
+    }
+    sink(buffer.get(), static_cast<size_t>(n));
+    remaining -= n;
+  }
+  ::close(fd);
+}
+
+void DownloadResume::advance(size_t bytes) {
+  committed_ += static_cast<int64_t>(bytes);
+  if (committed_ - saved_ >= kCheckpointBytes) write();
+}
+
+void DownloadResume::save() {
+  write();
+}
+
+void DownloadResume::finish() {
+  ::unlink(sidecarPath(destPath_).c_str());
+}
+
+void DownloadResume::write() {
+  if (validator().empty()) return;
+  std::string contents = std::string(kSidecarHeader) + "\n" +
+                         "url=" + url_ + "\n" +
+                         "bytes=" + std::to_string(committed_) + "\n" +
+                         "etag=" + etag_ + "\n" +
+                         "last-modified=" + lastModified_ + "\n";
+  // Best effort: a checkpoint that cannot be written only costs a restart.
+  std::string path = sidecarPath(destPath_);
+  std::string tempPath = path + ".tmp";
+  int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) return;
+  bool ok = writeAll(fd, contents);
+  ok = ::close(fd) == 0 && ok;
+  if (!ok || ::rename(tempPath.c_str(), path.c_str()) != 0) {
+    ::unlink(tempPath.c_str());
+    return;
+  }
+  saved_ = committed_;
+}
+
+void DownloadResume::discard() {
+  ::unlink(sidecarPath(destPath_).c_str());
+  etag_.clear();
+  lastModified_.clear();
+  offset_ = committed_ = saved_ = 0;
+}
+
+} // namespace bufferedblob
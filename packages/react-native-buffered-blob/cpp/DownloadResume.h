@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * Parse a Content-Range value, "bytes <first>-<last>/<length>"; length is
+ * -1 when the server sent "*". Returns false for anything else.
+ */
+bool parseContentRange(const std::string& value, int64_t& first, int64_t& last,
+                       int64_t& length);
+
+/**
+ * Validator for If-Range: the ETag when it is strong, else Last-Modified,
+ * else empty (the response cannot be safely continued).
+ */
+std::string ifRangeValidator(const std::string& etag, const std::string& lastModified);
+
+/**
+ * Checkpoint that lets a download continue where an earlier attempt
+ * stopped, after a failure, a cancel or an app restart.
+ *
+ * It is kept next to the destination as "<destPath>.resume" and records
+ * the URL, the bytes committed to destPath and the response's validator
+ * (ETag, or Last-Modified when there is no strong ETag). The next attempt
+ * asks for the rest with Range/If-Range, so a changed resource comes back
+ * whole and is written from byte 0. Responses without a validator cannot
+ * be resumed safely and leave no checkpoint.
+ *
+ * The checkpoint is written (atomically, by rename) every
+ * kCheckpointBytes and when an attempt ends without completing. It only
+ * ever trails the file: on load destPath is truncated to the recorded
+ * length, which drops bytes written after the last checkpoint.
+ *
+ * One instance serves one attempt and is used from the transfer thread
+ * only.
+ */
+class DownloadResume {
+public:
+  static constexpr int64_t kCheckpointBytes = 4 * 1024 * 1024;
+
+  static std::string sidecarPath(const std::string& destPath);
+
+  /** Load the checkpoint for `url` -> `destPath`, if there is a usable one. */
+  DownloadResume(std::string url, std::string destPath);
+
+  DownloadResume(const DownloadResume&) = delete;
+  DownloadResume& operator=(const DownloadResume&) = delete;
+
+  /** Bytes already in destPath that the request asks the server to skip. */
+  int64_t offset() const { return offset_; }
+
+  /**
+   * Request headers: identity encoding, so offsets count the bytes that
+   * land in the file, plus Range and If-Range when continuing.
+   */
+  std::vector<std::pair<std::string, std::string>> requestHeaders() const;
+
+  /**
+   * Check the response and return where writing starts: offset() when the
+   * server sent the requested range, 0 when it sent the whole body. Other
+   * statuses return -1; a 416 also drops the checkpoint so the next
+   * attempt starts over. Throws std::runtime_error with
+   * "[DOWNLOAD_FAILED] ..." when a 206 does not start at offset().
+   */
+  int64_t onResponse(int status, const std::string& contentRange,
+                     const std::string& etag, const std::string& lastModified);
+
+  /**
+   * Pass the bytes before offset() to `sink`, e.g. to catch up a hasher
+   * attached to the download. Throws std::runtime_error on I/O errors.
+   */
+  void readPrefix(const std::function<void(const uint8_t*, size_t)>& sink) const;
+
+  /** Count bytes appended to destPath, checkpointing periodically. */
+  void advance(size_t bytes);
+
+  /** Record the current position; the attempt is ending incomplete. */
+  void save();
+
+  /** Remove the checkpoint; destPath is complete. */
+  void finish();
+
+private:
+  std::string validator() const { return ifRangeValidator(etag_, lastModified_); }
+  void write();
+  void discard();
+
+  const std::string url_;
+  const std::string destPath_;
+  std::string etag_;
+  std::string lastModified_;
+  int64_t offset_{0};
+  int64_t committed_{0};
+  int64_t saved_{0};
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,134 @@
+#include "DownloadScheduler.h"
+#include <algorithm>
+#include <cctype>
+
+namespace bufferedblob {
+
+DownloadScheduler& DownloadScheduler::shared() {
+  static DownloadScheduler instance;
+  return instance;
+}
+
+std::string DownloadScheduler::hostKey(const std::string& url) {
+  size_t scheme = url.find("://");
+  if (scheme == std::string::npos) return url;
+  size_t start = scheme + 3;
+  size_t end = url.find_first_of("/?#", start);
+  if (end == std::string::npos) end = url.size();
+  size_t at = url.rfind('@', end);
+  if (at != std::string::npos && at >= start) start = at + 1;
+  std::string host = url.substr(start, end - start);
+  std::transform(host.begin(), host.end(), host.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return host;
+}
+
+void DownloadScheduler::setLimits(int maxConcurrent, int maxPerHost) {
+  std::vector<std::function<void()>> starts;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxConcurrent_ = std::max(maxConcurrent, 1);
+    maxPerHost_ = std::max(maxPerHost, 1);
+    takeReadyLocked(starts);
+  }
+  runAll(starts);
+}
+
+void DownloadScheduler::submit(int handleId, std::string host, DownloadPriority priority,
+                               std::function<void()> start,
+                               std::function<void()> onCancelled) {
+  std::vector<std::function<void()>> starts;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QueueKey key{-static_cast<int>(priority), nextSequence_++};
+    queue_.emplace(key, Job{handleId, std::move(host), Clock::now(), std::move(start),
+                            std::move(onCancelled)});
+    queuedKeys_[handleId] = key;
+    takeReadyLocked(starts);
+  }
+  runAll(starts);
+}
+
+bool DownloadScheduler::cancel(int handleId) {
+  std::function<void()> onCancelled;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queuedKeys_.find(handleId);
+    if (it == queuedKeys_.end()) return false;
+    auto job = queue_.find(it->second);
+    onCancelled = std::move(job->second.onCancelled);
+    queue_.erase(job);
+    queuedKeys_.erase(it);
+    ++cancelledWhileQueued_;
+  }
+  if (onCancelled) onCancelled();
+  return true;
+}
+
+bool DownloadScheduler::setPriority(int handleId, DownloadPriority priority) {
+  std::vector<std::function<void()>> starts;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queuedKeys_.find(handleId);
+    if (it == queuedKeys_.end()) return false;
+    int rank = -static_cast<int>(priority);
+    if (it->second.first == rank) return true;
+    // Keeps its place in line relative to jobs submitted before and after it.
+    auto node = queue_.extract(it->second);
+    node.key().first = rank;
+    it->second = node.key();
+    queue_.insert(std::move(node));
+    takeReadyLocked(starts);
+  }
+  runAll(starts);
+  return true;
+}
+
+void DownloadScheduler::release(int handleId) {
+  std::vector<std::function<void()>> starts;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = running_.find(handleId);
+    if (it == running_.end()) return;
+    auto host = runningPerHost_.find(it->second);
+    if (--host->second == 0) runningPerHost_.erase(host);
+    running_.erase(it);
+    takeReadyLocked(starts);
+  }
+  runAll(starts);
+}
+
+DownloadScheduler::Stats DownloadScheduler::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Stats{running_.size(), queue_.size(), started_, cancelledWhileQueued_,
+               totalWaitMs_, maxWaitMs_, maxConcurrent_, maxPerHost_};
+}
+
+void DownloadScheduler::takeReadyLocked(std::vector<std::function<void()>>& out) {
+  auto now = Clock::now();
+  for (auto it = queue_.begin();
+       it != queue_.end() && running_.size() < static_cast<size_t>(maxConcurrent_);) {
+    Job& job = it->second;
+    auto host = runningPerHost_.find(job.host);
+    if (host != runningPerHost_.end() && host->second >= maxPerHost_) {
+      ++it;
+      continue;
+    }
+    uint64_t waitMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - job.queuedAt).count());
+    totalWaitMs_ += waitMs;
+    maxWaitMs_ = std::max(maxWaitMs_, waitMs);
+    ++started_;
+    ++runningPerHost_[job.host];
+    running_.emplace(job.handleId, std::move(job.host));
+    queuedKeys_.erase(job.handleId);
+    out.push_back(std::move(job.start));
+    it = queue_.erase(it);
+  }
+}
+
+void DownloadScheduler::runAll(std::vector<std::function<void()>>& starts) {
+  for (auto& start : starts) start();
+}
+
+} // namespace bufferedblob
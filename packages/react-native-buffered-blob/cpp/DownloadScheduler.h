@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bufferedblob {
+
+enum class DownloadPriority : int { Low = 0, Normal = 1, High = 2 };
+
+/**
+ * Process-wide admission control for downloads.
+ *
+ * submit() queues a download's start callback; it runs once fewer than
+ * maxConcurrent downloads are running in total and fewer than maxPerHost
+ * against its host. Queued jobs start highest priority first, FIFO within
+ * a priority; a job whose host is at its limit does not hold back jobs for
+ * other hosts. Every started job must be release()d when its transfer
+ * ends, which starts whatever it was holding back.
+ *
+ * Callbacks run outside the scheduler lock, on the thread that submitted,
+ * released or cancelled. Start callbacks should only kick off the
+ * transfer, not block.
+ */
+class DownloadScheduler {
+public:
+  static constexpr int kDefaultMaxConcurrent = 6;
+  static constexpr int kDefaultMaxPerHost = 4;
+
+  struct Stats {
+    size_t running;
+    size_t queued;
+    uint64_t started;
+    uint64_t cancelledWhileQueued;
+    /** Time started jobs spent queued: total, and the longest single wait. */
+    uint64_t totalWaitMs;
+    uint64_t maxWaitMs;
+    int maxConcurrent;
+    int maxPerHost;
+  };
+
+  static DownloadScheduler& shared();
+
+  /**
+   * Scheme-less "host[:port]" of an absolute URL, lowercased; the URL
+   * itself when it has no authority.
+   */
+  static std::string hostKey(const std::string& url);
+
+  /** Both limits must be >= 1. Raising them starts queued jobs. */
+  void setLimits(int maxConcurrent, int maxPerHost);
+
+  /**
+   * Queue a download. `start` runs when a slot is free, possibly before
+   * submit() returns; `onCancelled` runs instead if cancel() removes the
+   * job while it is still queued.
+   */
+  void submit(int handleId, std::string host, DownloadPriority priority,
+              std::function<void()> start, std::function<void()> onCancelled);
+
+  /**
+   * Drop a queued job without starting it. Returns false if the job is
+   * not queued (already started, finished or unknown).
+   */
+  bool cancel(int handleId);
+
+  /** Move a queued job to another priority class. False if not queued. */
+  bool setPriority(int handleId, DownloadPriority priority);
+
+  /** The job's transfer ended; frees its slot. Safe to call twice. */
+  void release(int handleId);
+
+  Stats stats() const;
+
+private:
+  DownloadScheduler() = default;
+
+  using Clock = std::chrono::steady_clock;
+  // Higher priority first, then submission order.
+  using QueueKey = std::pair<int, uint64_t>;
+
+  struct Job {
+    int handleId;
+    std::string host;
+    Clock::time_point queuedAt;
+    std::function<void()> start;
+    std::function<void()> onCancelled;
+  };
+
+  /** Move startable jobs from the queue to `out`, counting them as running. */
+  void takeReadyLocked(std::vector<std::function<void()>>& out);
+  static void runAll(std::vector<std::function<void()>>& starts);
+
+  mutable std::mutex mutex_;
+  std::map<QueueKey, Job> queue_;
+  std::unordered_map<int, QueueKey> queuedKeys_;
+  // Running handle -> host.
+  std::unordered_map<int, std::string> running_;
+  std::unordered_map<std::string, int> runningPerHost_;
+  uint64_t nextSequence_{0};
+  int maxConcurrent_{kDefaultMaxConcurrent};
+  int maxPerHost_{kDefaultMaxPerHost};
+
+  uint64_t started_{0};
+  uint64_t cancelledWhileQueued_{0};
+  uint64_t totalWaitMs_{0};
+  uint64_t maxWaitMs_{0};
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,134 @@
+#include "DownloadStream.h"
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace bufferedblob {
+
+DownloadStream::DownloadStream(size_t maxBufferedBytes)
+    : maxBufferedBytes_(maxBufferedBytes) {}
+
+bool DownloadStream::push(const uint8_t* data, size_t size) {
+  if (size == 0) return true;
+  ChunkBuffer chunk(size);
+  std::memcpy(chunk.data(), data, size);
+  chunk.setSize(size);
+  return push(std::move(chunk));
+}
+
+bool DownloadStream::push(ChunkBuffer chunk) {
+  size_t size = chunk.size();
+  if (size == 0) return true;
+  std::function<void()> completion;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    spaceAvailable_.wait(lock, [this] {
+      return closed_ || chunks_.empty() || bufferedBytes_ < maxBufferedBytes_;
+    });
+    if (closed_) return false;
+    bufferedBytes_ += size;
+    chunks_.push_back(std::move(chunk));
+    if (hasWaiter_) {
+      hasWaiter_ = false;
+      deliverLocked(waiter_, completion);
+    }
+  }
+  if (completion) completion();
+  return true;
+}
+
+void DownloadStream::finish() {
+  std::function<void()> completion;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) return;
+    finished_ = true;
+    if (hasWaiter_) {
+      hasWaiter_ = false;
+      deliverLocked(waiter_, completion);
+    }
+  }
+  if (completion) completion();
+}
+
+void DownloadStream::fail(std::string error) {
+  std::function<void()> completion;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) return;
+    finished_ = true;
+    error_ = std::move(error);
+    if (hasWaiter_) {
+      hasWaiter_ = false;
+      deliverLocked(waiter_, completion);
+    }
+  }
+  if (completion) completion();
+}
+
+void DownloadStream::close() {
+  std::function<void()> completion;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    chunks_.clear();
+    bufferedBytes_ = 0;
+    if (hasWaiter_) {
+      hasWaiter_ = false;
+      deliverLocked(waiter_, completion);
+    }
+  }
+  spaceAvailable_.notify_all();
+  if (completion) completion();
+}
+
+void DownloadStream::read(std::function<void(ChunkBuffer)> onChunk,
+                          std::function<void()> onEOF,
+                          std::function<void(std::string)> onError) {
+  PendingRead read{std::move(onChunk), std::move(onEOF), std::move(onError)};
+  std::function<void()> completion;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hasWaiter_) {
+      completion = [onError = std::move(read.onError)] {
+        onError("[INVALID_ARGUMENT] A read is already pending on this download");
+      };
+    } else if (!deliverLocked(read, completion)) {
+      hasWaiter_ = true;
+      waiter_ = std::move(read);
+      return;
+    }
+  }
+  completion();
+}
+
+bool DownloadStream::deliverLocked(PendingRead& read, std::function<void()>& completion) {
+  if (closed_) {
+    completion = [onError = std::move(read.onError)] {
+      onError("[READER_CLOSED] Download stream is closed");
+    };
+    return true;
+  }
+  if (!chunks_.empty()) {
+    auto chunk = std::make_shared<ChunkBuffer>(std::move(chunks_.front()));
+    chunks_.pop_front();
+    bufferedBytes_ -= chunk->size();
+    bytesRead_.fetch_add(static_cast<int64_t>(chunk->size()), std::memory_order_relaxed);
+    completion = [onChunk = std::move(read.onChunk), chunk] {
+      onChunk(std::move(*chunk));
+    };
+    // Room for the transfer again.
+    spaceAvailable_.notify_one();
+    return true;
+  }
+  if (!finished_) return false;
+  if (!error_.empty()) {
+    completion = [onError = std::move(read.onError), error = error_] { onError(error); };
+  } else {
+    isEOF_.store(true, std::memory_order_relaxed);
+    completion = std::move(read.onEOF);
+  }
+  return true;
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ChunkBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace bufferedblob {
+
+/**
+ * Bounded queue between a download's transfer loop and a JS reader.
+ *
+ * The transfer push()es every received buffer; the reader takes them
+ * with read() in arrival order. Once more than `maxBufferedBytes` are
+ * waiting, push() blocks the transfer thread until the reader catches up,
+ * which stops the transfer from draining the socket. A single push is
+ * always accepted into an empty queue, so oversized buffers cannot stall.
+ *
+ * finish() and fail() end the stream after the queued chunks; close()
+ * abandons it from the reader's side, dropping queued chunks and making
+ * push() return false so the transfer can stop.
+ */
+class DownloadStream {
+public:
+  static constexpr size_t kDefaultMaxBufferedBytes = 1024 * 1024;
+
+  explicit DownloadStream(size_t maxBufferedBytes);
+
+  DownloadStream(const DownloadStream&) = delete;
+  DownloadStream& operator=(const DownloadStream&) = delete;
+
+  /** Queue a chunk. Returns false once the reader closed. */
+  bool push(ChunkBuffer chunk);
+
+  /** Queue a copy of the bytes. Returns false once the reader closed. */
+  bool push(const uint8_t* data, size_t size);
+
+  /** The body is complete; read() reports EOF after the queued chunks. */
+  void finish();
+
+  /** The transfer failed; read() reports `error` after the queued chunks. */
+  void fail(std::string error);
+
+  /** Stop reading: drop queued chunks and wake a blocked push(). */
+  void close();
+
+  /**
+   * Deliver the next chunk, EOF or error; immediately when one is ready,
+   * otherwise on the transfer thread once it arrives. One read at a time.
+   */
+  void read(std::function<void(ChunkBuffer)> onChunk,
+            std::function<void()> onEOF,
+            std::function<void(std::string)> onError);
+
+  int64_t bytesRead() const { return bytesRead_.load(std::memory_order_relaxed); }
+  bool isEOF() const { return isEOF_.load(std::memory_order_relaxed); }
+
+private:
+  struct PendingRead {
+    std::function<void(ChunkBuffer)> onChunk;
+    std::function<void()> onEOF;
+    std::function<void(std::string)> onError;
+  };
+
+  /** Complete `read` from the queue or the final state, if possible. */
+  bool deliverLocked(PendingRead& read, std::function<void()>& completion);
+
+  const size_t maxBufferedBytes_;
+  std::mutex mutex_;
+  std::condition_variable spaceAvailable_;
+  std::deque<ChunkBuffer> chunks_;
+  size_t bufferedBytes_{0};
+  bool finished_{false};
+  bool closed_{false};
+  std::string error_;
+  bool hasWaiter_{false};
+  PendingRead waiter_;
+
+  std::atomic<int64_t> bytesRead_{0};
+  std::atomic<bool> isEOF_{false};
+};
+
+} // namespace bufferedblob
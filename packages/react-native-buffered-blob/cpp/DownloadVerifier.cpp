@@ -0,0 +1,62 @@
+#include "DownloadVerifier.h"
+#include <cctype>
+#include <cerrno>
+#include <stdexcept>
+#include <unistd.h>
+#include <utility>
+
+namespace bufferedblob {
+
+namespace {
+
+std::string toLower(std::string value) {
+  for (char& c : value) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  return value;
+}
+
+} // namespace
+
+DownloadVerifier::DownloadVerifier(std::string destPath, const std::string& algorithm,
+                                   std::string expectedDigest, int64_t expectedSize)
+    : destPath_(std::move(destPath)),
+      algorithm_(algorithm),
+      expectedDigest_(toLower(std::move(expectedDigest))),
+      expectedSize_(expectedSize) {
+  if (!algorithm_.empty()) {
+    if (!Hasher::isSupported(algorithm_)) {
+      throw std::invalid_argument(
+          "[INVALID_ARGUMENT] Unsupported hash algorithm: " + algorithm_);
+    }
+    hasher_ = Hasher::create(algorithm_);
+  }
+}
+
+void DownloadVerifier::update(const uint8_t* data, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (verified_) return;
+  if (hasher_) hasher_->update(data, size);
+  received_ += static_cast<int64_t>(size);
+}
+
+std::string DownloadVerifier::verify() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (verified_) return result_;
+  verified_ = true;
+  if (expectedSize_ >= 0 && received_ != expectedSize_) {
+    result_ = "[INTEGRITY_MISMATCH] Expected " + std::to_string(expectedSize_) +
+              " bytes, received " + std::to_string(received_);
+  } else if (hasher_) {
+    std::string actual = toHex(hasher_->digest());
+    if (actual != expectedDigest_) {
+      result_ = "[INTEGRITY_MISMATCH] Expected " + algorithm_ + " " + expectedDigest_ +
+                ", got " + actual;
+    }
+  }
+  if (!result_.empty() && !destPath_.empty() &&
+      ::unlink(destPath_.c_str()) != 0 && errno != ENOENT) {
+    result_ += " (could not remove " + destPath_ + ")";
+  }
+  return result_;
+}
+
+} // namespace bufferedblob
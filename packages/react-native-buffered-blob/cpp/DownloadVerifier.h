@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Hasher.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace bufferedblob {
+
+/**
+ * Integrity check for one download, fed the same bytes as an attached
+ * hasher (see NativeHandleRegistry::downloadHasher), so the body is
+ * hashed while it is written instead of read back afterwards.
+ *
+ * verify() runs once the transfer has completed. On a mismatch it removes
+ * the destination before the download settles, so callers never observe
+ * a finished file with the wrong content.
+ */
+class DownloadVerifier {
+public:
+  /**
+   * `algorithm` may be empty to check only the size; `expectedSize` may
+   * be -1 to check only the digest. Throws std::invalid_argument with
+   * "[INVALID_ARGUMENT] ..." for unknown algorithms.
+   */
+  DownloadVerifier(std::string destPath, const std::string& algorithm,
+                   std::string expectedDigest, int64_t expectedSize);
+
+  DownloadVerifier(const DownloadVerifier&) = delete;
+  DownloadVerifier& operator=(const DownloadVerifier&) = delete;
+
+  void update(const uint8_t* data, size_t size);
+
+  /**
+   * Compare what was received with the expectations. Returns an empty
+   * string on a match; otherwise unlinks the destination (when there is
+   * one) and returns "[INTEGRITY_MISMATCH] ...". Later calls repeat the
+   * first result; updates after it are dropped.
+   */
+  std::string verify();
+
+private:
+  const std::string destPath_;
+  const std::string algorithm_;
+  const std::string expectedDigest_;
+  const int64_t expectedSize_;
+
+  std::mutex mutex_;
+  std::unique_ptr<Hasher> hasher_;
+  int64_t received_{0};
+  bool verified_{false};
+  std::string result_;
+};
+
+} // namespace bufferedblob
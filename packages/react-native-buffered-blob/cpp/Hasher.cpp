@@ -0,0 +1,99 @@
+#include "Hasher.h"
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__) && defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#endif
+
+namespace bufferedblob {
+
+std::unique_ptr<Hasher> Hasher::create(const std::string& algorithm) {
+  if (algorithm == "sha256") return createSha256Hasher();
+  if (algorithm == "md5") return createMd5Hasher();
+  if (algorithm == "xxh3") return createXxh3Hasher();
+  if (algorithm == "crc32c") return createCrc32cHasher();
+  if (algorithm == "blake3") return createBlake3Hasher();
+  throw std::invalid_argument(
+      "[INVALID_ARGUMENT] Unsupported hash algorithm: " + algorithm);
+}
+
+bool Hasher::isSupported(const std::string& algorithm) {
+  return algorithm == "sha256" || algorithm == "md5" ||
+         algorithm == "xxh3" || algorithm == "crc32c" ||
+         algorithm == "blake3";
+}
+
+std::string toHex(const std::vector<uint8_t>& bytes) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(bytes.size() * 2);
+  for (uint8_t byte : bytes) {
+    hex.push_back(kDigits[byte >> 4]);
+    hex.push_back(kDigits[byte & 0x0f]);
+  }
+  return hex;
+}
+
+// --- CPU features ---
+
+namespace {
+
+struct CpuFeatures {
+  bool sha256 = false;
+  bool crc32c = false;
+};
+
+CpuFeatures detectCpuFeatures() {
+  CpuFeatures features;
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    bool ssse3 = (ecx & (1u << 9)) != 0;
+    bool sse41 = (ecx & (1u << 19)) != 0;
+    features.crc32c = (ecx & (1u << 20)) != 0; // SSE4.2
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+      features.sha256 = ssse3 && sse41 && (ebx & (1u << 29)) != 0;
+    }
+  }
+#elif defined(__aarch64__) && defined(__APPLE__)
+  // Every arm64 Apple CPU has the SHA2 extension; CRC32 is reported.
+  features.sha256 = true;
+  int value = 0;
+  size_t size = sizeof(value);
+  if (sysctlbyname("hw.optional.armv8_crc32", &value, &size, nullptr, 0) == 0) {
+    features.crc32c = value != 0;
+  }
+#elif defined(__aarch64__) && defined(__linux__)
+  unsigned long hwcap = getauxval(AT_HWCAP);
+  features.sha256 = (hwcap & HWCAP_SHA2) != 0;
+  features.crc32c = (hwcap & HWCAP_CRC32) != 0;
+#endif
+  return features;
+}
+
+const CpuFeatures& cpuFeatures() {
+  static const CpuFeatures features = detectCpuFeatures();
+  return features;
+}
+
+} // namespace
+
+bool cpuHasSha256Instructions() {
+  return cpuFeatures().sha256;
+}
+
+bool cpuHasCrc32cInstructions() {
+  return cpuFeatures().crc32c;
+}
+
+} // namespace bufferedblob
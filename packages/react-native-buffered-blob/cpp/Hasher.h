@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * Incremental hash function shared by both platforms.
+ *
+ * Supported algorithms:
+ *   sha256  - SHA-NI (x86) / ARMv8 SHA2 instructions, portable fallback
+ *   md5     - portable
+ *   xxh3    - XXH3 64-bit, SSE2 / NEON accumulators
+ *   crc32c  - SSE4.2 / ARMv8 CRC32 instructions, slicing-by-8 fallback
+ *   blake3  - portable, 256-bit output
+ *
+ * Hardware paths are chosen at runtime, so a build runs on any CPU of its
+ * architecture. Digests are returned in the conventional byte order of
+ * each algorithm (big-endian for xxh3 and crc32c).
+ */
+class Hasher {
+public:
+  virtual ~Hasher() = default;
+
+  virtual void update(const uint8_t* data, size_t size) = 0;
+
+  /** Finish and return the digest. Do not call update() afterwards. */
+  virtual std::vector<uint8_t> digest() = 0;
+
+  /** Throws std::invalid_argument for unknown algorithm names. */
+  static std::unique_ptr<Hasher> create(const std::string& algorithm);
+
+  static bool isSupported(const std::string& algorithm);
+};
+
+std::string toHex(const std::vector<uint8_t>& bytes);
+
+/**
+ * Unfinalized root of a BLAKE3 subtree: the inputs of its last
+ * compression, which runs with ROOT only if it turns out to be the root.
+ */
+struct Blake3Node {
+  uint32_t cv[8];
+  uint8_t block[64];
+  uint8_t blockLength;
+  uint64_t counter;
+  uint32_t flags;
+};
+
+/**
+ * BLAKE3 over one range of a larger input, for hashing ranges in
+ * parallel. The range must start at chunk (1KB) index `firstChunk`, and
+ * every range but the last must hold the same power-of-two number of
+ * chunks, aligned to that size.
+ */
+class Blake3RangeHasher : public Hasher {
+public:
+  virtual Blake3Node node() = 0;
+};
+
+std::unique_ptr<Blake3RangeHasher> createBlake3RangeHasher(uint64_t firstChunk);
+
+/** 32-byte chaining value of a complete range's subtree. */
+std::vector<uint8_t> blake3ChainingValue(const Blake3Node& node);
+
+/** Combine range nodes (in order) into the BLAKE3 hash of the whole input. */
+std::vector<uint8_t> blake3CombineRanges(const std::vector<Blake3Node>& ranges);
+
+// Per-algorithm factories (one translation unit each).
+std::unique_ptr<Hasher> createSha256Hasher();
+std::unique_ptr<Hasher> createMd5Hasher();
+std::unique_ptr<Hasher> createXxh3Hasher();
+std::unique_ptr<Hasher> createCrc32cHasher();
+std::unique_ptr<Hasher> createBlake3Hasher();
+
+// Runtime CPU feature detection for the accelerated paths.
+bool cpuHasSha256Instructions();
+bool cpuHasCrc32cInstructions();
+
+} // namespace bufferedblob
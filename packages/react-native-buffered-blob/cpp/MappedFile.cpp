@@ -0,0 +1,33 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+
+namespace bufferedblob {
+
+namespace {
+// Stand-in address for zero-length mappings, which mmap rejects.
+uint8_t kEmpty = 0;
+} // namespace
+
+MappedFile::MappedFile(int fd, size_t size) : size_(size) {
+  if (size == 0) return;
+  void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error(
+        std::string("[IO_ERROR] mmap failed: ") + std::strerror(errno));
+  }
+  addr_ = addr;
+}
+
+MappedFile::~MappedFile() {
+  if (addr_) ::munmap(addr_, size_);
+}
+
+uint8_t* MappedFile::data() const {
+  return addr_ ? static_cast<uint8_t*>(addr_) : &kEmpty;
+}
+
+} // namespace bufferedblob
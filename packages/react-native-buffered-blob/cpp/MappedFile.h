@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace bufferedblob {
+
+/**
+ * Read-only view of a whole file mapped with mmap.
+ *
+ * Always held through a shared_ptr: the mapping handle in
+ * NativeHandleRegistry and every ArrayBuffer slice handed to JS keep a
+ * reference, and the region is unmapped when the last one goes away.
+ *
+ * The mapping is MAP_PRIVATE and writable, so JS writes into a slice are
+ * copy-on-write and never reach the file. Truncating the file while it is
+ * mapped makes access to the lost pages fault; use this for read-mostly
+ * assets.
+ */
+class MappedFile {
+public:
+  /** Map `size` bytes of `fd`. Does not take ownership of `fd`. */
+  MappedFile(int fd, size_t size);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /** Start of the mapping; never null, even for an empty file. */
+  uint8_t* data() const;
+  size_t size() const { return size_; }
+
+private:
+  void* addr_{nullptr};
+  size_t size_{0};
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,120 @@
+#include "Hasher.h"
+#include <algorithm>
+#include <cstring>
+
+namespace bufferedblob {
+
+namespace {
+
+const uint32_t kK[64] = {
+  0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+  0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+  0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+  0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+  0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+  0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+  0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+  0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
+};
+
+const int kShift[64] = {
+  7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+  5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+  4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+  6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21,
+};
+
+inline uint32_t rotl(uint32_t x, int n) {
+  return (x << n) | (x >> (32 - n));
+}
+
+inline uint32_t loadLE32(const uint8_t* p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) |
+         (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+void blocks(uint32_t state[4], const uint8_t* data, size_t count) {
+  uint32_t m[16];
+  while (count--) {
+    for (int i = 0; i < 16; ++i) m[i] = loadLE32(data + i * 4);
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    auto step = [&](uint32_t f, int i, int g) {
+      uint32_t next = d;
+      d = c;
+      c = b;
+      b = b + rotl(a + f + kK[i] + m[g], kShift[i]);
+      a = next;
+    };
+#pragma GCC unroll 16
+    for (int i = 0; i < 16; ++i) step((b & c) | (~b & d), i, i);
+#pragma GCC unroll 16
+    for (int i = 16; i < 32; ++i) step((d & b) | (~d & c), i, (5 * i + 1) & 15);
+#pragma GCC unroll 16
+    for (int i = 32; i < 48; ++i) step(b ^ c ^ d, i, (3 * i + 5) & 15);
+#pragma GCC unroll 16
+    for (int i = 48; i < 64; ++i) step(c ^ (b | ~d), i, (7 * i) & 15);
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    data += 64;
+  }
+}
+
+class Md5Hasher : public Hasher {
+public:
+  void update(const uint8_t* data, size_t size) override {
+    totalBytes_ += size;
+    if (bufferedSize_ > 0) {
+      size_t take = std::min(size, sizeof(buffer_) - bufferedSize_);
+      std::memcpy(buffer_ + bufferedSize_, data, take);
+      bufferedSize_ += take;
+      data += take;
+      size -= take;
+      if (bufferedSize_ < sizeof(buffer_)) return;
+      blocks(state_, buffer_, 1);
+      bufferedSize_ = 0;
+    }
+    if (size >= 64) {
+      size_t count = size / 64;
+      blocks(state_, data, count);
+      data += count * 64;
+      size -= count * 64;
+    }
+    std::memcpy(buffer_, data, size);
+    bufferedSize_ = size;
+  }
+
+  std::vector<uint8_t> digest() override {
+    uint64_t bitLength = totalBytes_ * 8;
+    uint8_t padding[72] = {0x80};
+    size_t padLength = (bufferedSize_ < 56 ? 56 : 120) - bufferedSize_;
+#pragma GCC unroll 16
+    for (int i = 0; i < 8; ++i) {
+      padding[padLength + i] = static_cast<uint8_t>(bitLength >> (i * 8));
+    }
+    update(padding, padLength + 8);
+
+    std::vector<uint8_t> out(16);
+#pragma GCC unroll 16
+    for (int i = 0; i < 4; ++i) {
+      out[i * 4] = static_cast<uint8_t>(state_[i]);
+      out[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 8);
+      out[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 16);
+      out[i * 4 + 3] = static_cast<uint8_t>(state_[i] >> 24);
+    }
+    return out;
+  }
+
+private:
+  uint32_t state_[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+  uint8_t buffer_[64];
+  size_t bufferedSize_ = 0;
+  uint64_t totalBytes_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<Hasher> createMd5Hasher() {
+  return std::make_unique<Md5Hasher>();
+}
+
+} // namespace bufferedblob
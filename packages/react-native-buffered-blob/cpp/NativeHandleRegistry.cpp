@@ -0,0 +1,406 @@
+#include "NativeHandleRegistry.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace bufferedblob {
+
+namespace {
+
+std::string errnoMessage(int err) {
+  return std::string(std::strerror(err));
+}
+
+// Equivalent of File.mkdirs() / createDirectoryAtPath:withIntermediateDirectories:
+void makeParentDirectories(const std::string& path) {
+  auto slash = path.find_last_of('/');
+  if (slash == std::string::npos || slash == 0) return;
+  std::string dir = path.substr(0, slash);
+
+  for (size_t pos = 1; pos <= dir.size(); ++pos) {
+    if (pos != dir.size() && dir[pos] != '/') continue;
+    std::string prefix = dir.substr(0, pos);
+    if (::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+      throw std::runtime_error(
+          "[IO_ERROR] Failed to create directory: " + prefix);
+    }
+  }
+}
+
+// Download hasher that also feeds the download's verifier. Transfers only
+// ever update() it; the attached hasher is digested through its own handle.
+class VerifyingHasher : public Hasher {
+public:
+  VerifyingHasher(std::shared_ptr<DownloadVerifier> verifier,
+                  std::shared_ptr<NativeHasherHandle> hasher)
+      : verifier_(std::move(verifier)), hasher_(std::move(hasher)) {}
+
+  void update(const uint8_t* data, size_t size) override {
+    verifier_->update(data, size);
+    if (hasher_) hasher_->update(data, size);
+  }
+
+  std::vector<uint8_t> digest() override { return {}; }
+
+private:
+  std::shared_ptr<DownloadVerifier> verifier_;
+  std::shared_ptr<NativeHasherHandle> hasher_;
+};
+
+} // namespace
+
+int openRegularFile(const std::string& path, int64_t& fileSize) {
+  int fd;
+  do {
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    int err = errno;
+    if (err == ENOENT) {
+      throw std::runtime_error("[FILE_NOT_FOUND] File does not exist: " + path);
+    }
+    if (err == EACCES || err == EPERM) {
+      throw std::runtime_error("[PERMISSION_DENIED] " + errnoMessage(err) + ": " + path);
+    }
+    throw std::runtime_error("[IO_ERROR] " + errnoMessage(err) + ": " + path);
+  }
+
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    int err = errno;
+    ::close(fd);
+    throw std::runtime_error("[IO_ERROR] " + errnoMessage(err) + ": " + path);
+  }
+  if (!S_ISREG(st.st_mode)) {
+    ::close(fd);
+    throw std::runtime_error("[INVALID_ARGUMENT] Path is not a file: " + path);
+  }
+
+  fileSize = static_cast<int64_t>(st.st_size);
+  return fd;
+}
+
+// --- Handles ---
+
+NativeHasherHandle::NativeHasherHandle(std::unique_ptr<Hasher> hasher)
+    : hasher_(std::move(hasher)) {}
+
+bool NativeHasherHandle::update(const uint8_t* data, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (finished_) return false;
+  hasher_->update(data, size);
+  return true;
+}
+
+std::string NativeHasherHandle::digest() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!finished_) {
+    digest_ = toHex(hasher_->digest());
+    finished_ = true;
+  }
+  return digest_;
+}
+
+NativeReaderHandle::NativeReaderHandle(int fd, size_t bufferSize, int64_t fileSize)
+    : fd(fd), bufferSize(bufferSize), fileSize(fileSize) {}
+
+NativeReaderHandle::~NativeReaderHandle() {
+  ::close(fd);
+}
+
+NativeWriterHandle::NativeWriterHandle(int fd) : fd(fd) {}
+
+NativeWriterHandle::~NativeWriterHandle() {
+  // Every task holding the handle has finished, so the trailer lands
+  // after all accepted data. A failure here has nobody to report to;
+  // flush() before close() surfaces errors for everything else.
+  if (compression.compressor) {
+    std::string error;
+    writeCompressed(fd, *compression.compressor, compression.output, nullptr, 0,
+                    Compressor::Flush::Finish, error);
+  }
+  ::close(fd);
+}
+
+// --- Registry ---
+
+NativeHandleRegistry& NativeHandleRegistry::shared() {
+  static NativeHandleRegistry instance;
+  return instance;
+}
+
+NativeHandleRegistry::~NativeHandleRegistry() {
+  for (auto& chunk : chunks_) delete[] chunk.load();
+}
+
+int NativeHandleRegistry::openRead(const std::string& path, size_t bufferSize) {
+  if (bufferSize < kMinBufferSize || bufferSize > kMaxBufferSize) {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Buffer size must be " +
+        std::to_string(kMinBufferSize) + "-" + std::to_string(kMaxBufferSize) +
+        ": " + std::to_string(bufferSize));
+  }
+
+  int64_t fileSize = 0;
+  int fd = openRegularFile(path, fileSize);
+
+  Entry entry;
+  entry.reader = std::make_shared<NativeReaderHandle>(fd, bufferSize, fileSize);
+  return insert(std::move(entry));
+}
+
+int NativeHandleRegistry::openWrite(const std::string& path, bool append) {
+  makeParentDirectories(path);
+
+  int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+  int fd;
+  do {
+    fd = ::open(path.c_str(), flags, 0644);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    int err = errno;
+    if (err == EACCES || err == EPERM) {
+      throw std::runtime_error("[PERMISSION_DENIED] " + errnoMessage(err) + ": " + path);
+    }
+    throw std::runtime_error(
+        "[FILE_NOT_FOUND] Could not open file for writing: " + path);
+  }
+
+  Entry entry;
+  entry.writer = std::make_shared<NativeWriterHandle>(fd);
+  return insert(std::move(entry));
+}
+
+int NativeHandleRegistry::openMapped(const std::string& path) {
+  int64_t fileSize = 0;
+  int fd = openRegularFile(path, fileSize);
+
+  // The mapping stays valid after the descriptor is closed.
+  std::shared_ptr<MappedFile> mapping;
+  try {
+    mapping = std::make_shared<MappedFile>(fd, static_cast<size_t>(fileSize));
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+
+  Entry entry;
+  entry.mapping = std::move(mapping);
+  return insert(std::move(entry));
+}
+
+int NativeHandleRegistry::createHasher(const std::string& algorithm) {
+  Entry entry;
+  entry.hasher = std::make_shared<NativeHasherHandle>(Hasher::create(algorithm));
+  return insert(std::move(entry));
+}
+
+void NativeHandleRegistry::attachHasher(int handleId, int hasherId) {
+  if (handleId <= 0) {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Invalid handle: " + std::to_string(handleId));
+  }
+  std::shared_ptr<NativeHasherHandle> hasher = find(hasherId).hasher;
+  if (!hasher) {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Hasher handle not found: " + std::to_string(hasherId));
+  }
+
+  if (handleId < kFirstHandleId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    downloadHashers_[handleId] = std::move(hasher);
+    return;
+  }
+  Entry entry = find(handleId);
+  if (entry.empty()) {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Handle not found: " + std::to_string(handleId));
+  }
+
+  // Take the I/O lock outside the slot lock so a slow read or write on
+  // this handle does not block lookups.
+  if (entry.reader) {
+    std::lock_guard<std::mutex> lock(entry.reader->ioMutex);
+    entry.reader->hasher = std::move(hasher);
+  } else if (entry.writer) {
+    std::lock_guard<std::mutex> lock(entry.writer->ioMutex);
+    entry.writer->hasher = std::move(hasher);
+  } else {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Hashers attach to readers, writers and downloads only");
+  }
+}
+
+int NativeHandleRegistry::insert(Entry entry) {
+  uint32_t index;
+  {
+    std::lock_guard<std::mutex> lock(allocMutex_);
+    if (!freeSlots_.empty()) {
+      index = freeSlots_.front();
+      freeSlots_.pop_front();
+    } else {
+      if (nextIndex_ == kMaxHandles) {
+        throw std::runtime_error(
+            "[IO_ERROR] Too many open handles (" + std::to_string(kMaxHandles) + ")");
+      }
+      index = nextIndex_++;
+      auto& chunk = chunks_[index / kSlotsPerChunk];
+      if (!chunk.load(std::memory_order_relaxed)) {
+        chunk.store(new Slot[kSlotsPerChunk], std::memory_order_release);
+      }
+    }
+  }
+  Slot& slot = chunks_[index / kSlotsPerChunk].load(std::memory_order_acquire)
+                   [index % kSlotsPerChunk];
+  uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+  {
+    std::lock_guard<SpinLock> lock(slot.lock);
+    slot.entry = std::move(entry);
+  }
+  return kFirstHandleId | static_cast<int>(generation << kIndexBits) |
+         static_cast<int>(index);
+}
+
+NativeHandleRegistry::Slot* NativeHandleRegistry::slotFor(int handleId) {
+  if (handleId < kFirstHandleId) return nullptr;
+  auto id = static_cast<uint32_t>(handleId);
+  uint32_t index = id & kIndexMask;
+  Slot* chunk = chunks_[index / kSlotsPerChunk].load(std::memory_order_acquire);
+  if (!chunk) return nullptr;
+  Slot* slot = &chunk[index % kSlotsPerChunk];
+  uint32_t generation = (id >> kIndexBits) & kGenerationMask;
+  if (slot->generation.load(std::memory_order_acquire) != generation) return nullptr;
+  return slot;
+}
+
+NativeHandleRegistry::Entry NativeHandleRegistry::find(int handleId) {
+  Slot* slot = slotFor(handleId);
+  if (!slot) return {};
+  uint32_t generation = (static_cast<uint32_t>(handleId) >> kIndexBits) & kGenerationMask;
+  std::lock_guard<SpinLock> lock(slot->lock);
+  // Re-check under the lock: the handle may have been removed meanwhile.
+  if (slot->generation.load(std::memory_order_relaxed) != generation) return {};
+  return slot->entry;
+}
+
+bool NativeHandleRegistry::take(int handleId, Entry& entry) {
+  Slot* slot = slotFor(handleId);
+  if (!slot) return false;
+  uint32_t generation = (static_cast<uint32_t>(handleId) >> kIndexBits) & kGenerationMask;
+  {
+    std::lock_guard<SpinLock> lock(slot->lock);
+    if (slot->generation.load(std::memory_order_relaxed) != generation ||
+        slot->entry.empty()) {
+      return false;
+    }
+    entry = std::move(slot->entry);
+    slot->entry = Entry{};
+    slot->generation.store((generation + 1) & kGenerationMask, std::memory_order_release);
+  }
+  std::lock_guard<std::mutex> lock(allocMutex_);
+  freeSlots_.push_back(static_cast<uint32_t>(handleId) & kIndexMask);
+  return true;
+}
+
+std::shared_ptr<NativeReaderHandle> NativeHandleRegistry::reader(int handleId) {
+  return find(handleId).reader;
+}
+
+std::shared_ptr<NativeWriterHandle> NativeHandleRegistry::writer(int handleId) {
+  return find(handleId).writer;
+}
+
+std::shared_ptr<MappedFile> NativeHandleRegistry::mapping(int handleId) {
+  return find(handleId).mapping;
+}
+
+std::shared_ptr<NativeHasherHandle> NativeHandleRegistry::hasher(int handleId) {
+  return find(handleId).hasher;
+}
+
+std::shared_ptr<NativeHasherHandle> NativeHandleRegistry::downloadHasher(int handleId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = downloadHashers_.find(handleId);
+  auto hasher = it == downloadHashers_.end() ? nullptr : it->second;
+  auto verifierIt = downloadVerifiers_.find(handleId);
+  if (verifierIt == downloadVerifiers_.end()) return hasher;
+  return std::make_shared<NativeHasherHandle>(
+      std::make_unique<VerifyingHasher>(verifierIt->second, std::move(hasher)));
+}
+
+void NativeHandleRegistry::attachDownloadVerifier(
+    int handleId, std::shared_ptr<DownloadVerifier> verifier) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  downloadVerifiers_[handleId] = std::move(verifier);
+}
+
+std::shared_ptr<DownloadVerifier> NativeHandleRegistry::downloadVerifier(int handleId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = downloadVerifiers_.find(handleId);
+  return it == downloadVerifiers_.end() ? nullptr : it->second;
+}
+
+void NativeHandleRegistry::attachDownloadStream(int handleId,
+                                                std::shared_ptr<DownloadStream> stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  downloadStreams_[handleId] = std::move(stream);
+}
+
+std::shared_ptr<DownloadStream> NativeHandleRegistry::downloadStream(int handleId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = downloadStreams_.find(handleId);
+  return it == downloadStreams_.end() ? nullptr : it->second;
+}
+
+bool NativeHandleRegistry::remove(int handleId) {
+  std::shared_ptr<DownloadStream> stream;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    downloadHashers_.erase(handleId);
+    downloadVerifiers_.erase(handleId);
+    auto streamIt = downloadStreams_.find(handleId);
+    if (streamIt != downloadStreams_.end()) {
+      stream = std::move(streamIt->second);
+      downloadStreams_.erase(streamIt);
+    }
+  }
+  // A transfer blocked on a full stream must not outlive its reader.
+  if (stream) stream->close();
+  Entry entry;
+  if (!take(handleId, entry)) return false;
+  // The fd itself is released once pending tasks drop their references.
+  if (entry.reader) entry.reader->isClosed = true;
+  if (entry.writer) entry.writer->isClosed = true;
+  return true;
+}
+
+void NativeHandleRegistry::clear() {
+  std::unordered_map<int, std::shared_ptr<DownloadStream>> streams;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams.swap(downloadStreams_);
+    downloadHashers_.clear();
+    downloadVerifiers_.clear();
+  }
+  for (auto& [id, stream] : streams) stream->close();
+
+  uint32_t slots;
+  {
+    std::lock_guard<std::mutex> lock(allocMutex_);
+    slots = nextIndex_;
+  }
+  for (uint32_t index = 0; index < slots; ++index) {
+    Slot& slot = chunks_[index / kSlotsPerChunk].load(std::memory_order_acquire)
+                     [index % kSlotsPerChunk];
+    uint32_t generation = slot.generation.load(std::memory_order_acquire);
+    remove(kFirstHandleId | static_cast<int>(generation << kIndexBits) |
+           static_cast<int>(index));
+  }
+}
+
+} // namespace bufferedblob
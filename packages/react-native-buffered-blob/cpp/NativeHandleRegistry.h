@@ -0,0 +1,332 @@
+#pragma once
+
+#include "ChunkBuffer.h"
+#include "Compression.h"
+#include "DownloadStream.h"
+#include "DownloadVerifier.h"
+#include "Hasher.h"
+#include "MappedFile.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * Incremental hasher handle. It can be fed from JS, or attached to a
+ * reader, writer or download so that chunks are hashed in native memory
+ * as they pass through. Thread-safe; updates after digest() are dropped.
+ */
+struct NativeHasherHandle {
+  explicit NativeHasherHandle(std::unique_ptr<Hasher> hasher);
+
+  NativeHasherHandle(const NativeHasherHandle&) = delete;
+  NativeHasherHandle& operator=(const NativeHasherHandle&) = delete;
+
+  /** Returns false if the hasher has already been digested. */
+  bool update(const uint8_t* data, size_t size);
+
+  /** Lowercase hex digest. Finalizes on the first call; later calls repeat it. */
+  std::string digest();
+
+private:
+  std::mutex mutex_;
+  std::unique_ptr<Hasher> hasher_;
+  std::string digest_;
+  bool finished_{false};
+};
+
+/**
+ * Reader handle backed by a raw file descriptor.
+ * The descriptor is closed when the last reference is released, so
+ * in-flight I/O tasks holding a reference finish before the fd goes away.
+ */
+struct NativeReaderHandle {
+  NativeReaderHandle(int fd, size_t bufferSize, int64_t fileSize);
+  ~NativeReaderHandle();
+
+  NativeReaderHandle(const NativeReaderHandle&) = delete;
+  NativeReaderHandle& operator=(const NativeReaderHandle&) = delete;
+
+  const int fd;
+  const size_t bufferSize;
+  const int64_t fileSize;
+
+  std::atomic<int64_t> bytesRead{0};
+  std::atomic<bool> isEOF{false};
+  std::atomic<bool> isClosed{false};
+
+  /** Serializes sequential reads on this handle. */
+  std::mutex ioMutex;
+
+  /** Fed every sequentially read chunk (not readAt). Guarded by ioMutex. */
+  std::shared_ptr<NativeHasherHandle> hasher;
+
+  /**
+   * Decompression stage, guarded by ioMutex. When set, sequential reads
+   * pull compressed bytes from the fd into `input` and hand out decoded
+   * chunks; bytesRead then counts decompressed bytes while fileSize stays
+   * the on-disk size.
+   */
+  struct Decompression {
+    std::unique_ptr<Decompressor> decompressor;
+    std::vector<uint8_t> input;
+    size_t inputPos{0};
+    size_t inputEnd{0};
+    bool sourceEOF{false};
+  };
+  Decompression decompression;
+
+  /**
+   * Read-ahead state, guarded by `mutex`. With depth > 0 a background fill
+   * task keeps up to `depth` chunks ready; bytesRead/isEOF above still
+   * track what has been handed to JS, not what has been prefetched.
+   */
+  struct ReadAhead {
+    struct PendingRead {
+      std::function<void(ChunkBuffer)> onSuccess;
+      std::function<void()> onEOF;
+      std::function<void(std::string)> onError;
+    };
+
+    static constexpr size_t kMaxDepth = 16;
+
+    std::mutex mutex;
+    size_t depth{0};
+    std::deque<ChunkBuffer> ready;
+    std::deque<PendingRead> waiters;
+    bool filling{false};
+    bool sourceEOF{false};
+    std::string error;
+  };
+  ReadAhead readAhead;
+};
+
+/**
+ * Writer handle backed by a raw file descriptor.
+ */
+struct NativeWriterHandle {
+  explicit NativeWriterHandle(int fd);
+  ~NativeWriterHandle();
+
+  NativeWriterHandle(const NativeWriterHandle&) = delete;
+  NativeWriterHandle& operator=(const NativeWriterHandle&) = delete;
+
+  const int fd;
+
+  std::atomic<int64_t> bytesWritten{0};
+  std::atomic<bool> isClosed{false};
+
+  /** Serializes writes on this handle. */
+  std::mutex ioMutex;
+
+  /** Fed every buffer once it is written. Guarded by ioMutex. */
+  std::shared_ptr<NativeHasherHandle> hasher;
+
+  /**
+   * Compression stage, guarded by ioMutex. Written buffers (and
+   * bytesWritten) are uncompressed; `output` stages the compressed bytes
+   * on their way to the fd. The stream is ended when the last reference
+   * to the handle is released.
+   */
+  struct Compression {
+    std::unique_ptr<Compressor> compressor;
+    std::vector<uint8_t> output;
+  };
+  Compression compression;
+
+  /**
+   * Write-behind state, guarded by `mutex`. When enabled, writes are copied
+   * into `buffer` and a single drain task per handle writes them out in
+   * large batches. Writes that push pendingBytes over highWaterMark are
+   * acknowledged only once it falls back to lowWaterMark.
+   */
+  struct WriteBehind {
+    struct PendingWrite {
+      int size;
+      std::function<void(int)> onSuccess;
+      std::function<void(std::string)> onError;
+    };
+    struct PendingFlush {
+      std::function<void()> onSuccess;
+      std::function<void(std::string)> onError;
+    };
+
+    std::mutex mutex;
+    bool enabled{false};
+    size_t highWaterMark{0};
+    size_t lowWaterMark{0};
+    std::vector<uint8_t> buffer;
+    /** Bytes accepted but not yet written: buffered plus in flight. */
+    size_t pendingBytes{0};
+    bool draining{false};
+    std::string error;
+    std::deque<PendingWrite> drainWaiters;
+    std::deque<PendingFlush> flushWaiters;
+  };
+  WriteBehind writeBehind;
+};
+
+/**
+ * Open an existing regular file read-only and return the fd and its size.
+ * Throws std::runtime_error with an "[ERROR_CODE] message" on failure.
+ */
+int openRegularFile(const std::string& path, int64_t& fileSize);
+
+/**
+ * Thread-safe process-wide registry of natively opened handles.
+ *
+ * Handles live in a slab of slots that is only ever grown, so a lookup
+ * goes straight to its slot and takes nothing but that slot's spin lock;
+ * lookups of different handles never contend. An ID packs the slot index
+ * with the slot's generation, which is bumped on remove(), so a stale ID
+ * is rejected even after its slot has been reused.
+ *
+ * IDs all have the kFirstHandleId bit set so they never collide with the
+ * IDs handed out by the platform registries (Kotlin/ObjC) for downloads,
+ * which count up from 1. Open errors are reported as std::runtime_error
+ * carrying the usual "[ERROR_CODE] message" format.
+ */
+class NativeHandleRegistry {
+public:
+  static constexpr int kFirstHandleId = 0x40000000;
+  /** Open native handles at any one time. */
+  static constexpr uint32_t kMaxHandles = 1u << 16;
+  static constexpr size_t kMinBufferSize = 4096;
+  static constexpr size_t kMaxBufferSize = 4194304; // 4MB
+
+  static NativeHandleRegistry& shared();
+
+  /** Open a file for reading. Throws std::runtime_error on failure. */
+  int openRead(const std::string& path, size_t bufferSize);
+
+  /** Open a file for writing, creating parent directories as needed. */
+  int openWrite(const std::string& path, bool append);
+
+  /** Map a whole file into memory. Throws std::runtime_error on failure. */
+  int openMapped(const std::string& path);
+
+  /** Create a hasher. Throws std::invalid_argument for unknown algorithms. */
+  int createHasher(const std::string& algorithm);
+
+  /**
+   * Feed everything that subsequently flows through `handleId` into the
+   * hasher. Native readers and writers hold it directly; any other ID is
+   * taken to be a platform download handle, which picks it up through
+   * downloadHasher() when it starts. Throws std::runtime_error if the
+   * hasher or a native handle cannot be used.
+   */
+  void attachHasher(int handleId, int hasherId);
+
+  std::shared_ptr<NativeReaderHandle> reader(int handleId);
+  std::shared_ptr<NativeWriterHandle> writer(int handleId);
+  std::shared_ptr<MappedFile> mapping(int handleId);
+  std::shared_ptr<NativeHasherHandle> hasher(int handleId);
+
+  /**
+   * Hasher a platform download's transfer feeds with the body, or null.
+   * With a verifier attached it tees into both the verifier and any
+   * attached hasher.
+   */
+  std::shared_ptr<NativeHasherHandle> downloadHasher(int handleId);
+
+  /**
+   * Check a platform download's body against `verifier` once it
+   * completes; attach before startDownload.
+   */
+  void attachDownloadVerifier(int handleId, std::shared_ptr<DownloadVerifier> verifier);
+  std::shared_ptr<DownloadVerifier> downloadVerifier(int handleId);
+
+  /**
+   * Tee a platform download's body into `stream`; the transfer picks it up
+   * through downloadStream() when it starts, and reads of `handleId` are
+   * served from it.
+   */
+  void attachDownloadStream(int handleId, std::shared_ptr<DownloadStream> stream);
+  std::shared_ptr<DownloadStream> downloadStream(int handleId);
+
+  /**
+   * Remove and close the handle. Returns false if the ID is not native
+   * (a download hasher, verifier or stream attached to it is still
+   * released).
+   */
+  bool remove(int handleId);
+
+  /** Remove and close all registered handles. */
+  void clear();
+
+private:
+  NativeHandleRegistry() = default;
+  ~NativeHandleRegistry();
+
+  struct Entry {
+    std::shared_ptr<NativeReaderHandle> reader;
+    std::shared_ptr<NativeWriterHandle> writer;
+    std::shared_ptr<MappedFile> mapping;
+    std::shared_ptr<NativeHasherHandle> hasher;
+
+    bool empty() const { return !reader && !writer && !mapping && !hasher; }
+  };
+
+  // Held only for the few instructions that copy or swap an Entry.
+  class SpinLock {
+  public:
+    void lock() {
+      while (flag_.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+    }
+    void unlock() { flag_.clear(std::memory_order_release); }
+
+  private:
+    std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+  };
+
+  struct Slot {
+    // Generation of the ID the slot currently (or next) hands out.
+    std::atomic<uint32_t> generation{0};
+    SpinLock lock;
+    Entry entry;
+  };
+
+  // ID = kFirstHandleId | generation << kIndexBits | index.
+  static constexpr int kIndexBits = 16;
+  static constexpr uint32_t kIndexMask = kMaxHandles - 1;
+  static constexpr uint32_t kGenerationMask = (1u << (30 - kIndexBits)) - 1;
+  static constexpr uint32_t kSlotsPerChunk = 1024;
+  static constexpr uint32_t kChunks = kMaxHandles / kSlotsPerChunk;
+
+  int insert(Entry entry);
+
+  /** Slot of a live-looking ID whose generation matches, or null. */
+  Slot* slotFor(int handleId);
+
+  /** Copy the entry of a live handle; empty when the ID is stale. */
+  Entry find(int handleId);
+
+  /** Take the entry out of a live handle and retire its ID. */
+  bool take(int handleId, Entry& entry);
+
+  // Slots are allocated a chunk at a time and never freed, so lookups can
+  // read chunk pointers without a lock.
+  std::array<std::atomic<Slot*>, kChunks> chunks_{};
+  // Free slot indices, oldest first so generations wrap as late as
+  // possible; guarded by allocMutex_ along with nextIndex_.
+  std::mutex allocMutex_;
+  std::deque<uint32_t> freeSlots_;
+  uint32_t nextIndex_{0};
+
+  // Attachments of platform download handles, keyed by their IDs.
+  std::mutex mutex_;
+  std::unordered_map<int, std::shared_ptr<NativeHasherHandle>> downloadHashers_;
+  std::unordered_map<int, std::shared_ptr<DownloadStream>> downloadStreams_;
+  std::unordered_map<int, std::shared_ptr<DownloadVerifier>> downloadVerifiers_;
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,223 @@
+#include "OperationStats.h"
+#include "OperationTrace.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <bit>
+
+namespace bufferedblob {
+
+namespace {
+
+int64_t nowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t micros(std::chrono::steady_clock::duration duration) {
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  return us > 0 ? static_cast<uint64_t>(us) : 0;
+}
+
+// Identifies an operation's interval to the platform tracer.
+std::atomic<uint64_t> nextCookie{1};
+
+} // namespace
+
+// --- LatencyHistogram ---
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+  micros = std::min<uint64_t>(micros, (uint64_t{1} << (kMaxMagnitude + 1)) - 1);
+  if (micros < kSubBuckets) return static_cast<size_t>(micros);
+  int magnitude = 63 - std::countl_zero(micros);
+  int shift = magnitude - kSubBucketBits;
+  uint64_t sub = (micros >> shift) & (kSubBuckets - 1);
+  return static_cast<size_t>((shift + 1) * kSubBuckets + sub);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+  if (index < kSubBuckets) return index;
+  int shift = static_cast<int>(index / kSubBuckets) - 1;
+  uint64_t sub = index % kSubBuckets;
+  return ((kSubBuckets + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+  buckets_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(micros, std::memory_order_relaxed);
+  uint64_t seen = min_.load(std::memory_order_relaxed);
+  while (micros < seen &&
+         !min_.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+  }
+  seen = max_.load(std::memory_order_relaxed);
+  while (micros > seen &&
+         !max_.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary() const {
+  // Buckets are read one by one while others may record; the summary is
+  // approximate under concurrent updates, never torn per field.
+  std::array<uint64_t, kBuckets> counts;
+  uint64_t total = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  Summary summary{};
+  summary.count = total;
+  if (total == 0) return summary;
+  summary.min = min_.load(std::memory_order_relaxed);
+  summary.max = max_.load(std::memory_order_relaxed);
+  summary.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+                 static_cast<double>(count_.load(std::memory_order_relaxed));
+
+  auto percentile = [&](double fraction) {
+    auto rank = static_cast<uint64_t>(fraction * static_cast<double>(total));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += counts[i];
+      if (seen > rank) return std::min(bucketUpperBound(i), summary.max);
+    }
+    return summary.max;
+  };
+  summary.p50 = percentile(0.5);
+  summary.p90 = percentile(0.9);
+  summary.p99 = percentile(0.99);
+  summary.p999 = percentile(0.999);
+  return summary;
+}
+
+void LatencyHistogram::reset() {
+  for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+// --- OperationStats ---
+
+OperationStats::OperationStats() : windowStart_(nowMs()) {}
+
+OperationStats& OperationStats::shared() {
+  static OperationStats instance;
+  return instance;
+}
+
+const char* OperationStats::name(StatsOperation operation) {
+  switch (operation) {
+    case StatsOperation::ReadNextChunk: return "readNextChunk";
+    case StatsOperation::ReadChunks: return "readChunks";
+    case StatsOperation::ReadAt: return "readAt";
+    case StatsOperation::Write: return "write";
+    case StatsOperation::Writev: return "writev";
+    case StatsOperation::Flush: return "flush";
+    case StatsOperation::HashFile: return "hashFile";
+    case StatsOperation::HashFileTree: return "hashFileTree";
+    case StatsOperation::Count: break;
+  }
+  return "";
+}
+
+const char* OperationStats::name(StatsPhase phase) {
+  switch (phase) {
+    case StatsPhase::Bridge: return "bridge";
+    case StatsPhase::Queue: return "queue";
+    case StatsPhase::IO: return "io";
+    case StatsPhase::Delivery: return "delivery";
+    case StatsPhase::Total: return "total";
+    case StatsPhase::Count: break;
+  }
+  return "";
+}
+
+void OperationStats::record(StatsOperation operation, StatsPhase phase, uint64_t micros) {
+  operations_[static_cast<size_t>(operation)]
+      .phases[static_cast<size_t>(phase)]
+      .record(micros);
+}
+
+void OperationStats::count(StatsOperation operation, bool ok, uint64_t bytes) {
+  auto& op = operations_[static_cast<size_t>(operation)];
+  (ok ? op.completed : op.failed).fetch_add(1, std::memory_order_relaxed);
+  if (bytes > 0) op.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+OperationStats::Counters OperationStats::counters(StatsOperation operation) const {
+  const auto& op = operations_[static_cast<size_t>(operation)];
+  return Counters{op.completed.load(std::memory_order_relaxed),
+                  op.failed.load(std::memory_order_relaxed),
+                  op.bytes.load(std::memory_order_relaxed)};
+}
+
+LatencyHistogram::Summary OperationStats::latency(StatsOperation operation,
+                                                  StatsPhase phase) const {
+  return operations_[static_cast<size_t>(operation)]
+      .phases[static_cast<size_t>(phase)]
+      .summary();
+}
+
+int64_t OperationStats::windowMs() const {
+  return nowMs() - windowStart_.load(std::memory_order_relaxed);
+}
+
+void OperationStats::reset() {
+  for (auto& op : operations_) {
+    op.completed.store(0, std::memory_order_relaxed);
+    op.failed.store(0, std::memory_order_relaxed);
+    op.bytes.store(0, std::memory_order_relaxed);
+    for (auto& phase : op.phases) phase.reset();
+  }
+  windowStart_.store(nowMs(), std::memory_order_relaxed);
+}
+
+// --- OperationTimer ---
+
+OperationTimer::OperationTimer(StatsOperation operation, int handleId)
+    : operation_(operation),
+      handleId_(handleId),
+      cookie_(nextCookie.fetch_add(1, std::memory_order_relaxed)),
+      callerThread_(currentThreadId()),
+      called_(Clock::now()) {
+  traceOperationBegin(operation_, handleId_, cookie_);
+}
+
+OperationTimer OperationTimer::completed() const {
+  OperationTimer timer = *this;
+  timer.completed_ = Clock::now();
+  timer.workerThread_ = currentThreadId();
+  // Only a task queued by this call says anything about its queue time;
+  // a read-ahead fill queued earlier does not.
+  if (const auto* task = WorkerPool::currentTask(); task && task->submitted >= called_) {
+    timer.onWorker_ = true;
+    timer.submitted_ = task->submitted;
+    timer.started_ = task->started;
+  }
+  return timer;
+}
+
+void OperationTimer::delivered(bool ok, uint64_t bytes) const {
+  auto now = Clock::now();
+  auto& stats = OperationStats::shared();
+  if (onWorker_) {
+    stats.record(operation_, StatsPhase::Bridge, micros(submitted_ - called_));
+    stats.record(operation_, StatsPhase::Queue, micros(started_ - submitted_));
+    stats.record(operation_, StatsPhase::IO, micros(completed_ - started_));
+  } else {
+    stats.record(operation_, StatsPhase::IO, micros(completed_ - called_));
+  }
+  stats.record(operation_, StatsPhase::Delivery, micros(now - completed_));
+  stats.record(operation_, StatsPhase::Total, micros(now - called_));
+  stats.count(operation_, ok, bytes);
+
+  traceOperationEnd(operation_, cookie_);
+  auto& trace = TraceRecorder::shared();
+  if (trace.enabled()) {
+    trace.record(TraceSpan{operation_, handleId_, bytes, ok, callerThread_, workerThread_,
+                           onWorker_, called_, submitted_, started_, completed_, now});
+  }
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace bufferedblob {
+
+/**
+ * Lock-free latency histogram in microseconds with HDR-style log-linear
+ * buckets: exact below 8us, then 8 buckets per power of two (about 12%
+ * resolution) up to ~19 hours. record() is a handful of relaxed atomic
+ * operations, so it can stay on in production.
+ */
+class LatencyHistogram {
+public:
+  struct Summary {
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    double mean;
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t p999;
+  };
+
+  void record(uint64_t micros);
+
+  /** Percentiles report the upper edge of their bucket, capped at max. */
+  Summary summary() const;
+
+  void reset();
+
+private:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr uint64_t kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kMaxMagnitude = 36;
+  static constexpr size_t kBuckets = (kMaxMagnitude - kSubBucketBits + 2) * kSubBuckets;
+
+  static size_t bucketIndex(uint64_t micros);
+  static uint64_t bucketUpperBound(size_t index);
+
+  std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+/** Host-object operations with statistics. */
+enum class StatsOperation : int {
+  ReadNextChunk,
+  ReadChunks,
+  ReadAt,
+  Write,
+  Writev,
+  Flush,
+  HashFile,
+  HashFileTree,
+  Count
+};
+
+/**
+ * Where an operation's time went:
+ *   bridge   - JS call until the work was queued (argument checks, lookups)
+ *   queue    - waiting for a pool worker, including earlier tasks on the
+ *              same handle
+ *   io       - running on the worker (syscalls, hashing) until the result
+ *   delivery - result posted to the JS thread until the promise settled
+ *   total    - JS call until the promise settled
+ * Results produced without a pool task (e.g. served from read-ahead)
+ * only record io (call until result), delivery and total.
+ */
+enum class StatsPhase : int { Bridge, Queue, IO, Delivery, Total, Count };
+
+/**
+ * Process-wide per-operation counters, byte totals and phase latency
+ * histograms; see OperationTimer for how operations feed it.
+ */
+class OperationStats {
+public:
+  struct Counters {
+    uint64_t completed;
+    uint64_t failed;
+    uint64_t bytes;
+  };
+
+  static OperationStats& shared();
+
+  static const char* name(StatsOperation operation);
+  static const char* name(StatsPhase phase);
+
+  void record(StatsOperation operation, StatsPhase phase, uint64_t micros);
+  void count(StatsOperation operation, bool ok, uint64_t bytes);
+
+  Counters counters(StatsOperation operation) const;
+  LatencyHistogram::Summary latency(StatsOperation operation, StatsPhase phase) const;
+
+  /** Milliseconds since the last reset (or process start). */
+  int64_t windowMs() const;
+
+  /** Start a new measurement window. */
+  void reset();
+
+private:
+  OperationStats();
+
+  static constexpr size_t kOperations = static_cast<size_t>(StatsOperation::Count);
+  static constexpr size_t kPhases = static_cast<size_t>(StatsPhase::Count);
+
+  struct PerOperation {
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> bytes{0};
+    std::array<LatencyHistogram, kPhases> phases;
+  };
+
+  std::array<PerOperation, kOperations> operations_;
+  std::atomic<int64_t> windowStart_;
+};
+
+/**
+ * Timestamps of one operation as it moves through its phases. A small
+ * value type, copied along with the callbacks:
+ *
+ *   OperationTimer timer(StatsOperation::ReadAt);  // in the JSI call
+ *   auto done = timer.completed();   // in the platform callback
+ *   done.delivered(ok, bytes);       // on the JS thread, when settling
+ *
+ * completed() picks up the pool task that produced the result (see
+ * WorkerPool::currentTask) to split queue time from I/O time. The
+ * operation also shows up in traces (see OperationTrace.h), tagged with
+ * `handleId` (-1 for path-based operations).
+ */
+class OperationTimer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit OperationTimer(StatsOperation operation, int handleId = -1);
+
+  OperationTimer completed() const;
+  void delivered(bool ok, uint64_t bytes = 0) const;
+
+private:
+  StatsOperation operation_;
+  int handleId_;
+  uint64_t cookie_;
+  uint64_t callerThread_;
+  uint64_t workerThread_{0};
+  Clock::time_point called_;
+  Clock::time_point submitted_{};
+  Clock::time_point started_{};
+  Clock::time_point completed_{};
+  bool onWorker_{false};
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,297 @@
+#include "OperationTrace.h"
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <unistd.h>
+
+#if defined(__ANDROID__)
+#include <dlfcn.h>
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+#include <os/signpost.h>
+#include <pthread.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace bufferedblob {
+
+namespace {
+
+double traceMicros(TraceSpan::Clock::time_point time) {
+  return std::chrono::duration<double, std::micro>(time.time_since_epoch()).count();
+}
+
+#if defined(__ANDROID__)
+
+// ATrace_* live in libandroid; the async variants need API 29, so all of
+// them are resolved at runtime rather than linked.
+struct ATrace {
+  bool (*isEnabled)() = nullptr;
+  void (*beginSection)(const char*) = nullptr;
+  void (*endSection)() = nullptr;
+  void (*beginAsyncSection)(const char*, int32_t) = nullptr;
+  void (*endAsyncSection)(const char*, int32_t) = nullptr;
+
+  ATrace() {
+    void* lib = ::dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+    if (!lib) return;
+    isEnabled = reinterpret_cast<bool (*)()>(::dlsym(lib, "ATrace_isEnabled"));
+    beginSection = reinterpret_cast<void (*)(const char*)>(::dlsym(lib, "ATrace_beginSection"));
+    endSection = reinterpret_cast<void (*)()>(::dlsym(lib, "ATrace_endSection"));
+    beginAsyncSection = reinterpret_cast<void (*)(const char*, int32_t)>(
+        ::dlsym(lib, "ATrace_beginAsyncSection"));
+    endAsyncSection = reinterpret_cast<void (*)(const char*, int32_t)>(
+        ::dlsym(lib, "ATrace_endAsyncSection"));
+  }
+
+  bool capturing() const { return isEnabled && isEnabled(); }
+};
+
+const ATrace& atrace() {
+  static ATrace instance;
+  return instance;
+}
+
+// Async section names must match between begin and end.
+const char* sectionName(StatsOperation operation) {
+  static const auto names = [] {
+    std::array<std::string, static_cast<size_t>(StatsOperation::Count)> names;
+    for (size_t i = 0; i < names.size(); ++i) {
+      names[i] = std::string("BufferedBlob ") +
+                 OperationStats::name(static_cast<StatsOperation>(i));
+    }
+    return names;
+  }();
+  return names[static_cast<size_t>(operation)].c_str();
+}
+
+#elif defined(__APPLE__)
+
+os_log_t signpostLog() {
+  static os_log_t log = os_log_create("com.bufferedblob", "Streaming");
+  return log;
+}
+
+#endif
+
+} // namespace
+
+// --- TraceRecorder ---
+
+TraceRecorder& TraceRecorder::shared() {
+  static TraceRecorder instance;
+  return instance;
+}
+
+void TraceRecorder::start(size_t capacity) {
+  capacity = std::clamp<size_t>(capacity, 1, kMaxCapacity);
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_.clear();
+  spans_.shrink_to_fit();
+  spans_.reserve(capacity);
+  capacity_ = capacity;
+  next_ = 0;
+  dropped_ = 0;
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::stop() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void TraceRecorder::record(const TraceSpan& span) {
+  if (!enabled()) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0) return;
+  if (spans_.size() < capacity_) {
+    spans_.push_back(span);
+  } else {
+    spans_[next_] = span;
+    ++dropped_;
+  }
+  next_ = (next_ + 1) % capacity_;
+}
+
+std::string TraceRecorder::chromeTraceJson() const {
+  std::vector<TraceSpan> spans;
+  uint64_t dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans.reserve(spans_.size());
+    // Once the ring has wrapped, the oldest span sits at next_.
+    size_t first = spans_.size() < capacity_ ? 0 : next_;
+    for (size_t i = 0; i < spans_.size(); ++i) {
+      spans.push_back(spans_[(first + i) % spans_.size()]);
+    }
+    dropped = dropped_;
+  }
+
+  auto pid = static_cast<long long>(::getpid());
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  char event[512];
+  auto append = [&](int length) {
+    if (!first) json += ',';
+    first = false;
+    json.append(event, static_cast<size_t>(std::min<int>(length, sizeof(event) - 1)));
+  };
+
+  std::set<uint64_t> callers;
+  std::set<uint64_t> workers;
+  uint64_t id = 0;
+  for (const auto& span : spans) {
+    ++id;
+    const char* name = OperationStats::name(span.operation);
+    auto caller = static_cast<unsigned long long>(span.callerThread);
+    auto worker = static_cast<unsigned long long>(span.workerThread);
+    callers.insert(span.callerThread);
+
+    // Concurrent operations overlap on the caller thread, so the
+    // operation itself is an async slice with the queue wait nested in it.
+    append(std::snprintf(
+        event, sizeof(event),
+        "{\"name\":\"%s\",\"cat\":\"bufferedblob\",\"ph\":\"b\",\"id\":%llu,"
+        "\"pid\":%lld,\"tid\":%llu,\"ts\":%.3f,"
+        "\"args\":{\"handleId\":%d,\"bytes\":%llu,\"ok\":%s}}",
+        name, static_cast<unsigned long long>(id), pid, caller,
+        traceMicros(span.called), span.handleId,
+        static_cast<unsigned long long>(span.bytes), span.ok ? "true" : "false"));
+    if (span.onWorker) {
+      append(std::snprintf(
+          event, sizeof(event),
+          "{\"name\":\"submit\",\"cat\":\"bufferedblob\",\"ph\":\"i\",\"s\":\"t\","
+          "\"pid\":%lld,\"tid\":%llu,\"ts\":%.3f,\"args\":{\"handleId\":%d}}",
+          pid, caller, traceMicros(span.submitted), span.handleId));
+      append(std::snprintf(
+          event, sizeof(event),
+          "{\"name\":\"queue\",\"cat\":\"bufferedblob\",\"ph\":\"b\",\"id\":%llu,"
+          "\"pid\":%lld,\"tid\":%llu,\"ts\":%.3f}",
+          static_cast<unsigned long long>(id), pid, caller, traceMicros(span.submitted)));
+      append(std::snprintf(
+          event, sizeof(event),
+          "{\"name\":\"queue\",\"cat\":\"bufferedblob\",\"ph\":\"e\",\"id\":%llu,"
+          "\"pid\":%lld,\"tid\":%llu,\"ts\":%.3f}",
+          static_cast<unsigned long long>(id), pid, caller, traceMicros(span.started)));
+      // A worker runs one task at a time, so its I/O is a plain slice.
+      workers.insert(span.workerThread);
+      append(std::snprintf(
+          event, sizeof(event),
+          "{\"name\":\"%s io\",\"cat\":\"bufferedblob\",\"ph\":\"X\","
+          "\"pid\":%lld,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f,"
+          "\"args\":{\"handleId\":%d,\"bytes\":%llu}}",
+          name, pid, worker, traceMicros(span.started),
+          traceMicros(span.completed) - traceMicros(span.started), span.handleId,
+          static_cast<unsigned long long>(span.bytes)));
+    }
+    append(std::snprintf(
+        event, sizeof(event),
+        "{\"name\":\"resolve\",\"cat\":\"bufferedblob\",\"ph\":\"i\",\"s\":\"t\","
+        "\"pid\":%lld,\"tid\":%llu,\"ts\":%.3f,\"args\":{\"handleId\":%d,\"ok\":%s}}",
+        pid, caller, traceMicros(span.delivered), span.handleId,
+        span.ok ? "true" : "false"));
+    append(std::snprintf(
+        event, sizeof(event),
+        "{\"name\":\"%s\",\"cat\":\"bufferedblob\",\"ph\":\"e\",\"id\":%llu,"
+        "\"pid\":%lld,\"tid\":%llu,\"ts\":%.3f}",
+        name, static_cast<unsigned long long>(id), pid, caller,
+        traceMicros(span.delivered)));
+  }
+
+  for (uint64_t worker : workers) {
+    if (callers.count(worker)) continue;
+    append(std::snprintf(
+        event, sizeof(event),
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%lld,\"tid\":%llu,"
+        "\"args\":{\"name\":\"BufferedBlob worker\"}}",
+        pid, static_cast<unsigned long long>(worker)));
+  }
+  json += "],\"otherData\":{\"droppedSpans\":";
+  json += std::to_string(dropped);
+  json += "}}";
+  return json;
+}
+
+// --- Threads and platform markers ---
+
+uint64_t currentThreadId() {
+  thread_local uint64_t id = [] {
+#if defined(__APPLE__)
+    uint64_t tid = 0;
+    ::pthread_threadid_np(nullptr, &tid);
+    return tid;
+#elif defined(__linux__)
+    return static_cast<uint64_t>(::syscall(SYS_gettid));
+#else
+    return static_cast<uint64_t>(0);
+#endif
+  }();
+  return id;
+}
+
+void traceOperationBegin(StatsOperation operation, int handleId, uint64_t cookie) {
+#if defined(__ANDROID__)
+  // Section names must match on end, so the handle stays out of them.
+  (void)handleId;
+  const auto& trace = atrace();
+  if (trace.beginAsyncSection && trace.capturing()) {
+    trace.beginAsyncSection(sectionName(operation), static_cast<int32_t>(cookie));
+  }
+#elif defined(__APPLE__)
+  auto log = signpostLog();
+  if (os_signpost_enabled(log)) {
+    os_signpost_interval_begin(log, static_cast<os_signpost_id_t>(cookie), "Operation",
+                               "%{public}s handle=%d", OperationStats::name(operation),
+                               handleId);
+  }
+#else
+  (void)operation;
+  (void)handleId;
+  (void)cookie;
+#endif
+}
+
+void traceOperationEnd(StatsOperation operation, uint64_t cookie) {
+#if defined(__ANDROID__)
+  const auto& trace = atrace();
+  if (trace.endAsyncSection && trace.capturing()) {
+    trace.endAsyncSection(sectionName(operation), static_cast<int32_t>(cookie));
+  }
+#elif defined(__APPLE__)
+  auto log = signpostLog();
+  if (os_signpost_enabled(log)) {
+    os_signpost_interval_end(log, static_cast<os_signpost_id_t>(cookie), "Operation",
+                             "%{public}s", OperationStats::name(operation));
+  }
+#else
+  (void)operation;
+  (void)cookie;
+#endif
+}
+
+TraceTaskSection::TraceTaskSection() {
+#if defined(__ANDROID__)
+  const auto& trace = atrace();
+  if (trace.beginSection && trace.capturing()) {
+    trace.beginSection("BufferedBlob task");
+    id_ = 1;
+  }
+#elif defined(__APPLE__)
+  auto log = signpostLog();
+  if (os_signpost_enabled(log)) {
+    id_ = os_signpost_id_generate(log);
+    os_signpost_interval_begin(log, id_, "Task");
+  }
+#endif
+}
+
+TraceTaskSection::~TraceTaskSection() {
+  if (id_ == 0) return;
+#if defined(__ANDROID__)
+  atrace().endSection();
+#elif defined(__APPLE__)
+  os_signpost_interval_end(signpostLog(), id_, "Task");
+#endif
+}
+
+} // namespace bufferedblob
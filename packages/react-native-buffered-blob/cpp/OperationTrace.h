@@ -0,0 +1,102 @@
+#pragma once
+
+#include "OperationStats.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bufferedblob {
+
+/** Timeline of one finished operation; see OperationTimer. */
+struct TraceSpan {
+  using Clock = std::chrono::steady_clock;
+
+  StatsOperation operation;
+  int handleId;
+  uint64_t bytes;
+  bool ok;
+  /** Thread that made the call and settled the promise (the JS thread). */
+  uint64_t callerThread;
+  /** Thread the result was produced on. */
+  uint64_t workerThread;
+  /** Whether submitted/started describe a pool task queued by this call. */
+  bool onWorker;
+  Clock::time_point called;
+  Clock::time_point submitted;
+  Clock::time_point started;
+  Clock::time_point completed;
+  Clock::time_point delivered;
+};
+
+/**
+ * In-memory ring buffer of operation spans, exported as Chrome trace
+ * JSON (chrome://tracing, ui.perfetto.dev). Off until start(); while off,
+ * recording costs one relaxed load. When full, the oldest spans are
+ * overwritten.
+ */
+class TraceRecorder {
+public:
+  static constexpr size_t kDefaultCapacity = 16384;
+  static constexpr size_t kMaxCapacity = 1 << 20;
+
+  static TraceRecorder& shared();
+
+  /** Clear the buffer and record up to `capacity` of the latest spans. */
+  void start(size_t capacity = kDefaultCapacity);
+
+  /** Stop recording; the buffered spans stay available to dump. */
+  void stop();
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  void record(const TraceSpan& span);
+
+  /**
+   * Buffered spans, oldest first, as a Chrome trace document. Each
+   * operation becomes a slice on the caller's thread (call until the
+   * promise settled) with submit and resolve instants, an "io" slice on
+   * the worker that produced the result, and an async "queue" slice while
+   * it waited for that worker. Slices carry handleId and bytes.
+   */
+  std::string chromeTraceJson() const;
+
+private:
+  TraceRecorder() = default;
+
+  std::atomic<bool> enabled_{false};
+  mutable std::mutex mutex_;
+  std::vector<TraceSpan> spans_;
+  size_t capacity_{0};
+  size_t next_{0};
+  uint64_t dropped_{0};
+};
+
+/** OS thread ID of the calling thread, as system tracers report it. */
+uint64_t currentThreadId();
+
+// Platform tracer markers (ATrace on Android, os_signpost on Apple, no-ops
+// elsewhere). They are emitted only while the system tracer is capturing,
+// independently of TraceRecorder.
+
+/** Begin an interval for operation `cookie` (nonzero, unique while open). */
+void traceOperationBegin(StatsOperation operation, int handleId, uint64_t cookie);
+void traceOperationEnd(StatsOperation operation, uint64_t cookie);
+
+/** Marks the calling thread busy with a pool task for its lifetime. */
+class TraceTaskSection {
+public:
+  TraceTaskSection();
+  ~TraceTaskSection();
+
+  TraceTaskSection(const TraceTaskSection&) = delete;
+  TraceTaskSection& operator=(const TraceTaskSection&) = delete;
+
+private:
+  uint64_t id_{0};
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "ChunkBuffer.h"
+#include "DownloadProgress.h"
+#include "MappedFile.h"
+#include "TreeHash.h"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace bufferedblob {
+
+/**
+ * Borrowed bytes for a write. `keepAlive` owns whatever backs `data`
+ * (typically the JS ArrayBuffer) and is released once the write finishes,
+ * so bridges can issue the write straight from that memory.
+ */
+struct WriteBuffer {
+  const uint8_t* data{nullptr};
+  size_t size{0};
+  std::shared_ptr<void> keepAlive;
+};
+
+/**
+ * Platform bridge abstraction.
+ * Each platform (Android/iOS) implements this interface to provide
+ * native streaming operations that the JSI HostObject delegates to.
+ * PosixPlatformBridge provides a portable file-descriptor implementation
+ * that platform bridges can extend.
+ *
+ * This header must stay free of JSI/React dependencies so the streaming
+ * core can be built on a plain desktop toolchain.
+ */
+struct PlatformBridge {
+  virtual ~PlatformBridge() = default;
+
+  // Reader operations.
+  // onSuccess receives a filled ChunkBuffer that becomes the backing store
+  // of the ArrayBuffer handed to JS without further copies. A download
+  // started with DownloadConfig::stream is read through its handle.
+  virtual void readNextChunk(
+    int handleId,
+    std::function<void(ChunkBuffer)> onSuccess,
+    std::function<void()> onEOF,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Read up to `maxChunks` sequential chunks in one task, stopping early
+  // once `maxBytes` have been read (at least one chunk is always read).
+  // An empty vector means EOF.
+  virtual void readChunks(
+    int handleId,
+    size_t maxChunks,
+    size_t maxBytes,
+    std::function<void(std::vector<ChunkBuffer>)> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Positional read of up to `length` bytes at `offset` (pread). Does not
+  // move the sequential position; several may run in parallel. A short or
+  // empty chunk means the range extends past the end of the file.
+  virtual void readAt(
+    int handleId,
+    int64_t offset,
+    size_t length,
+    std::function<void(ChunkBuffer)> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Keep up to `depth` chunks read ahead for this reader so readNextChunk
+  // can complete from memory. Call before the first read; once enabled,
+  // read-ahead stays on for the lifetime of the handle. Sync.
+  virtual void setReadAhead(int handleId, int depth) = 0;
+
+  // Decode the reader's file with a streaming decompressor (see
+  // Compression.h); sequential reads then return decompressed chunks and
+  // readAt is rejected. Call before the first read. Sync; throws
+  // std::runtime_error or std::invalid_argument carrying
+  // "[ERROR_CODE] message".
+  virtual void setDecompression(
+    int handleId,
+    const std::string& format,
+    std::optional<int> windowBits
+  ) = 0;
+
+  // Memory-mapped readers (sync). openMapped throws std::runtime_error
+  // carrying "[ERROR_CODE] message"; getMapping returns null for unknown
+  // handles. Slices handed to JS keep the returned mapping alive.
+  virtual int openMapped(const std::string& path) = 0;
+  virtual std::shared_ptr<MappedFile> getMapping(int handleId) = 0;
+
+  // Writer operations
+  virtual void write(
+    int handleId,
+    WriteBuffer data,
+    std::function<void(int)> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Write several buffers in order as one batch (writev(2)); onSuccess
+  // receives the total byte count.
+  virtual void writev(
+    int handleId,
+    std::vector<WriteBuffer> buffers,
+    std::function<void(int)> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Buffer writes natively and write them out in the background. Writes
+  // complete immediately until more than `highWaterMark` bytes are
+  // pending, then only once the backlog drains to `lowWaterMark`. flush()
+  // waits for the buffer to empty. Call before the first write; stays on
+  // for the lifetime of the handle. Sync.
+  virtual void setWriteBehind(
+    int handleId,
+    size_t highWaterMark,
+    size_t lowWaterMark
+  ) = 0;
+
+  // Compress everything written to this writer. flush() also flushes the
+  // compressor so the file decodes up to that point; the stream trailer
+  // is written when the handle is released after close(). Call before the
+  // first write. Sync; throws like setDecompression.
+  virtual void setCompression(
+    int handleId,
+    const std::string& format,
+    std::optional<int> level,
+    std::optional<int> windowBits
+  ) = 0;
+
+  virtual void flush(
+    int handleId,
+    std::function<void()> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Close (sync)
+  virtual void close(int handleId) = 0;
+
+  // Per-download settings for startDownload.
+  struct DownloadConfig {
+    ProgressThrottle progress;
+    // Continue from the DownloadResume checkpoint next to the destination,
+    // and leave one behind if this attempt does not complete.
+    bool resume{false};
+    // Up to this many concurrent SegmentedDownload ranges, each at least
+    // minSegmentSize bytes, when the server serves ranges. Ignored when
+    // resuming.
+    int segments{1};
+    int64_t minSegmentSize{1024 * 1024};
+    // Tee the body into the DownloadStream attached to the handle (see
+    // NativeHandleRegistry::downloadStream); with writeFile off nothing is
+    // written to the destination. Streaming ignores resume and segments.
+    bool stream{false};
+    bool writeFile{true};
+  };
+
+  // Download operations. The transfer loop pushes byte counts into a
+  // DownloadProgress built from `config.progress` and `onProgress`;
+  // onProgress runs on a transfer thread.
+  virtual void startDownload(
+    int handleId,
+    const DownloadConfig& config,
+    std::function<void(double, double, double)> onProgress,
+    std::function<void()> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  virtual void cancelDownload(int handleId) = 0;
+
+  // URL of a created download, or empty for unknown handles. Used to key
+  // the DownloadScheduler's per-host limits. Sync.
+  virtual std::string downloadUrl(int handleId) = 0;
+
+  // Hash a whole file natively; onSuccess receives the lowercase hex digest.
+  virtual void hashFile(
+    const std::string& path,
+    const std::string& algorithm,
+    std::function<void(std::string)> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Hash a file as a tree of fixed-size chunks read in parallel across
+  // the worker pool (see TreeHashJob for the algorithms).
+  virtual void hashFileTree(
+    const std::string& path,
+    const std::string& algorithm,
+    size_t chunkSize,
+    bool includeChunkDigests,
+    std::function<void(TreeHashResult)> onSuccess,
+    std::function<void(std::string)> onError
+  ) = 0;
+
+  // Incremental hashers (sync). Hashers live in the native handle table
+  // and are closed with close(). Failures throw std::runtime_error or
+  // std::invalid_argument carrying "[ERROR_CODE] message".
+  // attachHasher feeds a reader's sequential chunks, a writer's written
+  // buffers or a download's received bytes into the hasher; attach before
+  // the first read, write or startDownload.
+  virtual int createHasher(const std::string& algorithm) = 0;
+  virtual void updateHasher(int hasherId, const uint8_t* data, size_t size) = 0;
+  virtual std::string digestHasher(int hasherId) = 0;
+  virtual void attachHasher(int handleId, int hasherId) = 0;
+
+  // Reader info (sync)
+  struct ReaderInfo {
+    double fileSize;
+    double bytesRead;
+    bool isEOF;
+  };
+  virtual ReaderInfo getReaderInfo(int handleId) = 0;
+
+  // Writer info (sync)
+  struct WriterInfo {
+    double bytesWritten;
+    double pendingBytes;
+  };
+  virtual WriterInfo getWriterInfo(int handleId) = 0;
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,1037 @@
+#include "PosixPlatformBridge.h"
+#include "Hasher.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace bufferedblob {
+
+// --- Thread Pool ---
+
+PosixPlatformBridge::PosixPlatformBridge(ThreadRunner threadRunner)
+    : pool_(WorkerPool::defaultThreadCount(), std::move(threadRunner)) {}
+
+// The pool runs its queued tasks before the workers are joined.
+PosixPlatformBridge::~PosixPlatformBridge() = default;
+
+void PosixPlatformBridge::submitTask(std::function<void()> task) {
+  pool_.submit(std::move(task));
+}
+
+void PosixPlatformBridge::submitOrdered(const void* handle, std::function<void()> task) {
+  pool_.submit(handle, std::move(task));
+}
+
+// --- Read (uses thread pool) ---
+
+namespace {
+
+// Decode up to one buffer of the reader's compressed stream. Compressed
+// input is refilled from the fd as the decoder drains it; hitting EOF
+// before the stream is complete is an error. Caller holds ioMutex.
+ssize_t fillDecompressedChunk(NativeReaderHandle& reader, ChunkBuffer& chunk,
+                              std::string& error) {
+  auto& decompression = reader.decompression;
+  uint8_t* out = chunk.data();
+  size_t outSize = reader.bufferSize;
+  while (outSize > 0) {
+    if (decompression.inputPos == decompression.inputEnd &&
+        !decompression.sourceEOF) {
+      if (decompression.input.empty()) decompression.input.resize(reader.bufferSize);
+      ssize_t n = ::read(reader.fd, decompression.input.data(),
+                         decompression.input.size());
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        error = std::string("[IO_ERROR] ") + std::strerror(errno);
+        return -1;
+      }
+      decompression.inputPos = 0;
+      decompression.inputEnd = static_cast<size_t>(n);
+      if (n == 0) decompression.sourceEOF = true;
+    }
+
+    const uint8_t* in = decompression.input.data() + decompression.inputPos;
+    size_t inSize = decompression.inputEnd - decompression.inputPos;
+    size_t before = inSize + outSize;
+    try {
+      decompression.decompressor->decompress(in, inSize, out, outSize);
+    } catch (const std::exception& e) {
+      error = e.what();
+      return -1;
+    }
+    decompression.inputPos = decompression.inputEnd - inSize;
+
+    if (inSize + outSize == before && inSize == 0 && decompression.sourceEOF) {
+      if (!decompression.decompressor->atEnd()) {
+        error = "[IO_ERROR] Compressed stream is truncated";
+        return -1;
+      }
+      break;
+    }
+  }
+
+  size_t filled = reader.bufferSize - outSize;
+  chunk.setSize(filled);
+  if (reader.hasher && filled > 0) reader.hasher->update(chunk.data(), filled);
+  return static_cast<ssize_t>(filled);
+}
+
+// Read up to one buffer from the reader's current position straight into
+// the storage that will back the JS ArrayBuffer, feeding an attached
+// hasher from the same memory. Caller holds ioMutex.
+// Returns the byte count (0 at EOF), or -1 with `error` set.
+ssize_t fillChunk(NativeReaderHandle& reader, ChunkBuffer& chunk,
+                  std::string& error) {
+  if (reader.decompression.decompressor) {
+    return fillDecompressedChunk(reader, chunk, error);
+  }
+  // Pooled storage may be larger than bufferSize; fill only bufferSize.
+  size_t filled = 0;
+  while (filled < reader.bufferSize) {
+    ssize_t n = ::read(reader.fd, chunk.data() + filled,
+                       reader.bufferSize - filled);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      error = std::string("[IO_ERROR] ") + std::strerror(errno);
+      return -1;
+    }
+    if (n == 0) break;
+    filled += static_cast<size_t>(n);
+  }
+  chunk.setSize(filled);
+  if (reader.hasher && filled > 0) reader.hasher->update(chunk.data(), filled);
+  return static_cast<ssize_t>(filled);
+}
+
+} // namespace
+
+void PosixPlatformBridge::readNextChunk(
+    int handleId,
+    std::function<void(ChunkBuffer)> onSuccess,
+    std::function<void()> onEOF,
+    std::function<void(std::string)> onError) {
+  auto reader = NativeHandleRegistry::shared().reader(handleId);
+  if (!reader) {
+    // Streaming downloads are read through their download handle.
+    if (auto stream = NativeHandleRegistry::shared().downloadStream(handleId)) {
+      stream->read(std::move(onSuccess), std::move(onEOF), std::move(onError));
+      return;
+    }
+    onError("[READER_CLOSED] Reader handle not found: " + std::to_string(handleId));
+    return;
+  }
+
+  bool readAheadEnabled;
+  {
+    std::lock_guard<std::mutex> lock(reader->readAhead.mutex);
+    readAheadEnabled = reader->readAhead.depth > 0;
+  }
+  if (readAheadEnabled) {
+    readAheadNext(reader, PendingRead{std::move(onSuccess), std::move(onEOF),
+                                      std::move(onError)});
+    return;
+  }
+
+  submitOrdered(reader.get(), [reader, onSuccess = std::move(onSuccess),
+                               onEOF = std::move(onEOF), onError = std::move(onError)]() {
+    std::lock_guard<std::mutex> lock(reader->ioMutex);
+    if (reader->isClosed) {
+      onError("[READER_CLOSED] Reader is closed");
+      return;
+    }
+    if (reader->isEOF) {
+      onEOF();
+      return;
+    }
+
+    ChunkBuffer chunk(reader->bufferSize);
+    std::string error;
+    ssize_t filled = fillChunk(*reader, chunk, error);
+    if (filled < 0) {
+      onError(std::move(error));
+      return;
+    }
+    if (filled == 0) {
+      reader->isEOF = true;
+      onEOF();
+      return;
+    }
+
+    reader->bytesRead += static_cast<int64_t>(filled);
+    onSuccess(std::move(chunk));
+  });
+}
+
+// --- Batched read (uses thread pool) ---
+
+void PosixPlatformBridge::readChunks(
+    int handleId,
+    size_t maxChunks,
+    size_t maxBytes,
+    std::function<void(std::vector<ChunkBuffer>)> onSuccess,
+    std::function<void(std::string)> onError) {
+  auto reader = NativeHandleRegistry::shared().reader(handleId);
+  if (!reader) {
+    onError("[READER_CLOSED] Reader handle not found: " + std::to_string(handleId));
+    return;
+  }
+  if (maxChunks == 0) maxChunks = 1;
+
+  {
+    // With read-ahead, hand over whatever is already buffered; only wait
+    // (for a single chunk) when nothing is ready.
+    std::unique_lock<std::mutex> lock(reader->readAhead.mutex);
+    auto& readAhead = reader->readAhead;
+    if (readAhead.depth > 0) {
+      std::vector<ChunkBuffer> chunks;
+      size_t bytes = 0;
+      if (!reader->isClosed && readAhead.waiters.empty()) {
+        while (!readAhead.ready.empty() && chunks.size() < maxChunks &&
+               (chunks.empty() || bytes < maxBytes)) {
+          bytes += readAhead.ready.front().size();
+          chunks.push_back(std::move(readAhead.ready.front()));
+          readAhead.ready.pop_front();
+        }
+      }
+      if (!chunks.empty()) {
+        scheduleFillLocked(reader);
+        lock.unlock();
+        reader->bytesRead += static_cast<int64_t>(bytes);
+        onSuccess(std::move(chunks));
+        return;
+      }
+      lock.unlock();
+      readAheadNext(
+          reader,
+          PendingRead{
+              [onSuccess](ChunkBuffer chunk) {
+                std::vector<ChunkBuffer> chunks;
+                chunks.push_back(std::move(chunk));
+                onSuccess(std::move(chunks));
+              },
+              [onSuccess]() { onSuccess({}); },
+              std::move(onError)});
+      return;
+    }
+  }
+
+  submitOrdered(reader.get(), [reader, maxChunks, maxBytes,
+                               onSuccess = std::move(onSuccess),
+                               onError = std::move(onError)]() {
+    std::lock_guard<std::mutex> lock(reader->ioMutex);
+    if (reader->isClosed) {
+      onError("[READER_CLOSED] Reader is closed");
+      return;
+    }
+
+    std::vector<ChunkBuffer> chunks;
+    size_t bytes = 0;
+    while (!reader->isEOF && chunks.size() < maxChunks &&
+           (chunks.empty() || bytes < maxBytes)) {
+      ChunkBuffer chunk(reader->bufferSize);
+      std::string error;
+      ssize_t filled = fillChunk(*reader, chunk, error);
+      if (filled < 0) {
+        // Deliver what was read; the error resurfaces on the next call.
+        if (chunks.empty()) {
+          onError(std::move(error));
+          return;
+        }
+        break;
+      }
+      if (filled == 0) {
+        reader->isEOF = true;
+        break;
+      }
+      bytes += static_cast<size_t>(filled);
+      chunks.push_back(std::move(chunk));
+    }
+
+    reader->bytesRead += static_cast<int64_t>(bytes);
+    onSuccess(std::move(chunks));
+  });
+}
+
+// --- Positional read (uses thread pool, no per-handle lock) ---
+
+void PosixPlatformBridge::readAt(
+    int handleId,
+    int64_t offset,
+    size_t length,
+    std::function<void(ChunkBuffer)> onSuccess,
+    std::function<void(std::string)> onError) {
+  auto reader = NativeHandleRegistry::shared().reader(handleId);
+  if (!reader) {
+    onError("[READER_CLOSED] Reader handle not found: " + std::to_string(handleId));
+    return;
+  }
+
+  if (reader->decompression.decompressor) {
+    onError("[INVALID_ARGUMENT] readAt is not supported on decompressing readers");
+    return;
+  }
+
+  submitTask([reader, offset, length, onSuccess = std::move(onSuccess),
+               onError = std::move(onError)]() {
+    if (reader->isClosed) {
+      onError("[READER_CLOSED] Reader is closed");
+      return;
+    }
+
+    // pread leaves the file offset alone, so this neither needs ioMutex
+    // nor disturbs sequential reads on the same handle.
+    ChunkBuffer chunk(length);
+    size_t filled = 0;
+    while (filled < length) {
+      ssize_t n = ::pread(reader->fd, chunk.data() + filled, length - filled,
+                          static_cast<off_t>(offset + static_cast<int64_t>(filled)));
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        onError(std::string("[IO_ERROR] ") + std::strerror(errno));
+        return;
+      }
+      if (n == 0) break;
+      filled += static_cast<size_t>(n);
+    }
+
+    chunk.setSize(filled);
+    onSuccess(std::move(chunk));
+  });
+}
+
+// --- Read-ahead ---
+
+void PosixPlatformBridge::setReadAhead(int handleId, int depth) {
+  auto reader = NativeHandleRegistry::shared().reader(handleId);
+  if (!reader || depth <= 0) return;
+
+  auto& readAhead = reader->readAhead;
+  std::lock_guard<std::mutex> lock(readAhead.mutex);
+  readAhead.depth = std::min(static_cast<size_t>(depth),
+                             NativeReaderHandle::ReadAhead::kMaxDepth);
+  scheduleFillLocked(reader);
+}
+
+// --- Decompression (synchronous) ---
+
+void PosixPlatformBridge::setDecompression(
+    int handleId,
+    const std::string& format,
+    std::optional<int> windowBits) {
+  auto reader = NativeHandleRegistry::shared().reader(handleId);
+  if (!reader) {
+    throw std::runtime_error(
+        "[READER_CLOSED] Reader handle not found: " + std::to_string(handleId));
+  }
+  auto decompressor = Decompressor::create(format, windowBits);
+
+  std::lock_guard<std::mutex> lock(reader->ioMutex);
+  if (::lseek(reader->fd, 0, SEEK_CUR) != 0) {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Decompression must be enabled before the first read");
+  }
+  reader->decompression.decompressor = std::move(decompressor);
+}
+
+void PosixPlatformBridge::readAheadNext(
+    const std::shared_ptr<NativeReaderHandle>& reader,
+    PendingRead request) {
+  auto& readAhead = reader->readAhead;
+  std::unique_lock<std::mutex> lock(readAhead.mutex);
+
+  if (reader->isClosed) {
+    lock.unlock();
+    request.onError("[READER_CLOSED] Reader is closed");
+    return;
+  }
+
+  // Waiters are only queued while nothing is ready, so a ready chunk
+  // always belongs to the next request.
+  if (!readAhead.ready.empty()) {
+    ChunkBuffer chunk = std::move(readAhead.ready.front());
+    readAhead.ready.pop_front();
+    scheduleFillLocked(reader);
+    lock.unlock();
+    reader->bytesRead += static_cast<int64_t>(chunk.size());
+    request.onSuccess(std::move(chunk));
+    return;
+  }
+
+  if (readAhead.waiters.empty()) {
+    if (!readAhead.error.empty()) {
+      std::string error = readAhead.error;
+      lock.unlock();
+      request.onError(std::move(error));
+      return;
+    }
+    if (readAhead.sourceEOF) {
+      lock.unlock();
+      reader->isEOF = true;
+      request.onEOF();
+      return;
+    }
+  }
+
+  readAhead.waiters.push_back(std::move(request));
+  scheduleFillLocked(reader);
+}
+
+void PosixPlatformBridge::scheduleFillLocked(
+    const std::shared_ptr<NativeReaderHandle>& reader) {
+  auto& readAhead = reader->readAhead;
+  if (readAhead.filling || readAhead.sourceEOF || !readAhead.error.empty() ||
+      reader->isClosed) {
+    return;
+  }
+  if (readAhead.ready.size() >= readAhead.depth && readAhead.waiters.empty()) {
+    return;
+  }
+  readAhead.filling = true;
+  submitOrdered(reader.get(), [this, reader]() { fillReadAhead(reader); });
+}
+
+void PosixPlatformBridge::fillReadAhead(
+    const std::shared_ptr<NativeReaderHandle>& reader) {
+  auto& readAhead = reader->readAhead;
+
+  // A single fill task per handle reads chunks in file order until the
+  // ready queue is full and nobody is waiting.
+  while (true) {
+    std::deque<PendingRead> failed;
+    bool closed = false;
+    {
+      std::lock_guard<std::mutex> lock(readAhead.mutex);
+      if (reader->isClosed) {
+        closed = true;
+        readAhead.filling = false;
+        readAhead.ready.clear();
+        failed.swap(readAhead.waiters);
+      } else if (readAhead.ready.size() >= readAhead.depth &&
+                 readAhead.waiters.empty()) {
+        readAhead.filling = false;
+        return;
+      }
+    }
+    if (closed) {
+      for (auto& waiter : failed) {
+        waiter.onError("[READER_CLOSED] Reader is closed");
+      }
+      return;
+    }
+
+    ChunkBuffer chunk(reader->bufferSize);
+    std::string error;
+    ssize_t filled;
+    {
+      std::lock_guard<std::mutex> lock(reader->ioMutex);
+      filled = fillChunk(*reader, chunk, error);
+    }
+
+    std::deque<PendingRead> finished;
+    PendingRead next;
+    bool deliver = false;
+    {
+      std::lock_guard<std::mutex> lock(readAhead.mutex);
+      if (filled <= 0) {
+        readAhead.filling = false;
+        if (filled < 0) {
+          readAhead.error = error;
+        } else {
+          readAhead.sourceEOF = true;
+        }
+        finished.swap(readAhead.waiters);
+      } else if (!readAhead.waiters.empty()) {
+        next = std::move(readAhead.waiters.front());
+        readAhead.waiters.pop_front();
+        deliver = true;
+      } else {
+        readAhead.ready.push_back(std::move(chunk));
+      }
+    }
+
+    if (filled < 0) {
+      for (auto& waiter : finished) waiter.onError(error);
+      return;
+    }
+    if (filled == 0) {
+      if (!finished.empty()) reader->isEOF = true;
+      for (auto& waiter : finished) waiter.onEOF();
+      return;
+    }
+    if (deliver) {
+      reader->bytesRead += static_cast<int64_t>(filled);
+      next.onSuccess(std::move(chunk));
+    }
+  }
+}
+
+// --- Memory-mapped readers (synchronous) ---
+
+int PosixPlatformBridge::openMapped(const std::string& path) {
+  return NativeHandleRegistry::shared().openMapped(path);
+}
+
+std::shared_ptr<MappedFile> PosixPlatformBridge::getMapping(int handleId) {
+  return NativeHandleRegistry::shared().mapping(handleId);
+}
+
+// --- Write (uses thread pool) ---
+
+namespace {
+
+// Write all of `size` bytes to `fd`. Caller holds the writer's ioMutex.
+// Returns false with `error` set on failure.
+bool writeAll(int fd, const uint8_t* data, size_t size, std::string& error) {
+  size_t written = 0;
+  while (written < size) {
+    ssize_t n = ::write(fd, data + written, size - written);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      error = std::string("[IO_ERROR] ") + std::strerror(errno);
+      return false;
+    }
+    written += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+// Write every buffer in order with as few writev(2) calls as possible,
+// resuming after partial writes. Caller holds the writer's ioMutex.
+bool writevAll(int fd, const std::vector<WriteBuffer>& buffers, std::string& error) {
+  std::vector<struct iovec> iov;
+  iov.reserve(buffers.size());
+  for (const auto& buffer : buffers) {
+    if (buffer.size == 0) continue;
+    iov.push_back({const_cast<uint8_t*>(buffer.data), buffer.size});
+  }
+
+  size_t index = 0;
+  while (index < iov.size()) {
+    int count = static_cast<int>(std::min<size_t>(iov.size() - index, IOV_MAX));
+    ssize_t n = ::writev(fd, iov.data() + index, count);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      error = std::string("[IO_ERROR] ") + std::strerror(errno);
+      return false;
+    }
+    // Skip fully written entries, then trim a partially written one.
+    size_t remaining = static_cast<size_t>(n);
+    while (index < iov.size() && remaining >= iov[index].iov_len) {
+      remaining -= iov[index].iov_len;
+      ++index;
+    }
+    if (remaining > 0) {
+      iov[index].iov_base = static_cast<uint8_t*>(iov[index].iov_base) + remaining;
+      iov[index].iov_len -= remaining;
+    }
+  }
+  return true;
+}
+
+// Write the buffers through the writer's compression stage if it has
+// one, otherwise as-is. Caller holds the writer's ioMutex.
+bool writeBuffers(NativeWriterHandle& writer,
+                  const std::vector<WriteBuffer>& buffers, std::string& error) {
+  auto& compression = writer.compression;
+  if (!compression.compressor) return writevAll(writer.fd, buffers, error);
+  for (const auto& buffer : buffers) {
+    if (!writeCompressed(writer.fd, *compression.compressor, compression.output,
+                         buffer.data, buffer.size, Compressor::Flush::None,
+                         error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Push everything the compressor is holding back to the fd, keeping the
+// stream open. Caller holds the writer's ioMutex.
+bool flushCompressed(NativeWriterHandle& writer, std::string& error) {
+  auto& compression = writer.compression;
+  if (!compression.compressor) return true;
+  return writeCompressed(writer.fd, *compression.compressor, compression.output,
+                         nullptr, 0, Compressor::Flush::Sync, error);
+}
+
+} // namespace
+
+void PosixPlatformBridge::write(
+    int handleId,
+    WriteBuffer data,
+    std::function<void(int)> onSuccess,
+    std::function<void(std::string)> onError) {
+  std::vector<WriteBuffer> buffers;
+  buffers.push_back(std::move(data));
+  writev(handleId, std::move(buffers), std::move(onSuccess), std::move(onError));
+}
+
+void PosixPlatformBridge::writev(
+    int handleId,
+    std::vector<WriteBuffer> buffers,
+    std::function<void(int)> onSuccess,
+    std::function<void(std::string)> onError) {
+  auto writer = NativeHandleRegistry::shared().writer(handleId);
+  if (!writer) {
+    onError("[WRITER_CLOSED] Writer handle not found: " + std::to_string(handleId));
+    return;
+  }
+
+  size_t total = 0;
+  for (const auto& buffer : buffers) total += buffer.size;
+
+  {
+    auto& writeBehind = writer->writeBehind;
+    std::unique_lock<std::mutex> lock(writeBehind.mutex);
+    if (writeBehind.enabled) {
+      if (!writeBehind.error.empty()) {
+        std::string error = writeBehind.error;
+        lock.unlock();
+        onError(std::move(error));
+        return;
+      }
+      // Copy now (on the caller's thread) so the JS buffers are released
+      // right away and small writes coalesce into one large syscall.
+      for (const auto& buffer : buffers) {
+        writeBehind.buffer.insert(writeBehind.buffer.end(), buffer.data,
+                                  buffer.data + buffer.size);
+      }
+      writeBehind.pendingBytes += total;
+      int size = static_cast<int>(total);
+      bool overHighWaterMark =
+          writeBehind.pendingBytes > writeBehind.highWaterMark;
+      if (overHighWaterMark) {
+        writeBehind.drainWaiters.push_back(
+            {size, std::move(onSuccess), std::move(onError)});
+      }
+      scheduleDrainLocked(writer);
+      lock.unlock();
+      if (!overHighWaterMark) onSuccess(size);
+      return;
+    }
+  }
+
+  submitOrdered(writer.get(), [writer, total, buffers = std::move(buffers),
+                               onSuccess = std::move(onSuccess),
+                               onError = std::move(onError)]() {
+    std::lock_guard<std::mutex> lock(writer->ioMutex);
+    if (writer->isClosed) {
+      onError("[WRITER_CLOSED] Writer is closed");
+      return;
+    }
+
+    // Write straight from the caller's memory; keepAlive pins it until
+    // this task (and the captured WriteBuffers) is destroyed.
+    std::string error;
+    if (!writeBuffers(*writer, buffers, error)) {
+      onError(std::move(error));
+      return;
+    }
+    if (writer->hasher) {
+      for (const auto& buffer : buffers) {
+        writer->hasher->update(buffer.data, buffer.size);
+      }
+    }
+
+    writer->bytesWritten += static_cast<int64_t>(total);
+    onSuccess(static_cast<int>(total));
+  });
+}
+
+// --- Write-behind ---
+
+void PosixPlatformBridge::setWriteBehind(
+    int handleId,
+    size_t highWaterMark,
+    size_t lowWaterMark) {
+  auto writer = NativeHandleRegistry::shared().writer(handleId);
+  if (!writer) return;
+
+  auto& writeBehind = writer->writeBehind;
+  std::lock_guard<std::mutex> lock(writeBehind.mutex);
+  writeBehind.enabled = true;
+  writeBehind.highWaterMark = highWaterMark;
+  writeBehind.lowWaterMark = std::min(lowWaterMark, highWaterMark);
+  writeBehind.buffer.reserve(highWaterMark);
+}
+
+void PosixPlatformBridge::scheduleDrainLocked(
+    const std::shared_ptr<NativeWriterHandle>& writer) {
+  auto& writeBehind = writer->writeBehind;
+  if (writeBehind.draining || writeBehind.buffer.empty()) return;
+  writeBehind.draining = true;
+  submitOrdered(writer.get(), [this, writer]() { drainWriteBehind(writer); });
+}
+
+void PosixPlatformBridge::drainWriteBehind(
+    const std::shared_ptr<NativeWriterHandle>& writer) {
+  auto& writeBehind = writer->writeBehind;
+  using PendingWrite = NativeWriterHandle::WriteBehind::PendingWrite;
+  using PendingFlush = NativeWriterHandle::WriteBehind::PendingFlush;
+
+  // Swap the whole buffer out and write it in one go; the two vectors
+  // alternate so their capacity is reused. Keeps going after close() so
+  // accepted bytes still reach the file.
+  std::vector<uint8_t> batch;
+  while (true) {
+    std::deque<PendingFlush> flushed;
+    {
+      std::lock_guard<std::mutex> lock(writeBehind.mutex);
+      if (writeBehind.buffer.empty()) {
+        writeBehind.draining = false;
+        flushed.swap(writeBehind.flushWaiters);
+      } else {
+        batch.swap(writeBehind.buffer);
+      }
+    }
+    if (batch.empty()) {
+      std::string error;
+      bool ok = true;
+      if (!flushed.empty()) {
+        std::lock_guard<std::mutex> lock(writer->ioMutex);
+        ok = flushCompressed(*writer, error);
+      }
+      for (auto& waiter : flushed) {
+        if (ok) {
+          waiter.onSuccess();
+        } else {
+          waiter.onError(error);
+        }
+      }
+      return;
+    }
+
+    std::string error;
+    bool ok;
+    {
+      std::lock_guard<std::mutex> lock(writer->ioMutex);
+      if (writer->compression.compressor) {
+        ok = writeCompressed(writer->fd, *writer->compression.compressor,
+                             writer->compression.output, batch.data(),
+                             batch.size(), Compressor::Flush::None, error);
+      } else {
+        ok = writeAll(writer->fd, batch.data(), batch.size(), error);
+      }
+      if (ok && writer->hasher) writer->hasher->update(batch.data(), batch.size());
+    }
+    if (ok) writer->bytesWritten += static_cast<int64_t>(batch.size());
+
+    std::deque<PendingWrite> drained;
+    {
+      std::lock_guard<std::mutex> lock(writeBehind.mutex);
+      writeBehind.pendingBytes -= batch.size();
+      if (!ok) {
+        // Drop the backlog; every later write and flush reports the error.
+        writeBehind.error = error;
+        writeBehind.pendingBytes -= writeBehind.buffer.size();
+        writeBehind.buffer.clear();
+        writeBehind.draining = false;
+        drained.swap(writeBehind.drainWaiters);
+        flushed.swap(writeBehind.flushWaiters);
+      } else if (writeBehind.pendingBytes <= writeBehind.lowWaterMark) {
+        drained.swap(writeBehind.drainWaiters);
+      }
+    }
+    batch.clear();
+
+    if (!ok) {
+      for (auto& waiter : drained) waiter.onError(error);
+      for (auto& waiter : flushed) waiter.onError(error);
+      return;
+    }
+    for (auto& waiter : drained) waiter.onSuccess(waiter.size);
+  }
+}
+
+// --- Compression (synchronous) ---
+
+void PosixPlatformBridge::setCompression(
+    int handleId,
+    const std::string& format,
+    std::optional<int> level,
+    std::optional<int> windowBits) {
+  auto writer = NativeHandleRegistry::shared().writer(handleId);
+  if (!writer) {
+    throw std::runtime_error(
+        "[WRITER_CLOSED] Writer handle not found: " + std::to_string(handleId));
+  }
+  auto compressor = Compressor::create(format, level, windowBits);
+
+  {
+    std::lock_guard<std::mutex> lock(writer->writeBehind.mutex);
+    if (writer->writeBehind.pendingBytes > 0) {
+      throw std::runtime_error(
+          "[INVALID_ARGUMENT] Compression must be enabled before the first write");
+    }
+  }
+  std::lock_guard<std::mutex> lock(writer->ioMutex);
+  if (writer->bytesWritten > 0) {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Compression must be enabled before the first write");
+  }
+  writer->compression.compressor = std::move(compressor);
+}
+
+// --- Flush (uses thread pool) ---
+
+void PosixPlatformBridge::flush(
+    int handleId,
+    std::function<void()> onSuccess,
+    std::function<void(std::string)> onError) {
+  auto writer = NativeHandleRegistry::shared().writer(handleId);
+  if (!writer) {
+    onError("[WRITER_CLOSED] Writer handle not found: " + std::to_string(handleId));
+    return;
+  }
+
+  {
+    auto& writeBehind = writer->writeBehind;
+    std::unique_lock<std::mutex> lock(writeBehind.mutex);
+    if (writeBehind.enabled) {
+      if (!writeBehind.error.empty()) {
+        std::string error = writeBehind.error;
+        lock.unlock();
+        onError(std::move(error));
+        return;
+      }
+      if (writeBehind.draining || !writeBehind.buffer.empty()) {
+        writeBehind.flushWaiters.push_back(
+            {std::move(onSuccess), std::move(onError)});
+        return;
+      }
+      // Nothing is buffered here, but a compressor may still hold output;
+      // that needs the pool task below.
+      if (!writer->compression.compressor) {
+        lock.unlock();
+        onSuccess();
+        return;
+      }
+    }
+  }
+
+  submitOrdered(writer.get(), [writer, onSuccess = std::move(onSuccess),
+                               onError = std::move(onError)]() {
+    std::lock_guard<std::mutex> lock(writer->ioMutex);
+    if (writer->isClosed) {
+      onError("[WRITER_CLOSED] Writer is closed");
+      return;
+    }
+    // write(2) goes straight to the kernel, so apart from a compressor's
+    // pending output there is no user-space buffer to drain. Running on
+    // the writer's lane orders this after prior writes.
+    std::string error;
+    if (!flushCompressed(*writer, error)) {
+      onError(std::move(error));
+      return;
+    }
+    onSuccess();
+  });
+}
+
+// --- Close (synchronous, called from JS thread) ---
+
+void PosixPlatformBridge::close(int handleId) {
+  NativeHandleRegistry::shared().remove(handleId);
+}
+
+// --- Download (unsupported without a platform network stack) ---
+
+void PosixPlatformBridge::startDownload(
+    int handleId,
+    const DownloadConfig& config,
+    std::function<void(double, double, double)> onProgress,
+    std::function<void()> onSuccess,
+    std::function<void(std::string)> onError) {
+  onError("[DOWNLOAD_FAILED] Downloads are not supported on this platform");
+}
+
+void PosixPlatformBridge::cancelDownload(int handleId) {}
+
+std::string PosixPlatformBridge::downloadUrl(int handleId) {
+  return std::string();
+}
+
+// --- Hashing (uses thread pool) ---
+
+namespace {
+
+// Large, page-aligned read buffer: fewer syscalls, and the kernel copy
+// lands on whole pages.
+constexpr size_t kHashBufferSize = 1024 * 1024;
+constexpr size_t kHashBufferAlignment = 4096;
+
+struct AlignedFree {
+  void operator()(uint8_t* ptr) const { std::free(ptr); }
+};
+
+// Stream the whole file through `hasher`. Returns false with `error` set.
+bool hashFd(int fd, Hasher& hasher, std::string& error) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#elif defined(F_RDAHEAD)
+  ::fcntl(fd, F_RDAHEAD, 1);
+#endif
+
+  void* storage = nullptr;
+  if (::posix_memalign(&storage, kHashBufferAlignment, kHashBufferSize) != 0) {
+    error = "[IO_ERROR] Failed to allocate hash buffer";
+    return false;
+  }
+  std::unique_ptr<uint8_t, AlignedFree> buffer(static_cast<uint8_t*>(storage));
+
+  while (true) {
+    ssize_t n = ::read(fd, buffer.get(), kHashBufferSize);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      error = std::string("[IO_ERROR] ") + std::strerror(errno);
+      return false;
+    }
+    if (n == 0) return true;
+    hasher.update(buffer.get(), static_cast<size_t>(n));
+  }
+}
+
+} // namespace
+
+void PosixPlatformBridge::hashFile(
+    const std::string& path,
+    const std::string& algorithm,
+    std::function<void(std::string)> onSuccess,
+    std::function<void(std::string)> onError) {
+  submitTask([path, algorithm, onSuccess = std::move(onSuccess),
+               onError = std::move(onError)]() {
+    std::unique_ptr<Hasher> hasher;
+    int fd;
+    try {
+      hasher = Hasher::create(algorithm);
+      int64_t fileSize = 0;
+      fd = openRegularFile(path, fileSize);
+    } catch (const std::exception& e) {
+      onError(e.what());
+      return;
+    }
+
+    std::string error;
+    bool ok = hashFd(fd, *hasher, error);
+    ::close(fd);
+    if (!ok) {
+      onError(std::move(error));
+      return;
+    }
+    onSuccess(toHex(hasher->digest()));
+  });
+}
+
+// --- Tree hashing (fans out across the thread pool) ---
+
+void PosixPlatformBridge::hashFileTree(
+    const std::string& path,
+    const std::string& algorithm,
+    size_t chunkSize,
+    bool includeChunkDigests,
+    std::function<void(TreeHashResult)> onSuccess,
+    std::function<void(std::string)> onError) {
+  submitTask([this, path, algorithm, chunkSize, includeChunkDigests,
+               onSuccess = std::move(onSuccess), onError = std::move(onError)]() {
+    std::shared_ptr<TreeHashJob> job;
+    try {
+      if (!TreeHashJob::isSupported(algorithm)) {
+        throw std::invalid_argument(
+            "[INVALID_ARGUMENT] Tree hashing supports blake3 and sha256, got: " + algorithm);
+      }
+      int64_t fileSize = 0;
+      int fd = openRegularFile(path, fileSize);
+      job = std::make_shared<TreeHashJob>(fd, fileSize, algorithm, chunkSize,
+                                          includeChunkDigests);
+    } catch (const std::exception& e) {
+      onError(e.what());
+      return;
+    }
+
+    // Every worker claims chunks from the job until none are left; the
+    // last one to return combines the results. Nothing blocks waiting on
+    // other pool tasks, so this cannot starve the pool.
+    size_t workers = std::min(pool_.size(), job->chunkCount());
+    auto remaining = std::make_shared<std::atomic<size_t>>(workers);
+    auto work = [job, remaining, onSuccess, onError]() {
+      job->run();
+      if (remaining->fetch_sub(1) != 1) return;
+      TreeHashResult result;
+      try {
+        result = job->finish();
+      } catch (const std::exception& e) {
+        onError(e.what());
+        return;
+      }
+      onSuccess(std::move(result));
+    };
+    for (size_t i = 1; i < workers; ++i) submitTask(work);
+    work();
+  });
+}
+
+// --- Incremental hashers (synchronous) ---
+
+namespace {
+
+std::shared_ptr<NativeHasherHandle> requireHasher(int hasherId) {
+  auto hasher = NativeHandleRegistry::shared().hasher(hasherId);
+  if (!hasher) {
+    throw std::runtime_error(
+        "[INVALID_ARGUMENT] Hasher handle not found: " + std::to_string(hasherId));
+  }
+  return hasher;
+}
+
+} // namespace
+
+int PosixPlatformBridge::createHasher(const std::string& algorithm) {
+  return NativeHandleRegistry::shared().createHasher(algorithm);
+}
+
+void PosixPlatformBridge::updateHasher(int hasherId, const uint8_t* data, size_t size) {
+  if (!requireHasher(hasherId)->update(data, size)) {
+    throw std::runtime_error("[INVALID_ARGUMENT] Hasher has already been digested");
+  }
+}
+
+std::string PosixPlatformBridge::digestHasher(int hasherId) {
+  return requireHasher(hasherId)->digest();
+}
+
+void PosixPlatformBridge::attachHasher(int handleId, int hasherId) {
+  NativeHandleRegistry::shared().attachHasher(handleId, hasherId);
+}
+
+// --- Info (synchronous, lock-free reads of atomics) ---
+
+PlatformBridge::ReaderInfo PosixPlatformBridge::getReaderInfo(int handleId) {
+  ReaderInfo info{0, 0, false};
+  auto reader = NativeHandleRegistry::shared().reader(handleId);
+  if (!reader) {
+    info.isEOF = true;
+    return info;
+  }
+  info.fileSize = static_cast<double>(reader->fileSize);
+  info.bytesRead = static_cast<double>(reader->bytesRead.load());
+  info.isEOF = reader->isEOF.load();
+  return info;
+}
+
+PlatformBridge::WriterInfo PosixPlatformBridge::getWriterInfo(int handleId) {
+  WriterInfo info{0, 0};
+  auto writer = NativeHandleRegistry::shared().writer(handleId);
+  if (writer) {
+    info.bytesWritten = static_cast<double>(writer->bytesWritten.load());
+    std::lock_guard<std::mutex> lock(writer->writeBehind.mutex);
+    info.pendingBytes = static_cast<double>(writer->writeBehind.pendingBytes);
+  }
+  return info;
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "PlatformBridge.h"
+#include "NativeHandleRegistry.h"
+#include "WorkerPool.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * Portable PlatformBridge implementation over raw file descriptors.
+ * Reader/writer handles live in NativeHandleRegistry, so reads and writes
+ * never leave native code. Works unchanged on Android and desktop Linux.
+ *
+ * Downloads are not supported here; platform bridges that can perform
+ * network I/O extend this class and override startDownload/cancelDownload.
+ */
+class PosixPlatformBridge : public PlatformBridge {
+public:
+  /**
+   * Wraps the body of each worker thread. Platforms use it to attach the
+   * thread to their runtime (e.g. fbjni::ThreadScope on Android).
+   */
+  using ThreadRunner = WorkerPool::ThreadRunner;
+
+  explicit PosixPlatformBridge(ThreadRunner threadRunner = nullptr);
+  ~PosixPlatformBridge() override;
+
+  void readNextChunk(
+    int handleId,
+    std::function<void(ChunkBuffer)> onSuccess,
+    std::function<void()> onEOF,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void write(
+    int handleId,
+    WriteBuffer data,
+    std::function<void(int)> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void writev(
+    int handleId,
+    std::vector<WriteBuffer> buffers,
+    std::function<void(int)> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void setWriteBehind(
+    int handleId,
+    size_t highWaterMark,
+    size_t lowWaterMark
+  ) override;
+
+  void setCompression(
+    int handleId,
+    const std::string& format,
+    std::optional<int> level,
+    std::optional<int> windowBits
+  ) override;
+
+  void flush(
+    int handleId,
+    std::function<void()> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void close(int handleId) override;
+
+  void startDownload(
+    int handleId,
+    const DownloadConfig& config,
+    std::function<void(double, double, double)> onProgress,
+    std::function<void()> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void cancelDownload(int handleId) override;
+
+  std::string downloadUrl(int handleId) override;
+
+  void readChunks(
+    int handleId,
+    size_t maxChunks,
+    size_t maxBytes,
+    std::function<void(std::vector<ChunkBuffer>)> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void readAt(
+    int handleId,
+    int64_t offset,
+    size_t length,
+    std::function<void(ChunkBuffer)> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void setReadAhead(int handleId, int depth) override;
+
+  void setDecompression(
+    int handleId,
+    const std::string& format,
+    std::optional<int> windowBits
+  ) override;
+
+  int openMapped(const std::string& path) override;
+  std::shared_ptr<MappedFile> getMapping(int handleId) override;
+
+  void hashFile(
+    const std::string& path,
+    const std::string& algorithm,
+    std::function<void(std::string)> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  void hashFileTree(
+    const std::string& path,
+    const std::string& algorithm,
+    size_t chunkSize,
+    bool includeChunkDigests,
+    std::function<void(TreeHashResult)> onSuccess,
+    std::function<void(std::string)> onError
+  ) override;
+
+  int createHasher(const std::string& algorithm) override;
+  void updateHasher(int hasherId, const uint8_t* data, size_t size) override;
+  std::string digestHasher(int hasherId) override;
+  void attachHasher(int handleId, int hasherId) override;
+
+  ReaderInfo getReaderInfo(int handleId) override;
+  WriterInfo getWriterInfo(int handleId) override;
+
+protected:
+  void submitTask(std::function<void()> task);
+
+  /**
+   * Run `task` after earlier tasks for the same handle object, so
+   * sequential reads, writes and flushes on a handle complete in call
+   * order.
+   */
+  void submitOrdered(const void* handle, std::function<void()> task);
+
+private:
+  // Pool for read/write/flush/hashing (not downloads).
+  WorkerPool pool_;
+
+  // Read-ahead (see NativeReaderHandle::ReadAhead)
+  using PendingRead = NativeReaderHandle::ReadAhead::PendingRead;
+  void readAheadNext(const std::shared_ptr<NativeReaderHandle>& reader,
+                     PendingRead request);
+  void scheduleFillLocked(const std::shared_ptr<NativeReaderHandle>& reader);
+  void fillReadAhead(const std::shared_ptr<NativeReaderHandle>& reader);
+
+  // Write-behind (see NativeWriterHandle::WriteBehind)
+  void scheduleDrainLocked(const std::shared_ptr<NativeWriterHandle>& writer);
+  void drainWriteBehind(const std::shared_ptr<NativeWriterHandle>& writer);
+};
+
+} // namespace bufferedblob
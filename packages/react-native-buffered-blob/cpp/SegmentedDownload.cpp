@@ -0,0 +1,205 @@
+#include "SegmentedDownload.h"
+#include "DownloadResume.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+namespace bufferedblob {
+
+namespace {
+
+constexpr size_t kReadAllSize = 1024 * 1024;
+
+std::string ioError(const char* what, int err) {
+  return std::string("[IO_ERROR] ") + what + ": " + std::strerror(err);
+}
+
+int openDestination(const std::string& path) {
+  int fd;
+  do {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    throw std::runtime_error(ioError("Failed to open destination", errno) + ": " + path);
+  }
+  return fd;
+}
+
+// Reserve the blocks up front so out-of-order writes do not fragment the
+// file and a full disk fails before anything is downloaded.
+void preallocate(int fd, int64_t size) {
+#if defined(__APPLE__)
+  fstore_t store{F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0};
+  if (::fcntl(fd, F_PREALLOCATE, &store) == -1) {
+    store.fst_flags = F_ALLOCATEALL;
+    ::fcntl(fd, F_PREALLOCATE, &store);
+  }
+#elif defined(__linux__)
+  int err = ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+  if (err == ENOSPC) throw std::runtime_error(ioError("Failed to preallocate", err));
+#endif
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    throw std::runtime_error(ioError("Failed to preallocate", errno));
+  }
+}
+
+} // namespace
+
+int64_t SegmentedDownload::probeLength(int status, const std::string& contentRange) {
+  int64_t first, last, length;
+  if (status != 206 || !parseContentRange(contentRange, first, last, length)) return -1;
+  return first == 0 ? length : -1;
+}
+
+int SegmentedDownload::segmentCount(int64_t totalBytes, int maxSegments,
+                                    int64_t minSegmentSize) {
+  if (totalBytes <= 0 || maxSegments <= 1) return 1;
+  int64_t bySize = totalBytes / std::max(minSegmentSize, kMinSegmentSize);
+  return static_cast<int>(std::clamp<int64_t>(bySize, 1, std::min(maxSegments, kMaxSegments)));
+}
+
+SegmentedDownload::SegmentedDownload(const std::string& destPath, int64_t totalBytes,
+                                     int segments, std::string validator,
+                                     DownloadProgress& progress)
+    : fd_(openDestination(destPath)),
+      totalBytes_(totalBytes),
+      validator_(std::move(validator)),
+      progress_(progress) {
+  try {
+    preallocate(fd_, totalBytes_);
+  } catch (...) {
+    ::close(fd_);
+    throw;
+  }
+  // Equal shares; the first segments absorb the remainder.
+  int64_t base = totalBytes_ / segments;
+  int64_t extra = totalBytes_ % segments;
+  int64_t start = 0;
+  segments_.reserve(static_cast<size_t>(segments));
+  for (int i = 0; i < segments; ++i) {
+    int64_t size = base + (i < extra ? 1 : 0);
+    segments_.push_back(Segment{start, start + size});
+    start += size;
+  }
+  progress_.setTotal(totalBytes_);
+}
+
+SegmentedDownload::~SegmentedDownload() {
+  ::close(fd_);
+}
+
+std::string SegmentedDownload::rangeHeader(size_t index) const {
+  const Segment& segment = segments_[index];
+  return "bytes=" + std::to_string(segment.start + segment.received) + "-" +
+         std::to_string(segment.end - 1);
+}
+
+void SegmentedDownload::onResponse(size_t index, int status,
+                                   const std::string& contentRange) {
+  const Segment& segment = segments_[index];
+  int64_t first, last, length;
+  if (status != 206) {
+    throw std::runtime_error(
+        "[DOWNLOAD_FAILED] HTTP " + std::to_string(status) + " for segment " +
+        std::to_string(index));
+  }
+  if (!parseContentRange(contentRange, first, last, length) ||
+      first != segment.start + segment.received || last != segment.end - 1 ||
+      (length >= 0 && length != totalBytes_)) {
+    throw std::runtime_error(
+        "[DOWNLOAD_FAILED] Unexpected Content-Range for segment " +
+        std::to_string(index) + ": " + contentRange);
+  }
+}
+
+void SegmentedDownload::onData(size_t index, const uint8_t* data, size_t size) {
+  if (failed_.load(std::memory_order_relaxed)) {
+    throw std::runtime_error("[DOWNLOAD_FAILED] Another segment failed");
+  }
+  Segment& segment = segments_[index];
+  int64_t offset = segment.start + segment.received;
+  if (offset + static_cast<int64_t>(size) > segment.end) {
+    throw std::runtime_error(
+        "[DOWNLOAD_FAILED] Server sent more than segment " + std::to_string(index));
+  }
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = ::pwrite(fd_, data + done, size - done,
+                         static_cast<off_t>(offset) + static_cast<off_t>(done));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error(ioError("Write failed", errno));
+    }
+    done += static_cast<size_t>(n);
+  }
+  segment.received += static_cast<int64_t>(size);
+  progress_.add(size);
+}
+
+void SegmentedDownload::run(const std::function<void(size_t)>& fetch) {
+  std::vector<std::thread> workers;
+  workers.reserve(segments_.size() - 1);
+  for (size_t i = 1; i < segments_.size(); ++i) {
+    workers.emplace_back([this, &fetch, i] { runSegment(i, fetch); });
+  }
+  runSegment(0, fetch);
+  for (auto& worker : workers) worker.join();
+
+  std::lock_guard<std::mutex> lock(errorMutex_);
+  if (failed_) throw std::runtime_error(error_);
+}
+
+void SegmentedDownload::runSegment(size_t index, const std::function<void(size_t)>& fetch) {
+  Segment& segment = segments_[index];
+  int failures = 0;
+  while (segment.received < segment.end - segment.start) {
+    if (failed_) return;
+    int64_t before = segment.received;
+    std::string error;
+    try {
+      fetch(index);
+      if (segment.received == segment.end - segment.start) return;
+      error = "[DOWNLOAD_FAILED] Segment " + std::to_string(index) +
+              " ended early";
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+    if (failed_) return;
+    // Progress earns a fresh set of attempts.
+    failures = segment.received > before ? 1 : failures + 1;
+    if (error.rfind("[DOWNLOAD_CANCELLED]", 0) == 0 || failures >= kMaxAttempts) {
+      fail(std::move(error));
+      return;
+    }
+  }
+}
+
+void SegmentedDownload::fail(std::string error) {
+  std::lock_guard<std::mutex> lock(errorMutex_);
+  if (!failed_) error_ = std::move(error);
+  failed_ = true;
+}
+
+void SegmentedDownload::readAll(
+    const std::function<void(const uint8_t*, size_t)>& sink) const {
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[kReadAllSize]);
+  int64_t offset = 0;
+  while (offset < totalBytes_) {
+    size_t want = static_cast<size_t>(std::min<int64_t>(totalBytes_ - offset, kReadAllSize));
+    ssize_t n = ::pread(fd_, buffer.get(), want, static_cast<off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error(ioError("Read failed", errno));
+    }
+    if (n == 0) throw std::runtime_error("[IO_ERROR] Download was truncated");
+    sink(buffer.get(), static_cast<size_t>(n));
+    offset += n;
+  }
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "DownloadProgress.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * A download split into byte ranges that are fetched concurrently and
+ * written into place in a preallocated destination file.
+ *
+ * The platform first probes the URL with `Range: bytes=0-0`; a 206 that
+ * reports the full length (see probeLength()) means the server can serve
+ * ranges. run() then calls the platform's blocking `fetch(index)` for
+ * every segment on its own thread. fetch() requests rangeHeader(index)
+ * (with If-Range: validator() when there is one), hands the response to
+ * onResponse() and the body to onData(), and throws on failure. A segment
+ * that fails is retried from where it stopped, up to kMaxAttempts times
+ * in a row without progress, while the others keep going.
+ *
+ * Each segment's counters are only touched by its fetch (and the
+ * callbacks it waits for); writes use pwrite() on a shared descriptor
+ * and progress is shared.
+ */
+class SegmentedDownload {
+public:
+  static constexpr int kMaxSegments = 16;
+  static constexpr int64_t kMinSegmentSize = 64 * 1024;
+  static constexpr int kMaxAttempts = 3;
+
+  /**
+   * Length of the resource from the probe response, or -1 when it did not
+   * come back as a 206 with a known length.
+   */
+  static int64_t probeLength(int status, const std::string& contentRange);
+
+  /**
+   * Number of segments for `totalBytes`: at most `maxSegments`, each at
+   * least `minSegmentSize` long. 1 means a segmented download is pointless.
+   */
+  static int segmentCount(int64_t totalBytes, int maxSegments, int64_t minSegmentSize);
+
+  /**
+   * Create (or truncate) destPath and preallocate `totalBytes`. Throws
+   * std::runtime_error with "[IO_ERROR] ..." on failure.
+   */
+  SegmentedDownload(const std::string& destPath, int64_t totalBytes, int segments,
+                    std::string validator, DownloadProgress& progress);
+  ~SegmentedDownload();
+
+  SegmentedDownload(const SegmentedDownload&) = delete;
+  SegmentedDownload& operator=(const SegmentedDownload&) = delete;
+
+  size_t segmentCount() const { return segments_.size(); }
+
+  /** If-Range value for segment requests, or empty. */
+  const std::string& validator() const { return validator_; }
+
+  /** Range header value for what segment `index` still needs. */
+  std::string rangeHeader(size_t index) const;
+
+  /**
+   * Throws std::runtime_error with "[DOWNLOAD_FAILED] ..." unless the
+   * response is a 206 for exactly the remaining part of the segment.
+   */
+  void onResponse(size_t index, int status, const std::string& contentRange);
+
+  /**
+   * Write received bytes into place. Throws if they overrun the segment,
+   * on I/O errors, or once another segment has failed for good.
+   */
+  void onData(size_t index, const uint8_t* data, size_t size);
+
+  /**
+   * Fetch all segments and return once they are complete. Throws the
+   * first error that could not be retried; cancellation
+   * ("[DOWNLOAD_CANCELLED] ...") is never retried.
+   */
+  void run(const std::function<void(size_t)>& fetch);
+
+  /** Pass the assembled file to `sink` in order, e.g. for a hasher. */
+  void readAll(const std::function<void(const uint8_t*, size_t)>& sink) const;
+
+private:
+  struct Segment {
+    int64_t start;
+    int64_t end; // exclusive
+    int64_t received{0};
+  };
+
+  void runSegment(size_t index, const std::function<void(size_t)>& fetch);
+  void fail(std::string error);
+
+  const int fd_;
+  const int64_t totalBytes_;
+  const std::string validator_;
+  DownloadProgress& progress_;
+  std::vector<Segment> segments_;
+
+  std::atomic<bool> failed_{false};
+  std::mutex errorMutex_;
+  std::string error_;
+};
+
+} // namespace bufferedblob
@@ -0,0 +1,270 @@
+#include "Hasher.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BUFFEREDBLOB_SHA256_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+// On Android/Linux this file is compiled with +crypto (see CMakeLists.txt)
+// and the instructions are only executed after a runtime check.
+#define BUFFEREDBLOB_SHA256_ARM 1
+#include <arm_neon.h>
+#endif
+
+namespace bufferedblob {
+
+namespace {
+
+alignas(16) const uint32_t kK[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+using BlockFunction = void (*)(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+inline uint32_t rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t loadBE32(const uint8_t* p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+         (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+void blocksPortable(uint32_t state[8], const uint8_t* data, size_t blocks) {
+  uint32_t w[64];
+  while (blocks--) {
+    for (int i = 0; i < 16; ++i) w[i] = loadBE32(data + i * 4);
+#pragma GCC unroll 16
+    for (int i = 16; i < 64; ++i) {
+      uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+#pragma GCC unroll 64
+    for (int i = 0; i < 64; ++i) {
+      uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = h + s1 + ch + kK[i] + w[i];
+      uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = s0 + maj;
+      h = g; g = f; f = e; e = d + t1;
+      d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    data += 64;
+  }
+}
+
+#if BUFFEREDBLOB_SHA256_X86
+
+#define SHA_NI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+SHA_NI_TARGET inline __m128i shaNiLoad(const uint8_t* data, __m128i byteSwap) {
+  return _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byteSwap);
+}
+
+// Four rounds: sha256rnds2 consumes two message words per call.
+SHA_NI_TARGET inline void shaNiQuadRound(__m128i& abef, __m128i& cdgh,
+                                         __m128i w, int group) {
+  __m128i wk = _mm_add_epi32(
+      w, _mm_load_si128(reinterpret_cast<const __m128i*>(kK + group * 4)));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0E));
+}
+
+// W[t..t+3] from W[t-16..t-1], passed as four consecutive groups.
+SHA_NI_TARGET inline __m128i shaNiSchedule(__m128i w0, __m128i w1,
+                                           __m128i w2, __m128i w3) {
+  __m128i t = _mm_sha256msg1_epu32(w0, w1);
+  t = _mm_add_epi32(t, _mm_alignr_epi8(w3, w2, 4));
+  return _mm_sha256msg2_epu32(t, w3);
+}
+
+SHA_NI_TARGET void blocksShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+  const __m128i byteSwap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // Rearrange ABCD/EFGH into the ABEF/CDGH layout sha256rnds2 expects.
+  __m128i tmp = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+  __m128i cdgh = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+  __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+  cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+  while (blocks--) {
+    __m128i abefSave = abef;
+    __m128i cdghSave = cdgh;
+
+    __m128i w0 = shaNiLoad(data, byteSwap);
+    __m128i w1 = shaNiLoad(data + 16, byteSwap);
+    __m128i w2 = shaNiLoad(data + 32, byteSwap);
+    __m128i w3 = shaNiLoad(data + 48, byteSwap);
+    shaNiQuadRound(abef, cdgh, w0, 0);
+    shaNiQuadRound(abef, cdgh, w1, 1);
+    shaNiQuadRound(abef, cdgh, w2, 2);
+    shaNiQuadRound(abef, cdgh, w3, 3);
+    for (int group = 4; group < 16; group += 4) {
+      w0 = shaNiSchedule(w0, w1, w2, w3);
+      shaNiQuadRound(abef, cdgh, w0, group);
+      w1 = shaNiSchedule(w1, w2, w3, w0);
+      shaNiQuadRound(abef, cdgh, w1, group + 1);
+      w2 = shaNiSchedule(w2, w3, w0, w1);
+      shaNiQuadRound(abef, cdgh, w2, group + 2);
+      w3 = shaNiSchedule(w3, w0, w1, w2);
+      shaNiQuadRound(abef, cdgh, w3, group + 3);
+    }
+
+    abef = _mm_add_epi32(abef, abefSave);
+    cdgh = _mm_add_epi32(cdgh, cdghSave);
+    data += 64;
+  }
+
+  tmp = _mm_shuffle_epi32(abef, 0x1B);
+  cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state),
+                   _mm_blend_epi16(tmp, cdgh, 0xF0));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4),
+                   _mm_alignr_epi8(cdgh, tmp, 8));
+}
+
+#endif // BUFFEREDBLOB_SHA256_X86
+
+#if BUFFEREDBLOB_SHA256_ARM
+
+inline void armQuadRound(uint32x4_t& abcd, uint32x4_t& efgh,
+                         uint32x4_t w, int group) {
+  uint32x4_t wk = vaddq_u32(w, vld1q_u32(kK + group * 4));
+  uint32x4_t abcdSave = abcd;
+  abcd = vsha256hq_u32(abcd, efgh, wk);
+  efgh = vsha256h2q_u32(efgh, abcdSave, wk);
+}
+
+inline uint32x4_t armSchedule(uint32x4_t w0, uint32x4_t w1,
+                              uint32x4_t w2, uint32x4_t w3) {
+  return vsha256su1q_u32(vsha256su0q_u32(w0, w1), w2, w3);
+}
+
+void blocksArm(uint32_t state[8], const uint8_t* data, size_t blocks) {
+  uint32x4_t abcd = vld1q_u32(state);
+  uint32x4_t efgh = vld1q_u32(state + 4);
+
+  while (blocks--) {
+    uint32x4_t abcdSave = abcd;
+    uint32x4_t efghSave = efgh;
+
+    uint32x4_t w0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+    uint32x4_t w1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+    uint32x4_t w2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+    uint32x4_t w3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+    armQuadRound(abcd, efgh, w0, 0);
+    armQuadRound(abcd, efgh, w1, 1);
+    armQuadRound(abcd, efgh, w2, 2);
+    armQuadRound(abcd, efgh, w3, 3);
+    for (int group = 4; group < 16; group += 4) {
+      w0 = armSchedule(w0, w1, w2, w3);
+      armQuadRound(abcd, efgh, w0, group);
+      w1 = armSchedule(w1, w2, w3, w0);
+      armQuadRound(abcd, efgh, w1, group + 1);
+      w2 = armSchedule(w2, w3, w0, w1);
+      armQuadRound(abcd, efgh, w2, group + 2);
+      w3 = armSchedule(w3, w0, w1, w2);
+      armQuadRound(abcd, efgh, w3, group + 3);
+    }
+
+    abcd = vaddq_u32(abcd, abcdSave);
+    efgh = vaddq_u32(efgh, efghSave);
+    data += 64;
+  }
+
+  vst1q_u32(state, abcd);
+  vst1q_u32(state + 4, efgh);
+}
+
+#endif // BUFFEREDBLOB_SHA256_ARM
+
+BlockFunction selectBlockFunction() {
+#if BUFFEREDBLOB_SHA256_X86
+  if (cpuHasSha256Instructions()) return blocksShaNi;
+#elif BUFFEREDBLOB_SHA256_ARM
+  if (cpuHasSha256Instructions()) return blocksArm;
+#endif
+  return blocksPortable;
+}
+
+class Sha256Hasher : public Hasher {
+public:
+  void update(const uint8_t* data, size_t size) override {
+    totalBytes_ += size;
+    if (bufferedSize_ > 0) {
+      size_t take = std::min(size, sizeof(buffer_) - bufferedSize_);
+      std::memcpy(buffer_ + bufferedSize_, data, take);
+      bufferedSize_ += take;
+      data += take;
+      size -= take;
+      if (bufferedSize_ < sizeof(buffer_)) return;
+      blocks_(state_, buffer_, 1);
+      bufferedSize_ = 0;
+    }
+    if (size >= 64) {
+      size_t blocks = size / 64;
+      blocks_(state_, data, blocks);
+      data += blocks * 64;
+      size -= blocks * 64;
+    }
+    std::memcpy(buffer_, data, size);
+    bufferedSize_ = size;
+  }
+
+  std::vector<uint8_t> digest() override {
+    uint64_t bitLength = totalBytes_ * 8;
+    uint8_t padding[72] = {0x80};
+    size_t padLength = (bufferedSize_ < 56 ? 56 : 120) - bufferedSize_;
+    for (int i = 0; i < 8; ++i) {
+      padding[padLength + i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+    }
+    update(padding, padLength + 8);
+
+    std::vector<uint8_t> out(32);
+    for (int i = 0; i < 8; ++i) {
+      out[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+      out[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+      out[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+      out[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+    }
+    return out;
+  }
+
+private:
+  uint32_t state_[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+  uint8_t buffer_[64];
+  size_t bufferedSize_ = 0;
+  uint64_t totalBytes_ = 0;
+  BlockFunction blocks_ = selectBlockFunction();
+};
+
+} // namespace
+
+std::unique_ptr<Hasher> createSha256Hasher() {
+  return std::make_unique<Sha256Hasher>();
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,164 @@
+#include "TreeHash.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace bufferedblob {
+
+namespace {
+
+// Per-thread read size; chunks larger than this are hashed piecewise.
+constexpr size_t kReadSize = 1024 * 1024;
+constexpr size_t kBlake3ChunkLength = 1024;
+
+bool isPowerOfTwo(size_t value) {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+std::vector<uint8_t> sha256Parent(const std::vector<uint8_t>& left,
+                                  const std::vector<uint8_t>& right) {
+  static const uint8_t kNodePrefix = 0x01;
+  auto hasher = createSha256Hasher();
+  hasher->update(&kNodePrefix, 1);
+  hasher->update(left.data(), left.size());
+  hasher->update(right.data(), right.size());
+  return hasher->digest();
+}
+
+std::vector<uint8_t> merkleRoot(const std::vector<std::vector<uint8_t>>& leaves,
+                                size_t begin, size_t end) {
+  if (end - begin == 1) return leaves[begin];
+  size_t split = 1;
+  while (split * 2 < end - begin) split *= 2;
+  return sha256Parent(merkleRoot(leaves, begin, begin + split),
+                      merkleRoot(leaves, begin + split, end));
+}
+
+} // namespace
+
+bool TreeHashJob::isSupported(const std::string& algorithm) {
+  return algorithm == "blake3" || algorithm == "sha256";
+}
+
+TreeHashJob::TreeHashJob(int fd, int64_t fileSize, const std::string& algorithm,
+                         size_t chunkSize, bool includeChunkDigests)
+    : fd_(fd),
+      fileSize_(fileSize),
+      blake3_(algorithm == "blake3"),
+      chunkSize_(chunkSize),
+      includeChunkDigests_(includeChunkDigests),
+      // An empty file is still one (empty) chunk.
+      chunkCount_(fileSize > 0
+                      ? static_cast<size_t>((fileSize + static_cast<int64_t>(chunkSize) - 1) /
+                                            static_cast<int64_t>(chunkSize))
+                      : 1) {
+  if (!isSupported(algorithm)) {
+    ::close(fd);
+    throw std::invalid_argument(
+        "[INVALID_ARGUMENT] Tree hashing supports blake3 and sha256, got: " + algorithm);
+  }
+  if (chunkSize < kMinChunkSize || chunkSize > kMaxChunkSize || !isPowerOfTwo(chunkSize)) {
+    ::close(fd);
+    throw std::invalid_argument(
+        "[INVALID_ARGUMENT] chunkSize must be a power of two from " +
+        std::to_string(kMinChunkSize) + " to " + std::to_string(kMaxChunkSize) +
+        ": " + std::to_string(chunkSize));
+  }
+  if (blake3_) {
+    blake3Nodes_.resize(chunkCount_);
+  } else {
+    sha256Digests_.resize(chunkCount_);
+  }
+}
+
+TreeHashJob::~TreeHashJob() {
+  ::close(fd_);
+}
+
+void TreeHashJob::run() {
+  std::unique_ptr<uint8_t[]> buffer;
+  size_t bufferSize = std::min(kReadSize, chunkSize_);
+  while (!failed_) {
+    size_t index = nextChunk_.fetch_add(1);
+    if (index >= chunkCount_) return;
+    if (!buffer) buffer.reset(new uint8_t[bufferSize]);
+    if (!hashChunk(index, buffer.get(), bufferSize)) return;
+  }
+}
+
+bool TreeHashJob::hashChunk(size_t index, uint8_t* buffer, size_t bufferSize) {
+  int64_t offset = static_cast<int64_t>(index) * static_cast<int64_t>(chunkSize_);
+  int64_t end = std::min(offset + static_cast<int64_t>(chunkSize_), fileSize_);
+
+  std::unique_ptr<Blake3RangeHasher> blake3;
+  std::unique_ptr<Hasher> sha256;
+  Hasher* hasher;
+  if (blake3_) {
+    blake3 = createBlake3RangeHasher(static_cast<uint64_t>(offset) / kBlake3ChunkLength);
+    hasher = blake3.get();
+  } else {
+    sha256 = createSha256Hasher();
+    hasher = sha256.get();
+  }
+
+  while (offset < end) {
+    size_t want = static_cast<size_t>(std::min<int64_t>(end - offset, bufferSize));
+    ssize_t n = ::pread(fd_, buffer, want, static_cast<off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      fail(std::string("[IO_ERROR] ") + std::strerror(errno));
+      return false;
+    }
+    if (n == 0) {
+      fail("[IO_ERROR] File was truncated while hashing");
+      return false;
+    }
+    hasher->update(buffer, static_cast<size_t>(n));
+    offset += n;
+  }
+
+  if (blake3_) {
+    blake3Nodes_[index] = blake3->node();
+  } else {
+    sha256Digests_[index] = sha256->digest();
+  }
+  return true;
+}
+
+void TreeHashJob::fail(std::string error) {
+  std::lock_guard<std::mutex> lock(errorMutex_);
+  if (error_.empty()) error_ = std::move(error);
+  failed_ = true;
+}
+
+TreeHashResult TreeHashJob::finish() {
+  {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    if (failed_) throw std::runtime_error(error_);
+  }
+
+  TreeHashResult result;
+  if (blake3_) {
+    result.digest = toHex(blake3CombineRanges(blake3Nodes_));
+    if (includeChunkDigests_) {
+      result.chunkDigests.reserve(chunkCount_);
+      for (const auto& node : blake3Nodes_) {
+        result.chunkDigests.push_back(toHex(blake3ChainingValue(node)));
+      }
+    }
+  } else {
+    result.digest = toHex(merkleRoot(sha256Digests_, 0, sha256Digests_.size()));
+    if (includeChunkDigests_) {
+      result.chunkDigests.reserve(chunkCount_);
+      for (const auto& digest : sha256Digests_) {
+        result.chunkDigests.push_back(toHex(digest));
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace bufferedblob
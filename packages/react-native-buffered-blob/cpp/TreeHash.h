@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Hasher.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bufferedblob {
+
+struct TreeHashResult {
+  /** Lowercase hex root digest. */
+  std::string digest;
+  /** Per-chunk hex digests, in file order (empty unless requested). */
+  std::vector<std::string> chunkDigests;
+};
+
+/**
+ * Parallel hash of a file split into fixed-size chunks. Each chunk is read
+ * with pread and hashed independently, so any number of threads can call
+ * run() at once; finish() combines the chunk results once they all return.
+ *
+ * Algorithms:
+ *   blake3 - the standard BLAKE3 hash of the file (chunkSize must be a
+ *            power of two >= 1KB). Chunk digests are the chaining values
+ *            of each chunk's subtree.
+ *   sha256 - Merkle root over SHA-256 chunk digests: interior nodes are
+ *            SHA-256(0x01 || left || right), split at the largest power
+ *            of two below the node count as in RFC 6962. A single-chunk
+ *            file hashes to its plain SHA-256.
+ *
+ * Chunk digests let a later run with the same chunkSize locate damaged
+ * ranges without rehashing against a trusted copy of the whole file.
+ */
+class TreeHashJob {
+public:
+  static constexpr size_t kMinChunkSize = 16384;
+  static constexpr size_t kMaxChunkSize = 67108864; // 64MB
+
+  /**
+   * Takes ownership of `fd`. Throws std::invalid_argument with
+   * "[INVALID_ARGUMENT] ..." for unsupported algorithms or chunk sizes.
+   */
+  TreeHashJob(int fd, int64_t fileSize, const std::string& algorithm,
+              size_t chunkSize, bool includeChunkDigests);
+  ~TreeHashJob();
+
+  TreeHashJob(const TreeHashJob&) = delete;
+  TreeHashJob& operator=(const TreeHashJob&) = delete;
+
+  static bool isSupported(const std::string& algorithm);
+
+  size_t chunkCount() const { return chunkCount_; }
+
+  /** Hash unclaimed chunks until none are left or an error occurs. */
+  void run();
+
+  /**
+   * Combine the chunk results. Call once, after every run() has returned.
+   * Throws std::runtime_error carrying the first read error.
+   */
+  TreeHashResult finish();
+
+private:
+  bool hashChunk(size_t index, uint8_t* buffer, size_t bufferSize);
+  void fail(std::string error);
+
+  const int fd_;
+  const int64_t fileSize_;
+  const bool blake3_;
+  const size_t chunkSize_;
+  const bool includeChunkDigests_;
+  const size_t chunkCount_;
+
+  std::atomic<size_t> nextChunk_{0};
+  std::atomic<bool> failed_{false};
+  std::mutex errorMutex_;
+  std::string error_;
+
+  // One slot per chunk, written by whichever thread hashed it.
+  std::vector<Blake3Node> blake3Nodes_;
+  std::vector<std::vector<uint8_t>> sha256Digests_;
+};
+
+} // namespace bufferedblob
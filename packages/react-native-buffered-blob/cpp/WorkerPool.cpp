@@ -0,0 +1,163 @@
+#include "WorkerPool.h"
+#include "OperationTrace.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace bufferedblob {
+
+namespace {
+
+// Which pool and worker the current thread belongs to, so tasks submitted
+// from a worker stay on its deque.
+thread_local const WorkerPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+thread_local const WorkerPool::TaskTiming* currentTiming = nullptr;
+
+} // namespace
+
+size_t WorkerPool::defaultThreadCount() {
+  return std::max<size_t>(kMinThreads, std::thread::hardware_concurrency());
+}
+
+WorkerPool::WorkerPool(size_t threads, ThreadRunner threadRunner) {
+  threads = std::max<size_t>(threads, 1);
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (size_t i = 0; i < threads; ++i) {
+    workers_[i]->thread = std::thread([this, i, threadRunner]() {
+      auto loop = [this, i]() { runWorker(i); };
+      if (threadRunner) {
+        threadRunner(loop);
+      } else {
+        loop();
+      }
+    });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    shutdown_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker->thread.joinable()) worker->thread.join();
+  }
+}
+
+const WorkerPool::TaskTiming* WorkerPool::currentTask() {
+  return currentTiming;
+}
+
+void WorkerPool::submit(Task task) {
+  push(std::move(task), Clock::now());
+}
+
+void WorkerPool::submit(const void* lane, Task task) {
+  auto now = Clock::now();
+  auto& shard = shardFor(lane);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& tasks = shard.lanes[lane].tasks;
+    tasks.push_back(QueuedTask{std::move(task), now});
+    // A lane with earlier tasks is already scheduled and picks this up.
+    if (tasks.size() > 1) return;
+  }
+  push([this, lane]() { runLane(lane); }, now);
+}
+
+void WorkerPool::push(Task task, Clock::time_point submitted) {
+  size_t index = currentPool == this
+                     ? currentWorker
+                     : nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(QueuedTask{std::move(task), submitted});
+    queued_.fetch_add(1);
+  }
+  // Taking the lock orders the increment before a sleeper's predicate check.
+  { std::lock_guard<std::mutex> lock(sleepMutex_); }
+  wake_.notify_one();
+}
+
+bool WorkerPool::take(size_t index, QueuedTask& task) {
+  // Own deque first, oldest task first.
+  {
+    auto& own = *workers_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      queued_.fetch_sub(1);
+      return true;
+    }
+  }
+  // Then steal the newest task of another worker.
+  for (size_t offset = 1; offset < workers_.size(); ++offset) {
+    auto& victim = *workers_[(index + offset) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      queued_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkerPool::runWorker(size_t index) {
+  currentPool = this;
+  currentWorker = index;
+  while (true) {
+    QueuedTask task;
+    if (take(index, task)) {
+      TraceTaskSection section;
+      TaskTiming timing{task.submitted, Clock::now()};
+      currentTiming = &timing;
+      task.task();
+      currentTiming = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    wake_.wait(lock, [this]() { return shutdown_ || queued_.load() > 0; });
+    if (shutdown_ && queued_.load() == 0) return;
+  }
+}
+
+void WorkerPool::runLane(const void* lane) {
+  auto& shard = shardFor(lane);
+  QueuedTask task;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    task = std::move(shard.lanes[lane].tasks.front());
+  }
+  TaskTiming timing{task.submitted, Clock::now()};
+  const TaskTiming* outer = currentTiming;
+  currentTiming = &timing;
+  task.task();
+  currentTiming = outer;
+  task.task = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.lanes.find(lane);
+    it->second.tasks.pop_front();
+    if (it->second.tasks.empty()) {
+      shard.lanes.erase(it);
+      return;
+    }
+  }
+  // Back of the queue, behind whatever other lanes are waiting.
+  push([this, lane]() { runLane(lane); }, Clock::now());
+}
+
+WorkerPool::LaneShard& WorkerPool::shardFor(const void* lane) {
+  auto key = reinterpret_cast<uintptr_t>(lane);
+  return laneShards_[(key >> 4 ^ key >> 12) % kLaneShards];
+}
+
+} // namespace bufferedblob
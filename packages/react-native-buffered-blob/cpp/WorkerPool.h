@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bufferedblob {
+
+/**
+ * Work-stealing thread pool with per-handle ordered lanes.
+ *
+ * Every worker owns a task deque. Tasks submitted from a worker go to its
+ * own deque, others are spread round-robin; a worker with nothing to do
+ * steals from the back of another's deque, so no single lock is shared by
+ * all submitters.
+ *
+ * submit(lane, task) runs tasks of the same lane one at a time in
+ * submission order, so they also complete in that order. A lane runs one
+ * task per turn and then goes to the back of its worker's deque, which
+ * keeps a busy handle from holding back a quiet one. Lanes exist only
+ * while they have tasks; the key is typically the handle object, kept
+ * alive by the tasks that reference it.
+ *
+ * Tasks must not throw. The destructor runs every queued task before
+ * joining the workers.
+ */
+class WorkerPool {
+public:
+  using Task = std::function<void()>;
+  /** Wraps each worker's loop, e.g. to attach the thread to a runtime. */
+  using ThreadRunner = std::function<void(const std::function<void()>&)>;
+  using Clock = std::chrono::steady_clock;
+
+  /** When the task running on a worker was submitted and when it started. */
+  struct TaskTiming {
+    Clock::time_point submitted;
+    Clock::time_point started;
+  };
+
+  /** One worker per core, and at least this many so blocking I/O overlaps. */
+  static constexpr size_t kMinThreads = 4;
+
+  static size_t defaultThreadCount();
+
+  explicit WorkerPool(size_t threads = defaultThreadCount(),
+                      ThreadRunner threadRunner = nullptr);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  size_t size() const { return workers_.size(); }
+
+  /** Run `task` on any worker, unordered with respect to other tasks. */
+  void submit(Task task);
+
+  /** Run `task` after every earlier task submitted to `lane`. */
+  void submit(const void* lane, Task task);
+
+  /**
+   * Timing of the task the calling thread is running, or null outside
+   * pool tasks. For lane tasks, `submitted` is when the task joined its
+   * lane.
+   */
+  static const TaskTiming* currentTask();
+
+private:
+  struct QueuedTask {
+    Task task;
+    Clock::time_point submitted;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<QueuedTask> tasks;
+    std::thread thread;
+  };
+
+  struct Lane {
+    std::deque<QueuedTask> tasks;
+  };
+
+  // Lanes are sharded by key so unrelated handles rarely share a lock.
+  static constexpr size_t kLaneShards = 16;
+  struct LaneShard {
+    std::mutex mutex;
+    std::unordered_map<const void*, Lane> lanes;
+  };
+
+  void push(Task task, Clock::time_point submitted);
+  bool take(size_t index, QueuedTask& task);
+  void runWorker(size_t index);
+  void runLane(const void* lane);
+  LaneShard& shardFor(const void* lane);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::array<LaneShard, kLaneShards> laneShards_;
+  std::atomic<size_t> nextWorker_{0};
+  // Tasks sitting in worker deques; workers sleep while it is zero.
+  std::atomic<size_t> queued_{0};
+  std::mutex sleepMutex_;
+  std::condition_variable wake_;
+  bool shutdown_{false};
+};
+
+} // namespace bufferedblob
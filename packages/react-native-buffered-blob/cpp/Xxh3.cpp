@@ -0,0 +1,404 @@
+#include "Hasher.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#define BUFFEREDBLOB_XXH3_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define BUFFEREDBLOB_XXH3_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace bufferedblob {
+
+namespace {
+
+// XXH3 64-bit with the default secret and seed 0, following the reference
+// streaming implementation (xxhash.h v0.8).
+
+constexpr uint32_t kPrime32_1 = 0x9E3779B1U;
+constexpr uint32_t kPrime32_2 = 0x85EBCA77U;
+constexpr uint32_t kPrime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t kPrimeMx1 = 0x165667919E3779F9ULL;
+constexpr uint64_t kPrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t kStripeLength = 64;
+constexpr size_t kSecretSize = 192;
+constexpr size_t kSecretConsumeRate = 8;
+constexpr size_t kSecretLimit = kSecretSize - kStripeLength;
+constexpr size_t kStripesPerBlock = kSecretLimit / kSecretConsumeRate;
+constexpr size_t kSecretLastAccStart = 7;
+constexpr size_t kSecretMergeAccsStart = 11;
+constexpr size_t kMidSizeMax = 240;
+constexpr size_t kInternalBufferSize = 256;
+
+alignas(64) const uint8_t kSecret[kSecretSize] = {
+  0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+  0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+  0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+  0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+  0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+  0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+  0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+  0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+  0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+  0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+  0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+  0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline uint32_t read32(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap32(value);
+#endif
+  return value;
+}
+
+inline uint64_t read64(const uint8_t* p) {
+  uint64_t value;
+  std::memcpy(&value, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap64(value);
+#endif
+  return value;
+}
+
+inline uint64_t rotl64(uint64_t x, int n) {
+  return (x << n) | (x >> (64 - n));
+}
+
+inline uint64_t mul128Fold64(uint64_t lhs, uint64_t rhs) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+  // 32-bit targets: schoolbook multiply from 32x32->64 partial products.
+  uint64_t loLo = (lhs & 0xFFFFFFFFULL) * (rhs & 0xFFFFFFFFULL);
+  uint64_t hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFFULL);
+  uint64_t loHi = (lhs & 0xFFFFFFFFULL) * (rhs >> 32);
+  uint64_t hiHi = (lhs >> 32) * (rhs >> 32);
+  uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFFULL) + loHi;
+  uint64_t upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+  uint64_t lower = (cross << 32) | (loLo & 0xFFFFFFFFULL);
+  return lower ^ upper;
+#endif
+}
+
+inline uint64_t xxh64Avalanche(uint64_t h) {
+  h ^= h >> 33;
+  h *= kPrime64_2;
+  h ^= h >> 29;
+  h *= kPrime64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t avalanche(uint64_t h) {
+  h ^= h >> 37;
+  h *= kPrimeMx1;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t rrmxmx(uint64_t h, uint64_t length) {
+  h ^= rotl64(h, 49) ^ rotl64(h, 24);
+  h *= kPrimeMx2;
+  h ^= (h >> 35) + length;
+  h *= kPrimeMx2;
+  return h ^ (h >> 28);
+}
+
+inline uint64_t mix16B(const uint8_t* input, const uint8_t* secret) {
+  return mul128Fold64(read64(input) ^ read64(secret),
+                      read64(input + 8) ^ read64(secret + 8));
+}
+
+// --- Short inputs (<= 240 bytes) ---
+
+uint64_t hashShort(const uint8_t* input, size_t length) {
+  const uint8_t* secret = kSecret;
+  if (length == 0) {
+    return xxh64Avalanche(read64(secret + 56) ^ read64(secret + 64));
+  }
+  if (length <= 3) {
+    uint32_t combined = (uint32_t(input[0]) << 16) |
+                        (uint32_t(input[length >> 1]) << 24) |
+                        uint32_t(input[length - 1]) |
+                        (uint32_t(length) << 8);
+    uint64_t bitflip = read32(secret) ^ read32(secret + 4);
+    return xxh64Avalanche(uint64_t(combined) ^ bitflip);
+  }
+  if (length <= 8) {
+    uint64_t bitflip = read64(secret + 8) ^ read64(secret + 16);
+    uint64_t input64 = read32(input + length - 4) +
+                       (uint64_t(read32(input)) << 32);
+    return rrmxmx(input64 ^ bitflip, length);
+  }
+  if (length <= 16) {
+    uint64_t low = read64(input) ^ (read64(secret + 24) ^ read64(secret + 32));
+    uint64_t high = read64(input + length - 8) ^
+                    (read64(secret + 40) ^ read64(secret + 48));
+    uint64_t acc = length + __builtin_bswap64(low) + high + mul128Fold64(low, high);
+    return avalanche(acc);
+  }
+  if (length <= 128) {
+    uint64_t acc = length * kPrime64_1;
+    if (length > 32) {
+      if (length > 64) {
+        if (length > 96) {
+          acc += mix16B(input + 48, secret + 96);
+          acc += mix16B(input + length - 64, secret + 112);
+        }
+        acc += mix16B(input + 32, secret + 64);
+        acc += mix16B(input + length - 48, secret + 80);
+      }
+      acc += mix16B(input + 16, secret + 32);
+      acc += mix16B(input + length - 32, secret + 48);
+    }
+    acc += mix16B(input, secret);
+    acc += mix16B(input + length - 16, secret + 16);
+    return avalanche(acc);
+  }
+
+  constexpr size_t kMidSizeStartOffset = 3;
+  constexpr size_t kMidSizeLastOffset = 17;
+  uint64_t acc = length * kPrime64_1;
+  size_t rounds = length / 16;
+  for (size_t i = 0; i < 8; ++i) {
+    acc += mix16B(input + 16 * i, secret + 16 * i);
+  }
+  uint64_t accEnd = mix16B(input + length - 16, secret + 136 - kMidSizeLastOffset);
+  acc = avalanche(acc);
+  for (size_t i = 8; i < rounds; ++i) {
+    accEnd += mix16B(input + 16 * i, secret + 16 * (i - 8) + kMidSizeStartOffset);
+  }
+  return avalanche(acc + accEnd);
+}
+
+// --- Long inputs: 8 accumulator lanes over 64-byte stripes ---
+
+#if BUFFEREDBLOB_XXH3_SSE2
+
+void accumulate(uint64_t* acc, const uint8_t* input, const uint8_t* secret,
+                size_t stripes) {
+  __m128i lanes[4];
+  for (int i = 0; i < 4; ++i) {
+    lanes[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(acc) + i);
+  }
+  for (size_t n = 0; n < stripes; ++n) {
+    const uint8_t* in = input + n * kStripeLength;
+    const uint8_t* key = secret + n * kSecretConsumeRate;
+    for (int i = 0; i < 4; ++i) {
+      __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i);
+      __m128i keyed = _mm_xor_si128(
+          data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+      __m128i product = _mm_mul_epu32(
+          keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+      __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+      lanes[i] = _mm_add_epi64(product, _mm_add_epi64(lanes[i], swapped));
+    }
+  }
+  for (int i = 0; i < 4; ++i) {
+    _mm_store_si128(reinterpret_cast<__m128i*>(acc) + i, lanes[i]);
+  }
+}
+
+void scramble(uint64_t* acc, const uint8_t* secret) {
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(kPrime32_1));
+  for (int i = 0; i < 4; ++i) {
+    __m128i lane = _mm_load_si128(reinterpret_cast<const __m128i*>(acc) + i);
+    lane = _mm_xor_si128(lane, _mm_srli_epi64(lane, 47));
+    lane = _mm_xor_si128(
+        lane, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+    __m128i low = _mm_mul_epu32(lane, prime);
+    __m128i high = _mm_mul_epu32(
+        _mm_shuffle_epi32(lane, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+    _mm_store_si128(reinterpret_cast<__m128i*>(acc) + i,
+                    _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+  }
+}
+
+#elif BUFFEREDBLOB_XXH3_NEON
+
+void accumulate(uint64_t* acc, const uint8_t* input, const uint8_t* secret,
+                size_t stripes) {
+  uint64x2_t lanes[4];
+  for (int i = 0; i < 4; ++i) lanes[i] = vld1q_u64(acc + i * 2);
+  for (size_t n = 0; n < stripes; ++n) {
+    const uint8_t* in = input + n * kStripeLength;
+    const uint8_t* key = secret + n * kSecretConsumeRate;
+    for (int i = 0; i < 4; ++i) {
+      uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(in + i * 16));
+      uint64x2_t keyed = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(key + i * 16)));
+      uint64x2_t sum = vaddq_u64(lanes[i], vextq_u64(data, data, 1));
+      lanes[i] = vmlal_u32(sum, vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+    }
+  }
+  for (int i = 0; i < 4; ++i) vst1q_u64(acc + i * 2, lanes[i]);
+}
+
+void scramble(uint64_t* acc, const uint8_t* secret) {
+  const uint32x2_t prime = vdup_n_u32(kPrime32_1);
+  for (int i = 0; i < 4; ++i) {
+    uint64x2_t lane = vld1q_u64(acc + i * 2);
+    lane = veorq_u64(lane, vshrq_n_u64(lane, 47));
+    lane = veorq_u64(lane, vreinterpretq_u64_u8(vld1q_u8(secret + i * 16)));
+    uint64x2_t high = vshlq_n_u64(vmull_u32(vshrn_n_u64(lane, 32), prime), 32);
+    vst1q_u64(acc + i * 2, vmlal_u32(high, vmovn_u64(lane), prime));
+  }
+}
+
+#else
+
+void accumulate(uint64_t* acc, const uint8_t* input, const uint8_t* secret,
+                size_t stripes) {
+  for (size_t n = 0; n < stripes; ++n) {
+    const uint8_t* in = input + n * kStripeLength;
+    const uint8_t* key = secret + n * kSecretConsumeRate;
+    for (int i = 0; i < 8; ++i) {
+      uint64_t data = read64(in + i * 8);
+      uint64_t keyed = data ^ read64(key + i * 8);
+      acc[i ^ 1] += data;
+      acc[i] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+    }
+  }
+}
+
+void scramble(uint64_t* acc, const uint8_t* secret) {
+  for (int i = 0; i < 8; ++i) {
+    uint64_t lane = acc[i];
+    lane ^= lane >> 47;
+    lane ^= read64(secret + i * 8);
+    acc[i] = lane * kPrime32_1;
+  }
+}
+
+#endif
+
+// Feed `stripes` stripes, scrambling at each block boundary.
+// `stripesSoFar` is the position within the current block.
+const uint8_t* consumeStripes(uint64_t* acc, size_t& stripesSoFar,
+                              const uint8_t* input, size_t stripes) {
+  const uint8_t* secret = kSecret + stripesSoFar * kSecretConsumeRate;
+  if (stripes >= kStripesPerBlock - stripesSoFar) {
+    size_t stripesThisBlock = kStripesPerBlock - stripesSoFar;
+    do {
+      accumulate(acc, input, secret, stripesThisBlock);
+      scramble(acc, kSecret + kSecretLimit);
+      input += stripesThisBlock * kStripeLength;
+      stripes -= stripesThisBlock;
+      stripesThisBlock = kStripesPerBlock;
+      secret = kSecret;
+    } while (stripes >= kStripesPerBlock);
+    stripesSoFar = 0;
+  }
+  if (stripes > 0) {
+    accumulate(acc, input, secret, stripes);
+    input += stripes * kStripeLength;
+    stripesSoFar += stripes;
+  }
+  return input;
+}
+
+uint64_t mergeAccumulators(const uint64_t* acc, uint64_t start) {
+  const uint8_t* secret = kSecret + kSecretMergeAccsStart;
+  uint64_t result = start;
+  for (int i = 0; i < 4; ++i) {
+    result += mul128Fold64(acc[2 * i] ^ read64(secret + 16 * i),
+                           acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+  }
+  return avalanche(result);
+}
+
+class Xxh3Hasher : public Hasher {
+public:
+  void update(const uint8_t* input, size_t size) override {
+    if (size == 0) return;
+    const uint8_t* end = input + size;
+    totalLength_ += size;
+
+    if (size <= kInternalBufferSize - bufferedSize_) {
+      std::memcpy(buffer_ + bufferedSize_, input, size);
+      bufferedSize_ += size;
+      return;
+    }
+
+    if (bufferedSize_ > 0) {
+      size_t load = kInternalBufferSize - bufferedSize_;
+      std::memcpy(buffer_ + bufferedSize_, input, load);
+      input += load;
+      consumeStripes(acc_, stripesSoFar_, buffer_,
+                     kInternalBufferSize / kStripeLength);
+      bufferedSize_ = 0;
+    }
+
+    // Stream large input straight from the caller's memory, keeping at
+    // least one byte back so digest() always has a final stripe.
+    if (static_cast<size_t>(end - input) > kInternalBufferSize) {
+      size_t stripes = static_cast<size_t>(end - 1 - input) / kStripeLength;
+      input = consumeStripes(acc_, stripesSoFar_, input, stripes);
+      std::memcpy(buffer_ + kInternalBufferSize - kStripeLength,
+                  input - kStripeLength, kStripeLength);
+    }
+
+    bufferedSize_ = static_cast<size_t>(end - input);
+    std::memcpy(buffer_, input, bufferedSize_);
+  }
+
+  std::vector<uint8_t> digest() override {
+    uint64_t hash;
+    if (totalLength_ > kMidSizeMax) {
+      alignas(16) uint64_t acc[8];
+      std::memcpy(acc, acc_, sizeof(acc));
+      const uint8_t* lastStripe;
+      uint8_t catchup[kStripeLength];
+      if (bufferedSize_ >= kStripeLength) {
+        size_t stripes = (bufferedSize_ - 1) / kStripeLength;
+        size_t stripesSoFar = stripesSoFar_;
+        consumeStripes(acc, stripesSoFar, buffer_, stripes);
+        lastStripe = buffer_ + bufferedSize_ - kStripeLength;
+      } else {
+        // The tail of the buffer still holds the previous stripe's bytes.
+        size_t catchupSize = kStripeLength - bufferedSize_;
+        std::memcpy(catchup, buffer_ + kInternalBufferSize - catchupSize, catchupSize);
+        std::memcpy(catchup + catchupSize, buffer_, bufferedSize_);
+        lastStripe = catchup;
+      }
+      accumulate(acc, lastStripe, kSecret + kSecretLimit - kSecretLastAccStart, 1);
+      hash = mergeAccumulators(acc, totalLength_ * kPrime64_1);
+    } else {
+      hash = hashShort(buffer_, static_cast<size_t>(totalLength_));
+    }
+
+    std::vector<uint8_t> out(8);
+    for (int i = 0; i < 8; ++i) {
+      out[i] = static_cast<uint8_t>(hash >> (56 - i * 8));
+    }
+    return out;
+  }
+
+private:
+  alignas(16) uint64_t acc_[8] = {
+    kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+    kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1,
+  };
+  alignas(64) uint8_t buffer_[kInternalBufferSize];
+  size_t bufferedSize_ = 0;
+  size_t stripesSoFar_ = 0;
+  uint64_t totalLength_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<Hasher> createXxh3Hasher() {
+  return std::make_unique<Xxh3Hasher>();
+}
+
+} // namespace bufferedblob
@@ -0,0 +1,333 @@
+// Throughput benchmark for the streaming core on a desktop host.
+//
+// Drives PosixPlatformBridge the way BufferedBlobStreamingHostObject does:
+// every stream awaits each call before issuing the next, and results are
+// delivered inline on the completing thread (an inline CallInvoker). Each
+// configuration of operation x buffer size x concurrency moves `--bytes`
+// in total, split evenly across the concurrent streams.
+//
+// Operations:
+//   write  sequential write() of buffer-size chunks, then flush()
+//   read   sequential readNextChunk() until EOF
+//   hash   read with an attached incremental hasher (--algorithm)
+//
+// Results go to stdout as JSON Lines, one object per configuration:
+//   {"op":"read","bufferSize":65536,"concurrency":4,"bytes":...,
+//    "chunks":...,"seconds":...,"chunksPerSec":...,"mbPerSec":...,
+//    "latencyUs":{"p50":...,"p99":...,"max":...}}
+// MB is 2^20 bytes; latency is per call, as recorded by OperationStats.
+// A summary table goes to stderr.
+
+#include "NativeHandleRegistry.h"
+#include "OperationStats.h"
+#include "PosixPlatformBridge.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace bufferedblob;
+
+namespace {
+
+struct Options {
+  std::vector<std::string> ops{"write", "read", "hash"};
+  std::vector<size_t> bufferSizes{4096, 16384, 65536, 262144, 1048576, 4194304};
+  std::vector<size_t> concurrency{1, 2, 4, 8};
+  size_t bytes{64 * 1024 * 1024};
+  std::string algorithm{"sha256"};
+  std::string dir;
+};
+
+struct Result {
+  std::string op;
+  size_t bufferSize;
+  size_t concurrency;
+  uint64_t bytes;
+  uint64_t chunks;
+  double seconds;
+  LatencyHistogram::Summary latency;
+};
+
+[[noreturn]] void usage(const char* argv0) {
+  std::fprintf(
+      stderr,
+      "usage: %s [--ops write,read,hash] [--buffer-sizes 4096,...,4194304]\n"
+      "          [--concurrency 1,2,4,8] [--bytes N] [--algorithm sha256]\n"
+      "          [--dir PATH] [--quick]\n",
+      argv0);
+  std::exit(2);
+}
+
+std::vector<std::string> splitList(const std::string& value) {
+  std::vector<std::string> items;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+std::vector<size_t> parseSizes(const std::string& value, const char* argv0) {
+  std::vector<size_t> sizes;
+  for (const auto& item : splitList(value)) {
+    char* end = nullptr;
+    unsigned long long size = std::strtoull(item.c_str(), &end, 10);
+    if (*end != '\0' || size == 0) usage(argv0);
+    sizes.push_back(static_cast<size_t>(size));
+  }
+  if (sizes.empty()) usage(argv0);
+  return sizes;
+}
+
+Options parseOptions(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc) usage(argv[0]);
+      return argv[++i];
+    };
+    if (arg == "--ops") {
+      options.ops = splitList(value());
+    } else if (arg == "--buffer-sizes") {
+      options.bufferSizes = parseSizes(value(), argv[0]);
+    } else if (arg == "--concurrency") {
+      options.concurrency = parseSizes(value(), argv[0]);
+    } else if (arg == "--bytes") {
+      options.bytes = parseSizes(value(), argv[0]).front();
+    } else if (arg == "--algorithm") {
+      options.algorithm = value();
+    } else if (arg == "--dir") {
+      options.dir = value();
+    } else if (arg == "--quick") {
+      options.bufferSizes = {4096, 65536, 4194304};
+      options.concurrency = {1, 4};
+      options.bytes = 16 * 1024 * 1024;
+    } else {
+      usage(argv[0]);
+    }
+  }
+  for (const auto& op : options.ops) {
+    if (op != "write" && op != "read" && op != "hash") usage(argv[0]);
+  }
+  if (!Hasher::isSupported(options.algorithm)) usage(argv[0]);
+  return options;
+}
+
+/**
+ * Counts streams down to zero. Streams chain their next call from the
+ * previous call's callback, so the benchmark thread only waits here.
+ */
+class Completion {
+public:
+  explicit Completion(size_t streams) : remaining_(streams) {}
+
+  void finish(std::string error = {}) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error.empty() && error_.empty()) error_ = std::move(error);
+    if (--remaining_ == 0) done_.notify_all();
+  }
+
+  /** Blocks until every stream finished; returns the first error. */
+  std::string wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return remaining_ == 0; });
+    return error_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable done_;
+  size_t remaining_;
+  std::string error_;
+};
+
+struct Stream {
+  int handleId{-1};
+  int hasherId{-1};
+  size_t remaining{0};
+  uint64_t chunks{0};
+};
+
+void writeNext(PosixPlatformBridge& bridge, const std::vector<uint8_t>& source,
+               Stream& stream, Completion& completion) {
+  if (stream.remaining == 0) {
+    OperationTimer timer(StatsOperation::Flush);
+    bridge.flush(
+        stream.handleId,
+        [timer, &completion]() {
+          timer.completed().delivered(true);
+          completion.finish();
+        },
+        [timer, &completion](std::string error) {
+          timer.completed().delivered(false);
+          completion.finish(std::move(error));
+        });
+    return;
+  }
+  size_t size = std::min(source.size(), stream.remaining);
+  OperationTimer timer(StatsOperation::Write);
+  bridge.write(
+      stream.handleId, WriteBuffer{source.data(), size, nullptr},
+      [&bridge, &source, &stream, &completion, timer](int written) {
+        timer.completed().delivered(true, static_cast<uint64_t>(written));
+        stream.remaining -= static_cast<size_t>(written);
+        ++stream.chunks;
+        writeNext(bridge, source, stream, completion);
+      },
+      [timer, &completion](std::string error) {
+        timer.completed().delivered(false);
+        completion.finish(std::move(error));
+      });
+}
+
+void readNext(PosixPlatformBridge& bridge, Stream& stream, Completion& completion) {
+  OperationTimer timer(StatsOperation::ReadNextChunk);
+  bridge.readNextChunk(
+      stream.handleId,
+      [&bridge, &stream, &completion, timer](ChunkBuffer chunk) {
+        timer.completed().delivered(true, chunk.size());
+        ++stream.chunks;
+        readNext(bridge, stream, completion);
+      },
+      [timer, &completion]() {
+        timer.completed().delivered(true);
+        completion.finish();
+      },
+      [timer, &completion](std::string error) {
+        timer.completed().delivered(false);
+        completion.finish(std::move(error));
+      });
+}
+
+std::string filePath(const Options& options, size_t index) {
+  return options.dir + "/stream-" + std::to_string(index) + ".bin";
+}
+
+Result run(PosixPlatformBridge& bridge, const Options& options,
+           const std::string& op, size_t bufferSize, size_t concurrency) {
+  size_t perStream = options.bytes / concurrency;
+  std::vector<Stream> streams(concurrency);
+  std::vector<uint8_t> source;
+  auto& registry = NativeHandleRegistry::shared();
+
+  for (size_t i = 0; i < concurrency; ++i) {
+    auto path = filePath(options, i);
+    if (op == "write") {
+      if (source.empty()) {
+        source.resize(bufferSize);
+        for (size_t b = 0; b < bufferSize; ++b) source[b] = static_cast<uint8_t>(b * 131);
+      }
+      streams[i].handleId = registry.openWrite(path, false);
+      streams[i].remaining = perStream;
+    } else {
+      streams[i].handleId = registry.openRead(path, bufferSize);
+      if (op == "hash") {
+        streams[i].hasherId = bridge.createHasher(options.algorithm);
+        bridge.attachHasher(streams[i].handleId, streams[i].hasherId);
+      }
+    }
+  }
+
+  auto& stats = OperationStats::shared();
+  stats.reset();
+  Completion completion(concurrency);
+  auto start = std::chrono::steady_clock::now();
+  for (auto& stream : streams) {
+    if (op == "write") {
+      writeNext(bridge, source, stream, completion);
+    } else {
+      readNext(bridge, stream, completion);
+    }
+  }
+  auto error = completion.wait();
+  // Digests are part of the hash workload; closing writers does no I/O.
+  for (auto& stream : streams) {
+    if (stream.hasherId >= 0) {
+      bridge.digestHasher(stream.hasherId);
+      bridge.close(stream.hasherId);
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  for (auto& stream : streams) bridge.close(stream.handleId);
+  if (!error.empty()) {
+    std::fprintf(stderr, "%s failed: %s\n", op.c_str(), error.c_str());
+    std::exit(1);
+  }
+
+  Result result{op, bufferSize, concurrency, 0, 0, seconds, {}};
+  auto operation = op == "write" ? StatsOperation::Write : StatsOperation::ReadNextChunk;
+  result.bytes = stats.counters(operation).bytes;
+  for (const auto& stream : streams) result.chunks += stream.chunks;
+  result.latency = stats.latency(operation, StatsPhase::Total);
+  return result;
+}
+
+void printJson(const Result& result) {
+  constexpr double kMB = 1024.0 * 1024.0;
+  std::printf(
+      "{\"op\":\"%s\",\"bufferSize\":%zu,\"concurrency\":%zu,\"bytes\":%llu,"
+      "\"chunks\":%llu,\"seconds\":%.6f,\"chunksPerSec\":%.1f,\"mbPerSec\":%.1f,"
+      "\"latencyUs\":{\"p50\":%llu,\"p99\":%llu,\"max\":%llu}}\n",
+      result.op.c_str(), result.bufferSize, result.concurrency,
+      static_cast<unsigned long long>(result.bytes),
+      static_cast<unsigned long long>(result.chunks), result.seconds,
+      static_cast<double>(result.chunks) / result.seconds,
+      static_cast<double>(result.bytes) / kMB / result.seconds,
+      static_cast<unsigned long long>(result.latency.p50),
+      static_cast<unsigned long long>(result.latency.p99),
+      static_cast<unsigned long long>(result.latency.max));
+  std::fflush(stdout);
+  std::fprintf(stderr, "%-6s %8zu B x%-3zu %10.0f chunks/s %9.1f MB/s  p99 %llu us\n",
+               result.op.c_str(), result.bufferSize, result.concurrency,
+               static_cast<double>(result.chunks) / result.seconds,
+               static_cast<double>(result.bytes) / kMB / result.seconds,
+               static_cast<unsigned long long>(result.latency.p99));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  auto options = parseOptions(argc, argv);
+  bool ownDir = options.dir.empty();
+  if (ownDir) {
+    char dir[] = "/tmp/bufferedblob-bench-XXXXXX";
+    if (!mkdtemp(dir)) {
+      std::perror("mkdtemp");
+      return 1;
+    }
+    options.dir = dir;
+  }
+
+  PosixPlatformBridge bridge;
+  size_t maxConcurrency = 1;
+  for (size_t c : options.concurrency) maxConcurrency = std::max(maxConcurrency, c);
+
+  for (size_t concurrency : options.concurrency) {
+    // Lay out the files for this split first, so reads do not depend on
+    // where "write" appears in --ops.
+    run(bridge, options, "write", 1024 * 1024, concurrency);
+
+    for (size_t bufferSize : options.bufferSizes) {
+      for (const auto& op : options.ops) {
+        printJson(run(bridge, options, op, bufferSize, concurrency));
+      }
+    }
+  }
+
+  for (size_t i = 0; i < maxConcurrency; ++i) ::unlink(filePath(options, i).c_str());
+  if (ownDir) ::rmdir(options.dir.c_str());
+  return 0;
+}
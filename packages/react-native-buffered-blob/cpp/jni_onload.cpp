@@ -3,9 +3,33 @@
 #include <ReactCommon/CallInvokerHolder.h>
 #include "BufferedBlobStreamingHostObject.h"
 #include "AndroidPlatformBridge.h"
+#include "NativeHandleRegistry.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace facebook;
 
+namespace {
+
+std::string toStdString(JNIEnv* env, jstring str) {
+  const char* chars = env->GetStringUTFChars(str, nullptr);
+  std::string result(chars ? chars : "");
+  if (chars) env->ReleaseStringUTFChars(str, chars);
+  return result;
+}
+
+void throwRuntimeException(JNIEnv* env, const char* message) {
+  jclass exClass = env->FindClass("java/lang/RuntimeException");
+  if (exClass) {
+    env->ThrowNew(exClass, message);
+    env->DeleteLocalRef(exClass);
+  }
+}
+
+} // namespace
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_bufferedblob_BufferedBlobModule_nativeInstall(
     JNIEnv* env,
@@ -25,6 +49,235 @@ Java_com_bufferedblob_BufferedBlobModule_nativeInstall(
       runtime, callInvoker, bridge);
 }
 
+// --- Native handle factories (fd-backed, registered in C++) ---
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_bufferedblob_BufferedBlobModule_nativeOpenRead(
+    JNIEnv* env,
+    jobject thiz,
+    jstring path,
+    jint bufferSize) {
+  try {
+    return bufferedblob::NativeHandleRegistry::shared().openRead(
+        toStdString(env, path), static_cast<size_t>(bufferSize));
+  } catch (const std::exception& e) {
+    throwRuntimeException(env, e.what());
+    return -1;
+  }
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_bufferedblob_BufferedBlobModule_nativeOpenWrite(
+    JNIEnv* env,
+    jobject thiz,
+    jstring path,
+    jboolean append) {
+  try {
+    return bufferedblob::NativeHandleRegistry::shared().openWrite(
+        toStdString(env, path), append == JNI_TRUE);
+  } catch (const std::exception& e) {
+    throwRuntimeException(env, e.what());
+    return -1;
+  }
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_bufferedblob_BufferedBlobModule_nativeCloseHandle(
+    JNIEnv* env,
+    jobject thiz,
+    jint handleId) {
+  return bufferedblob::NativeHandleRegistry::shared().remove(handleId)
+      ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_bufferedblob_BufferedBlobModule_nativeClearHandles(
+    JNIEnv* env,
+    jobject thiz) {
+  bufferedblob::NativeHandleRegistry::shared().clear();
+}
+
+// --- Download transfer callbacks (called from StreamingBridge's copy loop) ---
+// `transfer` is the AndroidDownloadTransfer owned by the C++ thread that is
+// blocked in StreamingBridge.startDownload, so it outlives these calls.
+
+// Extra request headers as [name, value, ...] for resumable downloads
+// (see DownloadResume::requestHeaders).
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_bufferedblob_StreamingBridge_nativeOnDownloadRequest(
+    JNIEnv* env,
+    jclass clazz,
+    jlong transfer,
+    jstring url,
+    jstring destPath) {
+  auto* state = reinterpret_cast<bufferedblob::AndroidDownloadTransfer*>(transfer);
+  std::vector<std::pair<std::string, std::string>> headers;
+  if (state->config.resume) {
+    state->resume = std::make_unique<bufferedblob::DownloadResume>(
+        toStdString(env, url), toStdString(env, destPath));
+    headers = state->resume->requestHeaders();
+  }
+  jclass stringClass = env->FindClass("java/lang/String");
+  auto result = env->NewObjectArray(
+      static_cast<jint>(headers.size() * 2), stringClass, nullptr);
+  jint index = 0;
+  for (const auto& [name, value] : headers) {
+    jstring jname = env->NewStringUTF(name.c_str());
+    jstring jvalue = env->NewStringUTF(value.c_str());
+    env->SetObjectArrayElement(result, index++, jname);
+    env->SetObjectArrayElement(result, index++, jvalue);
+    env->DeleteLocalRef(jname);
+    env->DeleteLocalRef(jvalue);
+  }
+  env->DeleteLocalRef(stringClass);
+  return result;
+}
+
+// Returns the file offset the body is written from (0 truncates), or -1
+// for a non-2xx status.
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_bufferedblob_StreamingBridge_nativeOnDownloadResponse(
+    JNIEnv* env,
+    jclass clazz,
+    jlong transfer,
+    jint status,
+    jlong contentLength,
+    jstring contentRange,
+    jstring etag,
+    jstring lastModified) {
+  auto* state = reinterpret_cast<bufferedblob::AndroidDownloadTransfer*>(transfer);
+  auto header = [env](jstring value) {
+    return value ? toStdString(env, value) : std::string();
+  };
+  try {
+    int64_t offset = status >= 200 && status < 300 ? 0 : -1;
+    if (state->resume) {
+      offset = state->resume->onResponse(status, header(contentRange),
+                                         header(etag), header(lastModified));
+    }
+    if (offset < 0) return -1;
+    if (offset > 0 && state->hasher) {
+      // Catch the hasher up on the bytes kept from the earlier attempt.
+      state->resume->readPrefix([&](const uint8_t* data, size_t size) {
+        state->hasher->update(data, size);
+      });
+    }
+    state->progress.setTotal(contentLength >= 0 ? offset + contentLength : -1);
+    if (offset > 0) state->progress.add(static_cast<size_t>(offset));
+    return offset;
+  } catch (const std::exception& e) {
+    throwRuntimeException(env, e.what());
+    return -1;
+  }
+}
+
+// Returns false when the download's stream reader has gone away, which
+// ends the transfer.
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_bufferedblob_StreamingBridge_nativeOnDownloadData(
+    JNIEnv* env,
+    jclass clazz,
+    jlong transfer,
+    jbyteArray buffer,
+    jint length) {
+  auto* state = reinterpret_cast<bufferedblob::AndroidDownloadTransfer*>(transfer);
+  if (length <= 0) return JNI_TRUE;
+  if (state->stream) {
+    // Copy out first: push() may block for backpressure, which must not
+    // happen inside a critical region.
+    bufferedblob::ChunkBuffer chunk(static_cast<size_t>(length));
+    env->GetByteArrayRegion(buffer, 0, length, reinterpret_cast<jbyte*>(chunk.data()));
+    chunk.setSize(static_cast<size_t>(length));
+    if (state->hasher) state->hasher->update(chunk.data(), chunk.size());
+    state->progress.add(static_cast<size_t>(length));
+    return state->stream->push(std::move(chunk)) ? JNI_TRUE : JNI_FALSE;
+  }
+  if (state->hasher) {
+    // Critical access usually pins the Java array instead of copying it.
+    void* bytes = env->GetPrimitiveArrayCritical(buffer, nullptr);
+    if (bytes) {
+      state->hasher->update(static_cast<const uint8_t*>(bytes),
+                            static_cast<size_t>(length));
+      env->ReleasePrimitiveArrayCritical(buffer, bytes, JNI_ABORT);
+    }
+  }
+  state->progress.add(static_cast<size_t>(length));
+  if (state->resume) state->resume->advance(static_cast<size_t>(length));
+  return JNI_TRUE;
+}
+
+// --- Segmented downloads (see SegmentedDownload) ---
+
+// Response to the `Range: bytes=0-0` probe. Sets up the segmented download
+// when the server serves ranges and the file is worth splitting.
+extern "C" JNIEXPORT void JNICALL
+Java_com_bufferedblob_StreamingBridge_nativeOnDownloadProbe(
+    JNIEnv* env,
+    jclass clazz,
+    jlong transfer,
+    jint status,
+    jstring contentRange,
+    jstring etag,
+    jstring lastModified,
+    jstring destPath) {
+  auto* state = reinterpret_cast<bufferedblob::AndroidDownloadTransfer*>(transfer);
+  auto header = [env](jstring value) {
+    return value ? toStdString(env, value) : std::string();
+  };
+  int64_t length = bufferedblob::SegmentedDownload::probeLength(status, header(contentRange));
+  int segments = bufferedblob::SegmentedDownload::segmentCount(
+      length, state->config.segments, state->config.minSegmentSize);
+  if (segments <= 1) return;
+  try {
+    state->segmented = std::make_unique<bufferedblob::SegmentedDownload>(
+        toStdString(env, destPath), length, segments,
+        bufferedblob::ifRangeValidator(header(etag), header(lastModified)),
+        state->progress);
+  } catch (const std::exception& e) {
+    throwRuntimeException(env, e.what());
+  }
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_bufferedblob_StreamingBridge_nativeOnSegmentResponse(
+    JNIEnv* env,
+    jclass clazz,
+    jlong transfer,
+    jint index,
+    jint status,
+    jstring contentRange) {
+  auto* state = reinterpret_cast<bufferedblob::AndroidDownloadTransfer*>(transfer);
+  try {
+    state->segmented->onResponse(static_cast<size_t>(index), status,
+                                 contentRange ? toStdString(env, contentRange) : std::string());
+  } catch (const std::exception& e) {
+    throwRuntimeException(env, e.what());
+  }
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_bufferedblob_StreamingBridge_nativeOnSegmentData(
+    JNIEnv* env,
+    jclass clazz,
+    jlong transfer,
+    jint index,
+    jbyteArray buffer,
+    jint length) {
+  auto* state = reinterpret_cast<bufferedblob::AndroidDownloadTransfer*>(transfer);
+  if (length <= 0) return;
+  // Copied out rather than pinned: pwrite may block, which critical
+  // array access must not.
+  thread_local std::vector<uint8_t> scratch;
+  scratch.resize(static_cast<size_t>(length));
+  env->GetByteArrayRegion(buffer, 0, length, reinterpret_cast<jbyte*>(scratch.data()));
+  try {
+    state->segmented->onData(static_cast<size_t>(index), scratch.data(),
+                             static_cast<size_t>(length));
+  } catch (const std::exception& e) {
+    throwRuntimeException(env, e.what());
+  }
+}
+
 JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void*) {
   return jni::initialize(vm, [] {
     // No native methods to register via fbjni - we use raw JNI above
@@ -6,8 +6,8 @@
 
 /**
  * Core BufferedBlob module implementation.
- * Provides handle factories for readers/writers/downloaders and
- * common filesystem operations (exists, stat, unlink, mkdir, ls, cp, mv, hash).
+ * Provides the downloader handle factory and
+ * common filesystem operations (exists, stat, unlink, mkdir, ls, cp, mv).
  *
  * All async FS operations are dispatched to global concurrent queues.
  * FileManager.default is documented as safe for concurrent use from multiple queues
@@ -20,9 +20,7 @@
 
 - (NSDictionary *)constantsToExport;
 
-// Handle factories
-- (NSNumber *)openRead:(NSString *)path bufferSize:(double)bufferSize;
-- (NSNumber *)openWrite:(NSString *)path append:(BOOL)append;
+// Handle factories (readers/writers live in the C++ NativeHandleRegistry)
 - (NSNumber *)createDownload:(NSString *)url destPath:(NSString *)destPath headers:(NSDictionary *)headers;
 - (void)closeHandle:(double)handleId;
 
@@ -39,6 +37,5 @@ typedef void (^RCTPromiseRejectBlock)(NSString * _Nullable code,
 - (void)ls:(NSString *)path resolve:(RCTPromiseResolveBlock)resolve reject:(RCTPromiseRejectBlock)reject;
 - (void)cp:(NSString *)srcPath destPath:(NSString *)destPath resolve:(RCTPromiseResolveBlock)resolve reject:(RCTPromiseRejectBlock)reject;
 - (void)mv:(NSString *)srcPath destPath:(NSString *)destPath resolve:(RCTPromiseResolveBlock)resolve reject:(RCTPromiseRejectBlock)reject;
-- (void)hashFile:(NSString *)path algorithm:(NSString *)algorithm resolve:(RCTPromiseResolveBlock)resolve reject:(RCTPromiseRejectBlock)reject;
 
 @end
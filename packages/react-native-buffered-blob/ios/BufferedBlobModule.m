@@ -1,7 +1,6 @@
 #import "BufferedBlobModule.h"
 #import "HandleRegistry.h"
 #import "HandleTypes.h"
-#import <CommonCrypto/CommonDigest.h>
 
 @implementation BufferedBlobModule
 
@@ -42,48 +41,6 @@
 #pragma mark - Handle Factories
 // ──────────────────────────────────────────────────────────────────────
 
-static const NSInteger kMinBufferSize = 4096;
-static const NSInteger kMaxBufferSize = 4194304; // 4MB
-
-- (NSNumber *)openRead:(NSString *)path bufferSize:(double)bufferSize {
-  NSInteger size = (NSInteger)bufferSize;
-  if (size < kMinBufferSize || size > kMaxBufferSize) {
-    NSLog(@"[BufferedBlob] openRead: buffer size out of range (%ld). Must be %ld-%ld.",
-          (long)size, (long)kMinBufferSize, (long)kMaxBufferSize);
-    return @(-1);
-  }
-
-  NSError *error = nil;
-  ReaderHandleIOS *reader = [[ReaderHandleIOS alloc] initWithPath:path
-                                                       bufferSize:size
-                                                            error:&error];
-  if (!reader) {
-    return @(-1);
-  }
-
-  NSInteger handleId = [[HandleRegistry shared] registerObject:reader];
-  return @(handleId);
-}
-
-- (NSNumber *)openWrite:(NSString *)path append:(BOOL)append {
-  NSFileManager *fm = [NSFileManager defaultManager];
-  NSString *parentDir = [path stringByDeletingLastPathComponent];
-  if (![fm fileExistsAtPath:parentDir]) {
-    [fm createDirectoryAtPath:parentDir withIntermediateDirectories:YES attributes:nil error:nil];
-  }
-
-  NSError *error = nil;
-  WriterHandleIOS *writer = [[WriterHandleIOS alloc] initWithPath:path
-                                                           append:append
-                                                            error:&error];
-  if (!writer) {
-    return @(-1);
-  }
-
-  NSInteger handleId = [[HandleRegistry shared] registerObject:writer];
-  return @(handleId);
-}
-
 - (NSNumber *)createDownload:(NSString *)url destPath:(NSString *)destPath headers:(NSDictionary *)headers {
   NSFileManager *fm = [NSFileManager defaultManager];
   NSString *parentDir = [destPath stringByDeletingLastPathComponent];
@@ -326,108 +283,4 @@ static const NSInteger kMaxBufferSize = 4194304; // 4MB
   });
 }
 
-- (void)hashFile:(NSString *)path
-       algorithm:(NSString *)algorithm
-         resolve:(RCTPromiseResolveBlock)resolve
-          reject:(RCTPromiseRejectBlock)reject {
-  dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
-    NSFileManager *fm = [NSFileManager defaultManager];
-    BOOL isDir = NO;
-    if ([fm fileExistsAtPath:path isDirectory:&isDir] && isDir) {
-      reject(@"ERR_FS",
-             [NSString stringWithFormat:@"[INVALID_ARGUMENT] Cannot hash a directory: %@", path],
-             nil);
-      return;
-    }
-
-    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:path];
-    if (!inputStream) {
-      reject(@"ERR_FS",
-             [NSString stringWithFormat:@"[FILE_NOT_FOUND] File does not exist: %@", path],
-             nil);
-      return;
-    }
-    [inputStream open];
-    if (inputStream.streamStatus == NSStreamStatusError) {
-      [inputStream close];
-      reject(@"ERR_FS",
-             [NSString stringWithFormat:@"[FILE_NOT_FOUND] File does not exist: %@", path],
-             nil);
-      return;
-    }
-
-    const NSUInteger kBufferSize = 8192;
-    uint8_t *buffer = malloc(kBufferSize);
-    if (!buffer) {
-      [inputStream close];
-      reject(@"ERR_FS", @"[READ_ERROR] Failed to allocate buffer", nil);
-      return;
-    }
-
-    if ([algorithm isEqualToString:@"sha256"]) {
-      CC_SHA256_CTX ctx;
-      CC_SHA256_Init(&ctx);
-
-      while ([inputStream hasBytesAvailable]) {
-        NSInteger bytesRead = [inputStream read:buffer maxLength:kBufferSize];
-        if (bytesRead < 0) {
-          free(buffer);
-          [inputStream close];
-          reject(@"ERR_FS", @"[READ_ERROR] Error reading file", nil);
-          return;
-        }
-        if (bytesRead == 0) break;
-        CC_SHA256_Update(&ctx, buffer, (CC_LONG)bytesRead);
-      }
-
-      unsigned char digest[CC_SHA256_DIGEST_LENGTH];
-      CC_SHA256_Final(digest, &ctx);
-
-      free(buffer);
-      [inputStream close];
-
-      NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
-      for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
-        [hex appendFormat:@"%02x", digest[i]];
-      }
-      resolve(hex);
-
-    } else if ([algorithm isEqualToString:@"md5"]) {
-      CC_MD5_CTX ctx;
-      CC_MD5_Init(&ctx);
-
-      while ([inputStream hasBytesAvailable]) {
-        NSInteger bytesRead = [inputStream read:buffer maxLength:kBufferSize];
-        if (bytesRead < 0) {
-          free(buffer);
-          [inputStream close];
-          reject(@"ERR_FS", @"[READ_ERROR] Error reading file", nil);
-          return;
-        }
-        if (bytesRead == 0) break;
-        CC_MD5_Update(&ctx, buffer, (CC_LONG)bytesRead);
-      }
-
-      unsigned char digest[CC_MD5_DIGEST_LENGTH];
-      CC_MD5_Final(digest, &ctx);
-
-      free(buffer);
-      [inputStream close];
-
-      NSMutableString *hex = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
-      for (int i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
-        [hex appendFormat:@"%02x", digest[i]];
-      }
-      resolve(hex);
-
-    } else {
-      free(buffer);
-      [inputStream close];
-      reject(@"ERR_FS",
-             [NSString stringWithFormat:@"[INVALID_ARGUMENT] Unknown algorithm: %@", algorithm],
-             nil);
-    }
-  });
-}
-
 @end
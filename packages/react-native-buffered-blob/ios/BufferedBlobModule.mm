@@ -6,6 +6,10 @@
 #import "BufferedBlobStreamingBridge.h"
 #import "BufferedBlobModule.h"
 #import "HandleRegistry.h"
+#include "NativeHandleRegistry.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
 
 #ifdef RCT_NEW_ARCH_ENABLED
 #import <BufferedBlobSpec/BufferedBlobSpec.h>
@@ -133,12 +137,31 @@ RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(install) {
 #endif
 
 // --- Handle Factories ---
+// Readers and writers are opened by the shared C++ registry so that the
+// streaming bridge does all file I/O on raw descriptors.
 RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(openRead:(NSString *)path bufferSize:(double)bufferSize) {
-  return [_module openRead:path bufferSize:bufferSize];
+  try {
+    // Out-of-range sizes map to 0 and are rejected by the registry.
+    size_t size = std::isfinite(bufferSize) && bufferSize > 0
+        ? static_cast<size_t>(std::min(bufferSize, 1e9)) : 0;
+    int handleId = bufferedblob::NativeHandleRegistry::shared().openRead(
+        std::string([path UTF8String]), size);
+    return @(handleId);
+  } catch (const std::exception &e) {
+    NSLog(@"[BufferedBlob] openRead failed: %s", e.what());
+    return @(-1);
+  }
 }
 
 RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(openWrite:(NSString *)path append:(BOOL)append) {
-  return [_module openWrite:path append:append];
+  try {
+    int handleId = bufferedblob::NativeHandleRegistry::shared().openWrite(
+        std::string([path UTF8String]), append);
+    return @(handleId);
+  } catch (const std::exception &e) {
+    NSLog(@"[BufferedBlob] openWrite failed: %s", e.what());
+    return @(-1);
+  }
 }
 
 RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(createDownload:(NSString *)url destPath:(NSString *)destPath headers:(NSDictionary *)headers) {
@@ -146,7 +169,9 @@ RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(createDownload:(NSString *)url destPath:(
 }
 
 RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(closeHandle:(double)handleId) {
-  [_module closeHandle:handleId];
+  if (!bufferedblob::NativeHandleRegistry::shared().remove(static_cast<int>(handleId))) {
+    [_module closeHandle:handleId];
+  }
   return nil;
 }
 
@@ -179,11 +204,8 @@ RCT_EXPORT_METHOD(mv:(NSString *)srcPath destPath:(NSString *)destPath resolve:(
   [_module mv:srcPath destPath:destPath resolve:resolve reject:reject];
 }
 
-RCT_EXPORT_METHOD(hashFile:(NSString *)path algorithm:(NSString *)algorithm resolve:(RCTPromiseResolveBlock)resolve reject:(RCTPromiseRejectBlock)reject) {
-  [_module hashFile:path algorithm:algorithm resolve:resolve reject:reject];
-}
-
 - (void)invalidate {
+  bufferedblob::NativeHandleRegistry::shared().clear();
   [[HandleRegistry shared] clear];
   _runtime = nullptr;
   _callInvoker = nullptr;
@@ -1,18 +1,29 @@
 #import "BufferedBlobStreamingBridge.h"
 #import "BufferedBlobStreamingHostObject.h"
+#import "DownloadResume.h"
+#import "DownloadStream.h"
+#import "PosixPlatformBridge.h"
+#import "SegmentedDownload.h"
 #import "HandleRegistry.h"
 #import "HandleTypes.h"
 #import <Foundation/Foundation.h>
 #import <React/RCTBridge+Private.h>
+#include <thread>
 
 @interface DownloadSessionDelegate : NSObject <NSURLSessionDataDelegate>
 @property (nonatomic, copy) NSString *destPath;
+// NO for stream-only downloads, which keep no file.
+@property (nonatomic, assign) BOOL writeFile;
 @property (nonatomic, strong) NSOutputStream *outputStream;
 @property (nonatomic, assign) int64_t totalBytes;
 @property (nonatomic, assign) int64_t downloadedBytes;
 @property (nonatomic, assign) BOOL isFinished;
 @property (nonatomic, weak) DownloaderHandleIOS *handle;
-@property (nonatomic, copy) void (^onProgress)(double, double, double);
+// Sets the file offset to write from (0 truncates); returns an error message
+// to fail the download with, or nil.
+@property (nonatomic, copy) NSString *(^onResponse)(NSHTTPURLResponse *, int64_t *);
+// Returns NO to stop the download (its stream reader went away).
+@property (nonatomic, copy) BOOL (^onData)(const uint8_t *, NSUInteger);
 @property (nonatomic, copy) void (^onSuccess)(void);
 @property (nonatomic, copy) void (^onError)(NSString *);
 @property (nonatomic, strong) NSLock *stateLock;
@@ -28,7 +39,8 @@
   }
   self.isFinished = YES;
   void (^errorBlock)(NSString *) = self.onError;
-  self.onProgress = nil;
+  self.onResponse = nil;
+  self.onData = nil;
   self.onSuccess = nil;
   self.onError = nil;
   [self.stateLock unlock];
@@ -45,7 +57,8 @@
   }
   self.isFinished = YES;
   void (^successBlock)(void) = self.onSuccess;
-  self.onProgress = nil;
+  self.onResponse = nil;
+  self.onData = nil;
   self.onSuccess = nil;
   self.onError = nil;
   [self.stateLock unlock];
@@ -73,6 +86,8 @@ didReceiveResponse:(NSURLResponse *)response
   }
 
   NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
+  int64_t offset = 0;
+  NSString *responseError = self.onResponse ? self.onResponse(httpResponse, &offset) : nil;
   if (httpResponse.statusCode < 200 || httpResponse.statusCode >= 300) {
     completionHandler(NSURLSessionResponseCancel);
     NSString *errorMsg = [NSString stringWithFormat:@"[DOWNLOAD_FAILED] HTTP %ld",
@@ -80,17 +95,27 @@ didReceiveResponse:(NSURLResponse *)response
     [self finishWithError:errorMsg session:session];
     return;
   }
+  if (responseError) {
+    completionHandler(NSURLSessionResponseCancel);
+    [self finishWithError:responseError session:session];
+    return;
+  }
 
-  self.totalBytes = response.expectedContentLength;
-  self.downloadedBytes = 0;
+  self.totalBytes = response.expectedContentLength >= 0
+      ? offset + response.expectedContentLength : -1;
+  self.downloadedBytes = offset;
 
-  self.outputStream = [NSOutputStream outputStreamToFileAtPath:self.destPath append:NO];
-  [self.outputStream open];
+  if (self.writeFile) {
+    // A non-zero offset means the file already holds exactly that prefix.
+    self.outputStream = [NSOutputStream outputStreamToFileAtPath:self.destPath
+                                                          append:offset > 0];
+    [self.outputStream open];
 
-  if (self.outputStream.streamStatus == NSStreamStatusError) {
-    completionHandler(NSURLSessionResponseCancel);
-    [self finishWithError:@"[IO_ERROR] Failed to open output stream" session:session];
-    return;
+    if (self.outputStream.streamStatus == NSStreamStatusError) {
+      completionHandler(NSURLSessionResponseCancel);
+      [self finishWithError:@"[IO_ERROR] Failed to open output stream" session:session];
+      return;
+    }
   }
 
   completionHandler(NSURLSessionResponseAllow);
@@ -112,14 +137,16 @@ didReceiveResponse:(NSURLResponse *)response
     return;
   }
 
-  if (!self.outputStream || self.outputStream.streamStatus != NSStreamStatusOpen) {
+  if (self.writeFile &&
+      (!self.outputStream || self.outputStream.streamStatus != NSStreamStatusOpen)) {
     [self finishWithError:@"[IO_ERROR] Output stream not open" session:session];
     return;
   }
 
   const uint8_t *bytes = (const uint8_t *)data.bytes;
   NSUInteger length = data.length;
-  NSUInteger totalWritten = 0;
+  // Without a file there is nothing to write.
+  NSUInteger totalWritten = self.writeFile ? 0 : length;
 
   while (totalWritten < length) {
     NSInteger written = [self.outputStream write:(bytes + totalWritten)
@@ -132,10 +159,9 @@ didReceiveResponse:(NSURLResponse *)response
   }
 
   self.downloadedBytes += length;
-
-  if (self.onProgress && self.totalBytes > 0) {
-    double progress = (double)self.downloadedBytes / (double)self.totalBytes;
-    self.onProgress((double)self.downloadedBytes, (double)self.totalBytes, progress);
+  // Blocks this delegate queue while a stream reader is behind.
+  if (self.onData && !self.onData(bytes, length)) {
+    [self finishWithError:@"[DOWNLOAD_CANCELLED] Download stream was closed" session:session];
   }
 }
 
@@ -172,160 +198,290 @@ didCompleteWithError:(NSError *)error {
 
 @end
 
-namespace {
-
-using namespace bufferedblob;
-
 /**
- * iOS implementation of PlatformBridge.
- * Calls into HandleRegistry and handle types via ObjC interop.
+ * Delegate for a single range request of a segmented download (or its
+ * probe). The blocks return an error message to stop the task, or nil.
  */
-class IOSPlatformBridge : public PlatformBridge {
-public:
-  IOSPlatformBridge() {}
+@interface RangeTaskDelegate : NSObject <NSURLSessionDataDelegate>
+@property (nonatomic, copy) NSString *(^onResponse)(NSHTTPURLResponse *);
+@property (nonatomic, copy) NSString *(^onData)(const uint8_t *, NSUInteger);
+@property (nonatomic, strong) dispatch_semaphore_t done;
+/** First failure; set on the delegate queue before `done` is signalled. */
+@property (nonatomic, copy) NSString *error;
+@end
 
-  void readNextChunk(
-      int handleId,
-      std::function<void(std::vector<uint8_t>)> onSuccess,
-      std::function<void()> onEOF,
-      std::function<void(std::string)> onError) override {
+@implementation RangeTaskDelegate
 
-    HandleRegistry *registry = [HandleRegistry shared];
-    ReaderHandleIOS *reader = (ReaderHandleIOS *)[registry objectForId:handleId];
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+  NSString *error = self.onResponse ? self.onResponse((NSHTTPURLResponse *)response) : nil;
+  if (error) {
+    self.error = error;
+    completionHandler(NSURLSessionResponseCancel);
+    return;
+  }
+  completionHandler(NSURLSessionResponseAllow);
+}
 
-    if (!reader) {
-      onError("[READER_CLOSED] Reader handle not found");
-      return;
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+  if (self.error || !self.onData) return;
+  // Walk the received regions in place instead of flattening the NSData.
+  [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+    NSString *error = self.onData((const uint8_t *)bytes, byteRange.length);
+    if (error) {
+      self.error = error;
+      *stop = YES;
+      [dataTask cancel];
     }
+  }];
+}
 
-    // Dispatch to the reader's serial queue to serialize all access to this handle
-    dispatch_async(reader.queue, ^{
-      @autoreleasepool {
-        if (reader.isClosed) {
-          onError("[READER_CLOSED] Reader is closed");
-          return;
-        }
-
-        if (reader.isEOF) {
-          onEOF();
-          return;
-        }
+- (void)URLSession:(NSURLSession *)session
+              task:(NSURLSessionTask *)task
+didCompleteWithError:(NSError *)error {
+  if (!self.error && error) {
+    self.error = [NSString stringWithFormat:@"[DOWNLOAD_FAILED] %@",
+                  error.localizedDescription];
+  }
+  dispatch_semaphore_signal(self.done);
+}
 
-        NSInteger bufferSize = reader.bufferSize;
-        uint8_t *buffer = (uint8_t *)malloc(bufferSize);
-        if (!buffer) {
-          onError("[IO_ERROR] Failed to allocate read buffer");
-          return;
-        }
+@end
 
-        NSInteger bytesRead = [reader.inputStream read:buffer maxLength:bufferSize];
+namespace {
 
-        if (bytesRead < 0) {
-          free(buffer);
-          onError("[IO_ERROR] Read error");
-          return;
-        }
+using namespace bufferedblob;
 
-        if (bytesRead == 0) {
-          free(buffer);
-          reader.isEOF = YES;
-          onEOF();
-          return;
-        }
+std::string headerValue(NSHTTPURLResponse *response, NSString *name) {
+  NSString *value = [response valueForHTTPHeaderField:name];
+  return value ? std::string([value UTF8String]) : std::string();
+}
 
-        reader.bytesRead = reader.bytesRead + bytesRead;
+NSURLSessionConfiguration *downloadSessionConfiguration() {
+  NSURLSessionConfiguration *config = [NSURLSessionConfiguration defaultSessionConfiguration];
+  config.timeoutIntervalForRequest = 30.0;
+  config.timeoutIntervalForResource = 600.0;
+  return config;
+}
 
-        std::vector<uint8_t> data(buffer, buffer + bytesRead);
-        free(buffer);
-        onSuccess(std::move(data));
-      }
-    });
+/**
+ * Run one range request to completion on the calling thread and return an
+ * error message, or an empty string on success. Polls the handle so a
+ * cancel stops the request promptly.
+ */
+std::string runRangeRequest(DownloaderHandleIOS *handle, NSURLRequest *baseRequest,
+                            const std::string &range, const std::string &ifRange,
+                            NSString *(^onResponse)(NSHTTPURLResponse *),
+                            NSString *(^onData)(const uint8_t *, NSUInteger)) {
+  NSMutableURLRequest *request = [baseRequest mutableCopy];
+  [request setValue:[NSString stringWithUTF8String:range.c_str()] forHTTPHeaderField:@"Range"];
+  [request setValue:@"identity" forHTTPHeaderField:@"Accept-Encoding"];
+  if (!ifRange.empty()) {
+    [request setValue:[NSString stringWithUTF8String:ifRange.c_str()]
+        forHTTPHeaderField:@"If-Range"];
   }
 
-  void write(
-      int handleId,
-      std::vector<uint8_t> data,
-      std::function<void(int)> onSuccess,
-      std::function<void(std::string)> onError) override {
-
-    HandleRegistry *registry = [HandleRegistry shared];
-    WriterHandleIOS *writer = (WriterHandleIOS *)[registry objectForId:handleId];
-
-    if (!writer) {
-      onError("[WRITER_CLOSED] Writer handle not found");
-      return;
-    }
-
-    // Move data into block-captured variable (single copy from JSI, no second copy)
-    __block auto ownedData = std::move(data);
-
-    // Dispatch to the writer's serial queue to serialize all access to this handle
-    dispatch_async(writer.queue, ^{
-      @autoreleasepool {
-        if (writer.isClosed) {
-          onError("[WRITER_CLOSED] Writer is closed");
-          return;
-        }
+  RangeTaskDelegate *delegate = [RangeTaskDelegate new];
+  delegate.onResponse = onResponse;
+  delegate.onData = onData;
+  delegate.done = dispatch_semaphore_create(0);
+  NSURLSession *session = [NSURLSession sessionWithConfiguration:downloadSessionConfiguration()
+                                                        delegate:delegate
+                                                   delegateQueue:nil];
+  NSURLSessionDataTask *task = [session dataTaskWithRequest:request];
+  [task resume];
+  while (dispatch_semaphore_wait(delegate.done,
+                                 dispatch_time(DISPATCH_TIME_NOW, 100 * NSEC_PER_MSEC)) != 0) {
+    if (handle.isCancelled) [task cancel];
+  }
+  [session finishTasksAndInvalidate];
 
-        NSInteger totalWritten = 0;
-        const uint8_t *ptr = ownedData.data();
-        NSInteger remaining = static_cast<NSInteger>(ownedData.size());
+  if (handle.isCancelled) return "[DOWNLOAD_CANCELLED] Download was cancelled";
+  return delegate.error ? std::string([delegate.error UTF8String]) : std::string();
+}
 
-        while (remaining > 0) {
-          NSInteger written = [writer.outputStream write:ptr maxLength:remaining];
-          if (written < 0) {
-            onError("[IO_ERROR] Write error");
-            return;
-          }
-          if (written == 0) {
-            onError("[IO_ERROR] Write returned 0 bytes");
-            return;
-          }
-          totalWritten += written;
-          ptr += written;
-          remaining -= written;
-        }
+/**
+ * Probe with `Range: bytes=0-0` and, when the server serves ranges and the
+ * file is large enough, fetch it as concurrent segments. Blocks; returns
+ * false (without reporting) when the caller should fall back to a single
+ * stream.
+ */
+bool runSegmentedDownload(DownloaderHandleIOS *handle, NSURLRequest *request,
+                          const PlatformBridge::DownloadConfig &config,
+                          const std::shared_ptr<DownloadProgress> &progress,
+                          const std::shared_ptr<NativeHasherHandle> &hasher,
+                          const std::function<void()> &onSuccess,
+                          const std::function<void(std::string)> &onError) {
+  struct Probe {
+    bool received = false;
+    int status = 0;
+    std::string contentRange;
+    std::string etag;
+    std::string lastModified;
+  } probe;
+  Probe *probePtr = &probe;
+  // Only the headers matter; stop before any body arrives.
+  std::string probeError = runRangeRequest(
+      handle, request, "bytes=0-0", "",
+      ^NSString *(NSHTTPURLResponse *response) {
+        probePtr->received = true;
+        probePtr->status = static_cast<int>(response.statusCode);
+        probePtr->contentRange = headerValue(response, @"Content-Range");
+        probePtr->etag = headerValue(response, @"ETag");
+        probePtr->lastModified = headerValue(response, @"Last-Modified");
+        return @"probe complete";
+      },
+      nil);
+  if (handle.isCancelled) {
+    onError("[DOWNLOAD_CANCELLED] Download was cancelled");
+    return true;
+  }
+  if (!probe.received) {
+    onError(probeError);
+    return true;
+  }
 
-        writer.bytesWritten = writer.bytesWritten + totalWritten;
-        onSuccess(static_cast<int>(totalWritten));
-      }
+  int64_t length = SegmentedDownload::probeLength(probe.status, probe.contentRange);
+  int count = SegmentedDownload::segmentCount(length, config.segments, config.minSegmentSize);
+  if (count <= 1) return false;
+
+  try {
+    SegmentedDownload segmented(std::string([handle.destPath UTF8String]), length, count,
+                                ifRangeValidator(probe.etag, probe.lastModified), *progress);
+    SegmentedDownload *segmentedPtr = &segmented;
+    segmented.run([&](size_t index) {
+      std::string error = runRangeRequest(
+          handle, request, segmentedPtr->rangeHeader(index), segmentedPtr->validator(),
+          ^NSString *(NSHTTPURLResponse *response) {
+            try {
+              segmentedPtr->onResponse(index, static_cast<int>(response.statusCode),
+                                       headerValue(response, @"Content-Range"));
+              return (NSString *)nil;
+            } catch (const std::exception &e) {
+              return [NSString stringWithUTF8String:e.what()];
+            }
+          },
+          ^NSString *(const uint8_t *bytes, NSUInteger size) {
+            try {
+              segmentedPtr->onData(index, bytes, size);
+              return (NSString *)nil;
+            } catch (const std::exception &e) {
+              return [NSString stringWithUTF8String:e.what()];
+            }
+          });
+      if (!error.empty()) throw std::runtime_error(error);
     });
+    // Segments arrive out of order, so hash the assembled file.
+    if (hasher) {
+      segmented.readAll([&](const uint8_t *data, size_t size) {
+        hasher->update(data, size);
+      });
+    }
+  } catch (const std::exception &e) {
+    onError(e.what());
+    return true;
   }
+  progress->complete();
+  onSuccess();
+  return true;
+}
 
-  void flush(
-      int handleId,
-      std::function<void()> onSuccess,
-      std::function<void(std::string)> onError) override {
-
-    HandleRegistry *registry = [HandleRegistry shared];
-    WriterHandleIOS *writer = (WriterHandleIOS *)[registry objectForId:handleId];
-
-    if (!writer) {
-      onError("[WRITER_CLOSED] Writer handle not found");
-      return;
+/** Download as a single NSURLSession stream; returns once it is started. */
+void startStreamDownload(DownloaderHandleIOS *handle, NSURLRequest *request,
+                         const std::shared_ptr<DownloadResume> &resume,
+                         const std::shared_ptr<DownloadStream> &stream, bool writeFile,
+                         const std::shared_ptr<DownloadProgress> &progress,
+                         const std::shared_ptr<NativeHasherHandle> &hasher,
+                         std::function<void()> onSuccess,
+                         std::function<void(std::string)> onError) {
+  DownloadSessionDelegate *delegate = [[DownloadSessionDelegate alloc] init];
+  delegate.stateLock = [NSLock new];
+  delegate.destPath = handle.destPath;
+  delegate.writeFile = writeFile;
+  delegate.handle = handle;
+  delegate.onResponse = ^NSString *(NSHTTPURLResponse *response, int64_t *offset) {
+    try {
+      int statusCode = static_cast<int>(response.statusCode);
+      *offset = statusCode >= 200 && statusCode < 300 ? 0 : -1;
+      if (resume) {
+        *offset = resume->onResponse(statusCode, headerValue(response, @"Content-Range"),
+                                     headerValue(response, @"ETag"),
+                                     headerValue(response, @"Last-Modified"));
+      }
+      if (*offset < 0) return nil;
+      if (*offset > 0 && hasher) {
+        // Catch the hasher up on the bytes kept from the earlier attempt.
+        resume->readPrefix([&](const uint8_t *data, size_t size) {
+          hasher->update(data, size);
+        });
+      }
+      int64_t length = response.expectedContentLength;
+      progress->setTotal(length >= 0 ? *offset + length : -1);
+      if (*offset > 0) progress->add(static_cast<size_t>(*offset));
+      return nil;
+    } catch (const std::exception &e) {
+      return [NSString stringWithUTF8String:e.what()];
     }
+  };
+  delegate.onData = ^BOOL(const uint8_t *bytes, NSUInteger length) {
+    if (hasher) hasher->update(bytes, length);
+    progress->add(length);
+    if (resume) resume->advance(length);
+    return !stream || stream->push(bytes, length);
+  };
+  delegate.onSuccess = ^{
+    if (resume) resume->finish();
+    progress->complete();
+    onSuccess();
+  };
+  delegate.onError = ^(NSString *errorMsg) {
+    if (resume) resume->save();
+    onError(std::string([errorMsg UTF8String]));
+  };
+
+  NSOperationQueue *delegateQueue = [[NSOperationQueue alloc] init];
+  delegateQueue.maxConcurrentOperationCount = 1;
+  NSURLSession *session = [NSURLSession sessionWithConfiguration:downloadSessionConfiguration()
+                                                        delegate:delegate
+                                                   delegateQueue:delegateQueue];
+  NSURLSessionDataTask *task = [session dataTaskWithRequest:request];
+
+  // Store session and task on the handle so cancelDownload can properly invalidate
+  [handle storeSession:session task:task];
+
+  // Re-check: cancel may have been called between the first check and storeSession
+  if (handle.isCancelled) {
+    [task cancel];
+    [session invalidateAndCancel];
+    onError("[DOWNLOAD_CANCELLED] Download was cancelled");
+    return;
+  }
 
-    // Dispatch to the writer's serial queue to serialize all access to this handle
-    dispatch_async(writer.queue, ^{
-      @autoreleasepool {
-        if (writer.isClosed) {
-          onError("[WRITER_CLOSED] Writer is closed");
-          return;
-        }
+  [task resume];
+}
 
-        // NSOutputStream doesn't have an explicit flush, data is written immediately
-        onSuccess();
-      }
-    });
-  }
+/**
+ * iOS implementation of PlatformBridge.
+ * Readers and writers live in NativeHandleRegistry and are served by
+ * PosixPlatformBridge; downloads go through NSURLSession and HandleRegistry.
+ */
+class IOSPlatformBridge : public PosixPlatformBridge {
+public:
+  IOSPlatformBridge() {}
 
   void close(int handleId) override {
+    if (NativeHandleRegistry::shared().remove(handleId)) return;
     HandleRegistry *registry = [HandleRegistry shared];
     [registry removeObjectForId:handleId];
   }
 
   void startDownload(
       int handleId,
+      const DownloadConfig& config,
       std::function<void(double, double, double)> onProgress,
       std::function<void()> onSuccess,
       std::function<void(std::string)> onError) override {
@@ -353,6 +509,15 @@ public:
     for (NSString *key in handle.headers) {
       [request setValue:handle.headers[key] forHTTPHeaderField:key];
     }
+    std::shared_ptr<DownloadResume> resume;
+    if (config.resume) {
+      resume = std::make_shared<DownloadResume>(
+          std::string([handle.url UTF8String]), std::string([handle.destPath UTF8String]));
+      for (const auto& [name, value] : resume->requestHeaders()) {
+        [request setValue:[NSString stringWithUTF8String:value.c_str()]
+            forHTTPHeaderField:[NSString stringWithUTF8String:name.c_str()]];
+      }
+    }
 
     NSString *destPath = handle.destPath;
     NSString *parentDir = [destPath stringByDeletingLastPathComponent];
@@ -361,42 +526,31 @@ public:
                                                 attributes:nil
                                                      error:nil];
 
-    DownloadSessionDelegate *delegate = [[DownloadSessionDelegate alloc] init];
-    delegate.stateLock = [NSLock new];
-    delegate.destPath = destPath;
-    delegate.handle = handle;
-    delegate.onProgress = ^(double downloaded, double total, double progress) {
-      onProgress(downloaded, total, progress);
-    };
-    delegate.onSuccess = ^{
-      onSuccess();
-    };
-    delegate.onError = ^(NSString *errorMsg) {
-      onError(std::string([errorMsg UTF8String]));
-    };
-
-    NSURLSessionConfiguration *config = [NSURLSessionConfiguration defaultSessionConfiguration];
-    config.timeoutIntervalForRequest = 30.0;
-    config.timeoutIntervalForResource = 600.0;
-    NSOperationQueue *delegateQueue = [[NSOperationQueue alloc] init];
-    delegateQueue.maxConcurrentOperationCount = 1;
-    NSURLSession *session = [NSURLSession sessionWithConfiguration:config
-                                                          delegate:delegate
-                                                     delegateQueue:delegateQueue];
-    NSURLSessionDataTask *task = [session dataTaskWithRequest:request];
-
-    // Store session and task on the handle so cancelDownload can properly invalidate
-    [handle storeSession:session task:task];
-
-    // Re-check: cancel may have been called between the first check and storeSession
-    if (handle.isCancelled) {
-      [task cancel];
-      [session invalidateAndCancel];
-      onError("[DOWNLOAD_CANCELLED] Download was cancelled");
+    auto progress = std::make_shared<DownloadProgress>(std::move(onProgress), config.progress);
+    auto hasher = NativeHandleRegistry::shared().downloadHasher(handleId);
+
+    if (config.segments > 1 && !config.resume) {
+      // Probing and fetching segments block, so they get their own thread.
+      NSURLRequest *baseRequest = [request copy];
+      std::thread([handle, baseRequest, config, progress, hasher,
+                   onSuccess = std::move(onSuccess), onError = std::move(onError)]() {
+        @autoreleasepool {
+          if (runSegmentedDownload(handle, baseRequest, config, progress, hasher,
+                                   onSuccess, onError)) {
+            return;
+          }
+          // No ranges, unknown length or too small: one plain stream.
+          startStreamDownload(handle, baseRequest, nullptr, nullptr, true, progress, hasher,
+                              onSuccess, onError);
+        }
+      }).detach();
       return;
     }
 
-    [task resume];
+    auto stream = config.stream ? NativeHandleRegistry::shared().downloadStream(handleId)
+                                : nullptr;
+    startStreamDownload(handle, request, resume, stream, config.writeFile, progress, hasher,
+                        std::move(onSuccess), std::move(onError));
   }
 
   void cancelDownload(int handleId) override {
@@ -408,26 +562,10 @@ public:
     }
   }
 
-  ReaderInfo getReaderInfo(int handleId) override {
-    ReaderInfo info{0, 0, false};
+  std::string downloadUrl(int handleId) override {
     HandleRegistry *registry = [HandleRegistry shared];
-    ReaderHandleIOS *reader = (ReaderHandleIOS *)[registry objectForId:handleId];
-    if (reader) {
-      info.fileSize = static_cast<double>(reader.fileSize);
-      info.bytesRead = static_cast<double>(reader.bytesRead);
-      info.isEOF = reader.isEOF;
-    }
-    return info;
-  }
-
-  WriterInfo getWriterInfo(int handleId) override {
-    WriterInfo info{0};
-    HandleRegistry *registry = [HandleRegistry shared];
-    WriterHandleIOS *writer = (WriterHandleIOS *)[registry objectForId:handleId];
-    if (writer) {
-      info.bytesWritten = static_cast<double>(writer.bytesWritten);
-    }
-    return info;
+    DownloaderHandleIOS *handle = (DownloaderHandleIOS *)[registry objectForId:handleId];
+    return handle ? std::string([handle.url UTF8String]) : std::string();
   }
 };
 
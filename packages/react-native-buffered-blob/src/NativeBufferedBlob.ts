@@ -39,9 +39,6 @@ export interface Spec extends TurboModule {
   cp(srcPath: string, destPath: string): Promise<void>;
   mv(srcPath: string, destPath: string): Promise<void>;
 
-  // --- Hashing ---
-  hashFile(path: string, algorithm: string): Promise<string>;
-
   // --- Constants ---
   getConstants(): {
     documentDir: string;
@@ -26,7 +26,6 @@ const mockNativeModule: Spec = {
   ls: jest.fn(async () => []),
   cp: jest.fn(async () => {}),
   mv: jest.fn(async () => {}),
-  hashFile: jest.fn(async () => 'mockhash'),
   getConstants: jest.fn(() => mockConstants),
 };
 
@@ -0,0 +1,92 @@
+// Mock NativeBufferedBlob before any imports
+jest.mock('../NativeBufferedBlob');
+
+import { getBufferPoolStats, setBufferPoolLimit } from '../api/bufferPool';
+import { BlobError, ErrorCode } from '../errors';
+import type { StreamingProxy } from '../module';
+
+const stats = {
+  hits: 10,
+  misses: 2,
+  releases: 11,
+  discards: 1,
+  retainedBytes: 131072,
+  maxRetainedBytes: 16777216,
+};
+
+let mockStreaming: StreamingProxy;
+
+beforeAll(() => {
+  mockStreaming = {
+    readNextChunk: jest.fn(),
+    readChunks: jest.fn(),
+    readAt: jest.fn(),
+    write: jest.fn(),
+    writev: jest.fn(),
+    setWriteBehind: jest.fn(),
+    setCompression: jest.fn(),
+    flush: jest.fn(),
+    close: jest.fn(),
+    setReadAhead: jest.fn(),
+    setDecompression: jest.fn(),
+    openMapped: jest.fn(),
+    readMapped: jest.fn(),
+    startDownload: jest.fn(),
+    cancelDownload: jest.fn(),
+    setDownloadPriority: jest.fn(),
+    setDownloadLimits: jest.fn(),
+    getDownloadQueueStats: jest.fn(),
+    verifyDownload: jest.fn(),
+    hashFile: jest.fn(),
+    hashFileTree: jest.fn(),
+    createHasher: jest.fn(),
+    updateHasher: jest.fn(),
+    digestHasher: jest.fn(),
+    attachHasher: jest.fn(),
+    getReaderInfo: jest.fn(),
+    getWriterInfo: jest.fn(),
+    getBufferPoolStats: jest.fn(() => stats),
+    setBufferPoolLimit: jest.fn(),
+    getStats: jest.fn(),
+    resetStats: jest.fn(),
+  };
+  globalThis.__BufferedBlobStreaming = mockStreaming;
+});
+
+describe('getBufferPoolStats', () => {
+  it('should return native pool counters', () => {
+    expect(getBufferPoolStats()).toEqual(stats);
+  });
+});
+
+describe('setBufferPoolLimit', () => {
+  beforeEach(() => {
+    jest.clearAllMocks();
+  });
+
+  it('should forward the limit to native', () => {
+    setBufferPoolLimit(4194304);
+
+    expect(mockStreaming.setBufferPoolLimit).toHaveBeenCalledWith(4194304);
+  });
+
+  it('should accept 0 to disable pooling', () => {
+    setBufferPoolLimit(0);
+
+    expect(mockStreaming.setBufferPoolLimit).toHaveBeenCalledWith(0);
+  });
+
+  it('should throw INVALID_ARGUMENT for negative limits', () => {
+    expect(() => setBufferPoolLimit(-1)).toThrow(BlobError);
+    expect(() => setBufferPoolLimit(-1)).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(mockStreaming.setBufferPoolLimit).not.toHaveBeenCalled();
+  });
+
+  it('should throw INVALID_ARGUMENT for NaN', () => {
+    expect(() => setBufferPoolLimit(NaN)).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+  });
+});
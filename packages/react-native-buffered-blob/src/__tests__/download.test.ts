@@ -5,6 +5,9 @@ import NativeModule from '../NativeBufferedBlob';
 import { download } from '../api/download';
 import { BlobError, ErrorCode } from '../errors';
 import type { StreamingProxy } from '../module';
+import { DownloadPriority } from '../types';
+import { HashAlgorithm } from '../types';
+import type { BlobHasher } from '../types';
 
 describe('download', () => {
   let mockStreaming: jest.Mocked<StreamingProxy>;
@@ -12,11 +15,30 @@ describe('download', () => {
   beforeAll(() => {
     mockStreaming = {
       readNextChunk: jest.fn(),
+      readChunks: jest.fn(),
+      readAt: jest.fn(),
       write: jest.fn(),
+      writev: jest.fn(),
+      setWriteBehind: jest.fn(),
+      setCompression: jest.fn(),
       flush: jest.fn(),
       close: jest.fn(),
+      setReadAhead: jest.fn(),
+      setDecompression: jest.fn(),
+      openMapped: jest.fn(),
+      readMapped: jest.fn(),
       startDownload: jest.fn(),
       cancelDownload: jest.fn(),
+      setDownloadPriority: jest.fn(),
+      setDownloadLimits: jest.fn(),
+      getDownloadQueueStats: jest.fn(),
+      verifyDownload: jest.fn(),
+      hashFile: jest.fn(),
+      hashFileTree: jest.fn(),
+      createHasher: jest.fn(),
+      updateHasher: jest.fn(),
+      digestHasher: jest.fn(),
+      attachHasher: jest.fn(),
       getReaderInfo: jest.fn((_handleId: number) => ({
         fileSize: 1024,
         bytesRead: 0,
@@ -24,7 +46,12 @@ describe('download', () => {
       })),
       getWriterInfo: jest.fn((_handleId: number) => ({
         bytesWritten: 0,
+        pendingBytes: 0,
       })),
+      getBufferPoolStats: jest.fn(),
+      setBufferPoolLimit: jest.fn(),
+      getStats: jest.fn(),
+      resetStats: jest.fn(),
     };
     globalThis.__BufferedBlobStreaming = mockStreaming;
   });
@@ -72,7 +99,16 @@ describe('download', () => {
     await expect(promise).resolves.toBeUndefined();
     expect(mockStreaming.startDownload).toHaveBeenCalledWith(
       10,
-      expect.any(Function)
+      expect.any(Function),
+      100,
+      0,
+      false,
+      1,
+      1048576,
+      1,
+      false,
+      true,
+      1048576
     );
   });
 
@@ -129,7 +165,16 @@ describe('download', () => {
     // Get the callback passed to startDownload
     expect(mockStreaming.startDownload).toHaveBeenCalledWith(
       50,
-      expect.any(Function)
+      expect.any(Function),
+      100,
+      0,
+      false,
+      1,
+      1048576,
+      1,
+      false,
+      true,
+      1048576
     );
     const progressCallback = mockStreaming.startDownload.mock.calls[0]?.[1];
 
@@ -155,7 +200,16 @@ describe('download', () => {
 
     expect(mockStreaming.startDownload).toHaveBeenCalledWith(
       60,
-      expect.any(Function)
+      expect.any(Function),
+      100,
+      0,
+      false,
+      1,
+      1048576,
+      1,
+      false,
+      true,
+      1048576
     );
     const progressCallback = mockStreaming.startDownload.mock.calls[0]?.[1];
 
@@ -165,6 +219,87 @@ describe('download', () => {
     await promise;
   });
 
+  it('should pass progress throttle options to startDownload', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(65);
+
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      onProgress: jest.fn(),
+      progressInterval: 250,
+      progressBytes: 65536,
+    });
+
+    expect(mockStreaming.startDownload).toHaveBeenCalledWith(
+      65,
+      expect.any(Function),
+      250,
+      65536,
+      false,
+      1,
+      1048576,
+      1,
+      false,
+      true,
+      1048576
+    );
+
+    await promise;
+  });
+
+  it('should pass resume to startDownload', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(66);
+
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      resume: true,
+    });
+
+    expect(mockStreaming.startDownload).toHaveBeenCalledWith(
+      66,
+      expect.any(Function),
+      100,
+      0,
+      true,
+      1,
+      1048576,
+      1,
+      false,
+      true,
+      1048576
+    );
+
+    await promise;
+  });
+
+  it('should pass segment options to startDownload', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(67);
+
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      segments: 4,
+      minSegmentSize: 65536,
+    });
+
+    expect(mockStreaming.startDownload).toHaveBeenCalledWith(
+      67,
+      expect.any(Function),
+      100,
+      0,
+      false,
+      4,
+      65536,
+      1,
+      false,
+      true,
+      1048576
+    );
+
+    await promise;
+  });
+
   it('should return cancel function that calls cancelDownload', () => {
     (NativeModule.createDownload as jest.Mock).mockReturnValue(77);
 
@@ -178,6 +313,45 @@ describe('download', () => {
     expect(mockStreaming.cancelDownload).toHaveBeenCalledWith(77);
   });
 
+  it('should pass priority to startDownload', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(68);
+
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      priority: DownloadPriority.HIGH,
+    });
+
+    expect(mockStreaming.startDownload).toHaveBeenCalledWith(
+      68,
+      expect.any(Function),
+      100,
+      0,
+      false,
+      1,
+      1048576,
+      2,
+      false,
+      true,
+      1048576
+    );
+
+    await promise;
+  });
+
+  it('should reprioritize through setDownloadPriority', () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(78);
+    mockStreaming.setDownloadPriority.mockReturnValue(true);
+
+    const { setPriority } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+    });
+
+    expect(setPriority(DownloadPriority.LOW)).toBe(true);
+    expect(mockStreaming.setDownloadPriority).toHaveBeenCalledWith(78, 0);
+  });
+
   it('should wrap creation errors with path', () => {
     (NativeModule.createDownload as jest.Mock).mockImplementation(() => {
       throw new Error('[PERMISSION_DENIED] Cannot write to destination');
@@ -201,4 +375,206 @@ describe('download', () => {
       })
     );
   });
+
+  it('should require destPath unless streaming', () => {
+    expect(() => download({ url: 'https://example.com/file.zip' })).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(NativeModule.createDownload).not.toHaveBeenCalled();
+  });
+
+  it('should stream without writing a file when destPath is omitted', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(79);
+
+    const { promise, stream } = download({
+      url: 'https://example.com/file.zip',
+      stream: true,
+      streamBufferSize: 65536,
+    });
+
+    expect(NativeModule.createDownload).toHaveBeenCalledWith(
+      'https://example.com/file.zip',
+      '',
+      {}
+    );
+    expect(mockStreaming.startDownload).toHaveBeenCalledWith(
+      79,
+      expect.any(Function),
+      100,
+      0,
+      false,
+      1,
+      1048576,
+      1,
+      true,
+      false,
+      65536
+    );
+    expect(stream).toBeDefined();
+    await promise;
+    stream!.close();
+  });
+
+  it('should reject an invalid streamBufferSize', () => {
+    expect(() =>
+      download({
+        url: 'https://example.com/file.zip',
+        stream: true,
+        streamBufferSize: 0,
+      })
+    ).toThrow(expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT }));
+  });
+
+  it('should keep a streamed download open until its reader ends', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(80);
+    const chunk = new ArrayBuffer(8);
+    mockStreaming.readNextChunk
+      .mockResolvedValueOnce(chunk)
+      .mockResolvedValueOnce(null);
+
+    const { promise, stream } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      stream: true,
+    });
+    await promise;
+    expect(NativeModule.closeHandle).not.toHaveBeenCalled();
+
+    expect(await stream!.readNextChunk()).toBe(chunk);
+    expect(stream!.bytesRead).toBe(8);
+    expect(await stream!.readNextChunk()).toBeNull();
+    expect(stream!.isEOF).toBe(true);
+    expect(NativeModule.closeHandle).toHaveBeenCalledTimes(1);
+    expect(NativeModule.closeHandle).toHaveBeenCalledWith(80);
+    expect(mockStreaming.readNextChunk).toHaveBeenCalledWith(80);
+  });
+
+  it('should cancel the transfer when the stream is closed early', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(81);
+    mockStreaming.startDownload.mockRejectedValue(
+      new Error('[DOWNLOAD_CANCELLED] Download was cancelled')
+    );
+
+    const { promise, stream } = download({
+      url: 'https://example.com/file.zip',
+      stream: true,
+    });
+    stream!.close();
+    expect(mockStreaming.cancelDownload).toHaveBeenCalledWith(81);
+    await expect(promise).rejects.toThrow();
+    expect(NativeModule.closeHandle).toHaveBeenCalledTimes(1);
+    await expect(stream!.readNextChunk()).rejects.toThrow(
+      expect.objectContaining({ code: ErrorCode.READER_CLOSED })
+    );
+  });
+
+  it('should attach a hasher before starting the download', async () => {
+    const hasher = { handleId: 42 } as BlobHasher;
+
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      hasher,
+    });
+    await promise;
+
+    expect(mockStreaming.attachHasher).toHaveBeenCalledWith(10, 42);
+    expect(mockStreaming.attachHasher.mock.invocationCallOrder[0]).toBeLessThan(
+      mockStreaming.startDownload.mock.invocationCallOrder[0]!
+    );
+  });
+
+  it('should register integrity expectations before starting', async () => {
+    (NativeModule.createDownload as jest.Mock).mockReturnValue(82);
+
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      expectedHash: { algorithm: HashAlgorithm.SHA256, digest: 'ab12' },
+      expectedSize: 2048,
+    });
+    await promise;
+
+    expect(mockStreaming.verifyDownload).toHaveBeenCalledWith(
+      82,
+      '/downloads/file.zip',
+      'sha256',
+      'ab12',
+      2048
+    );
+    expect(
+      mockStreaming.verifyDownload.mock.invocationCallOrder[0]
+    ).toBeLessThan(mockStreaming.startDownload.mock.invocationCallOrder[0]!);
+  });
+
+  it('should check only the size when no hash is given', async () => {
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      expectedSize: 0,
+    });
+    await promise;
+
+    expect(mockStreaming.verifyDownload).toHaveBeenCalledWith(
+      10,
+      '/downloads/file.zip',
+      '',
+      '',
+      0
+    );
+  });
+
+  it('should not verify without expectations', async () => {
+    await download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+    }).promise;
+
+    expect(mockStreaming.verifyDownload).not.toHaveBeenCalled();
+  });
+
+  it('should reject an invalid expectedSize', () => {
+    expect(() =>
+      download({
+        url: 'https://example.com/file.zip',
+        destPath: '/downloads/file.zip',
+        expectedSize: -5,
+      })
+    ).toThrow(expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT }));
+    expect(NativeModule.createDownload).not.toHaveBeenCalled();
+  });
+
+  it('should close the handle when verification cannot be set up', () => {
+    mockStreaming.verifyDownload.mockImplementationOnce(() => {
+      throw new Error('[INVALID_ARGUMENT] Unsupported hash algorithm: sha1');
+    });
+
+    expect(() =>
+      download({
+        url: 'https://example.com/file.zip',
+        destPath: '/downloads/file.zip',
+        expectedHash: {
+          algorithm: 'sha1' as HashAlgorithm,
+          digest: 'ab12',
+        },
+      })
+    ).toThrow(expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT }));
+    expect(NativeModule.closeHandle).toHaveBeenCalledWith(10);
+    expect(mockStreaming.startDownload).not.toHaveBeenCalled();
+  });
+
+  it('should surface an integrity mismatch from the native side', async () => {
+    mockStreaming.startDownload.mockRejectedValue(
+      new Error('[INTEGRITY_MISMATCH] Expected 2048 bytes, received 1024')
+    );
+
+    const { promise } = download({
+      url: 'https://example.com/file.zip',
+      destPath: '/downloads/file.zip',
+      expectedSize: 2048,
+    });
+
+    await expect(promise).rejects.toThrow('[INTEGRITY_MISMATCH]');
+    expect(NativeModule.closeHandle).toHaveBeenCalledWith(10);
+  });
 });
@@ -0,0 +1,93 @@
+// Mock NativeBufferedBlob before any imports
+jest.mock('../NativeBufferedBlob');
+
+import {
+  getDownloadQueueStats,
+  setDownloadLimits,
+} from '../api/downloadQueue';
+import { BlobError, ErrorCode } from '../errors';
+import type { StreamingProxy } from '../module';
+
+const stats = {
+  running: 6,
+  queued: 40,
+  started: 12,
+  cancelledWhileQueued: 3,
+  totalWaitMs: 5400,
+  maxWaitMs: 900,
+  maxConcurrent: 6,
+  maxPerHost: 4,
+};
+
+let mockStreaming: StreamingProxy;
+
+beforeAll(() => {
+  mockStreaming = {
+    readNextChunk: jest.fn(),
+    readChunks: jest.fn(),
+    readAt: jest.fn(),
+    write: jest.fn(),
+    writev: jest.fn(),
+    setWriteBehind: jest.fn(),
+    setCompression: jest.fn(),
+    flush: jest.fn(),
+    close: jest.fn(),
+    setReadAhead: jest.fn(),
+    setDecompression: jest.fn(),
+    openMapped: jest.fn(),
+    readMapped: jest.fn(),
+    startDownload: jest.fn(),
+    cancelDownload: jest.fn(),
+    setDownloadPriority: jest.fn(),
+    setDownloadLimits: jest.fn(),
+    getDownloadQueueStats: jest.fn(() => stats),
+    verifyDownload: jest.fn(),
+    hashFile: jest.fn(),
+    hashFileTree: jest.fn(),
+    createHasher: jest.fn(),
+    updateHasher: jest.fn(),
+    digestHasher: jest.fn(),
+    attachHasher: jest.fn(),
+    getReaderInfo: jest.fn(),
+    getWriterInfo: jest.fn(),
+    getBufferPoolStats: jest.fn(),
+    setBufferPoolLimit: jest.fn(),
+    getStats: jest.fn(),
+    resetStats: jest.fn(),
+  };
+  globalThis.__BufferedBlobStreaming = mockStreaming;
+});
+
+describe('getDownloadQueueStats', () => {
+  it('should return native queue counters', () => {
+    expect(getDownloadQueueStats()).toEqual(stats);
+  });
+});
+
+describe('setDownloadLimits', () => {
+  beforeEach(() => {
+    jest.clearAllMocks();
+  });
+
+  it('should forward the limits to native', () => {
+    setDownloadLimits({ maxConcurrent: 8, maxPerHost: 2 });
+
+    expect(mockStreaming.setDownloadLimits).toHaveBeenCalledWith(8, 2);
+  });
+
+  it('should throw INVALID_ARGUMENT for limits below 1', () => {
+    expect(() => setDownloadLimits({ maxConcurrent: 0, maxPerHost: 2 })).toThrow(
+      BlobError
+    );
+    expect(() => setDownloadLimits({ maxConcurrent: 4, maxPerHost: 0 })).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(mockStreaming.setDownloadLimits).not.toHaveBeenCalled();
+  });
+
+  it('should throw INVALID_ARGUMENT for fractional limits', () => {
+    expect(() =>
+      setDownloadLimits({ maxConcurrent: 2.5, maxPerHost: 1 })
+    ).toThrow(expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT }));
+  });
+});
@@ -97,6 +97,7 @@ describe('wrapError', () => {
       'INVALID_ARGUMENT',
       'DOWNLOAD_FAILED',
       'DOWNLOAD_CANCELLED',
+      'INTEGRITY_MISMATCH',
       'READER_CLOSED',
       'WRITER_CLOSED',
     ];
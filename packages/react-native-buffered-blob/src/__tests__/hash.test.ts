@@ -1,22 +1,61 @@
 // Mock NativeBufferedBlob before any imports
 jest.mock('../NativeBufferedBlob');
 
-import NativeModule from '../NativeBufferedBlob';
-import { hashFile } from '../api/hash';
+import { hashFile, hashFileTree, createHasher } from '../api/hash';
 import { HashAlgorithm } from '../types';
 import { BlobError, ErrorCode } from '../errors';
+import type { StreamingProxy } from '../module';
 
 describe('hashFile', () => {
+  let mockStreaming: jest.Mocked<StreamingProxy>;
+
+  beforeAll(() => {
+    mockStreaming = {
+      readNextChunk: jest.fn(),
+      readChunks: jest.fn(),
+      readAt: jest.fn(),
+      write: jest.fn(),
+      writev: jest.fn(),
+      setWriteBehind: jest.fn(),
+      setCompression: jest.fn(),
+      flush: jest.fn(),
+      close: jest.fn(),
+      setReadAhead: jest.fn(),
+      setDecompression: jest.fn(),
+      openMapped: jest.fn(),
+      readMapped: jest.fn(),
+      startDownload: jest.fn(),
+      cancelDownload: jest.fn(),
+      setDownloadPriority: jest.fn(),
+      setDownloadLimits: jest.fn(),
+      getDownloadQueueStats: jest.fn(),
+      verifyDownload: jest.fn(),
+      hashFile: jest.fn(),
+      hashFileTree: jest.fn(),
+      createHasher: jest.fn(),
+      updateHasher: jest.fn(),
+      digestHasher: jest.fn(),
+      attachHasher: jest.fn(),
+      getReaderInfo: jest.fn(),
+      getWriterInfo: jest.fn(),
+      getBufferPoolStats: jest.fn(),
+      setBufferPoolLimit: jest.fn(),
+      getStats: jest.fn(),
+      resetStats: jest.fn(),
+    };
+    globalThis.__BufferedBlobStreaming = mockStreaming;
+  });
+
   beforeEach(() => {
     jest.clearAllMocks();
   });
 
   it('should use SHA256 by default', async () => {
-    (NativeModule.hashFile as jest.Mock).mockResolvedValue('abc123');
+    mockStreaming.hashFile.mockResolvedValue('abc123');
 
     const result = await hashFile('/test/file.txt');
 
-    expect(NativeModule.hashFile).toHaveBeenCalledWith(
+    expect(mockStreaming.hashFile).toHaveBeenCalledWith(
       '/test/file.txt',
       HashAlgorithm.SHA256
     );
@@ -24,11 +63,11 @@ describe('hashFile', () => {
   });
 
   it('should accept MD5 algorithm', async () => {
-    (NativeModule.hashFile as jest.Mock).mockResolvedValue('def456');
+    mockStreaming.hashFile.mockResolvedValue('def456');
 
     const result = await hashFile('/test/file.txt', HashAlgorithm.MD5);
 
-    expect(NativeModule.hashFile).toHaveBeenCalledWith(
+    expect(mockStreaming.hashFile).toHaveBeenCalledWith(
       '/test/file.txt',
       HashAlgorithm.MD5
     );
@@ -36,19 +75,31 @@ describe('hashFile', () => {
   });
 
   it('should accept SHA256 algorithm explicitly', async () => {
-    (NativeModule.hashFile as jest.Mock).mockResolvedValue('789ghi');
+    mockStreaming.hashFile.mockResolvedValue('789ghi');
 
     const result = await hashFile('/test/file.txt', HashAlgorithm.SHA256);
 
-    expect(NativeModule.hashFile).toHaveBeenCalledWith(
+    expect(mockStreaming.hashFile).toHaveBeenCalledWith(
       '/test/file.txt',
       HashAlgorithm.SHA256
     );
     expect(result).toBe('789ghi');
   });
 
+  it.each([
+    [HashAlgorithm.BLAKE3, 'blake3'],
+    [HashAlgorithm.XXH3, 'xxh3'],
+    [HashAlgorithm.CRC32C, 'crc32c'],
+  ])('should pass %s through to the native engine', async (algorithm, name) => {
+    mockStreaming.hashFile.mockResolvedValue('00');
+
+    await hashFile('/test/file.txt', algorithm);
+
+    expect(mockStreaming.hashFile).toHaveBeenCalledWith('/test/file.txt', name);
+  });
+
   it('should wrap errors with path', async () => {
-    (NativeModule.hashFile as jest.Mock).mockRejectedValue(
+    mockStreaming.hashFile.mockRejectedValue(
       new Error('[FILE_NOT_FOUND] File does not exist')
     );
 
@@ -62,7 +113,7 @@ describe('hashFile', () => {
   });
 
   it('should handle IO errors', async () => {
-    (NativeModule.hashFile as jest.Mock).mockRejectedValue(
+    mockStreaming.hashFile.mockRejectedValue(
       new Error('[IO_ERROR] Failed to read file')
     );
 
@@ -75,4 +126,140 @@ describe('hashFile', () => {
       })
     );
   });
+
+  it('should wrap synchronous errors from the proxy', async () => {
+    mockStreaming.hashFile.mockImplementation(() => {
+      throw new Error('[INVALID_ARGUMENT] Unsupported hash algorithm: sha1');
+    });
+
+    await expect(
+      hashFile('/test/file.txt', 'sha1' as HashAlgorithm)
+    ).rejects.toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+  });
+});
+
+describe('createHasher', () => {
+  let mockStreaming: jest.Mocked<StreamingProxy>;
+
+  beforeAll(() => {
+    mockStreaming = globalThis.__BufferedBlobStreaming as jest.Mocked<StreamingProxy>;
+  });
+
+  beforeEach(() => {
+    jest.clearAllMocks();
+    mockStreaming.createHasher.mockReturnValue(21);
+  });
+
+  it('should create a SHA256 hasher by default', () => {
+    const hasher = createHasher();
+
+    expect(mockStreaming.createHasher).toHaveBeenCalledWith(
+      HashAlgorithm.SHA256
+    );
+    expect(hasher.handleId).toBe(21);
+    expect(hasher.algorithm).toBe(HashAlgorithm.SHA256);
+  });
+
+  it('should delegate update and digest to the native hasher', () => {
+    mockStreaming.digestHasher.mockReturnValue('cafe');
+    const hasher = createHasher(HashAlgorithm.XXH3);
+    const data = new ArrayBuffer(8);
+
+    hasher.update(data);
+
+    expect(mockStreaming.updateHasher).toHaveBeenCalledWith(21, data);
+    expect(hasher.digest()).toBe('cafe');
+  });
+
+  it('should close once and reject use after close', () => {
+    const hasher = createHasher();
+
+    hasher.close();
+    hasher[Symbol.dispose]();
+
+    expect(mockStreaming.close).toHaveBeenCalledTimes(1);
+    expect(mockStreaming.close).toHaveBeenCalledWith(21);
+    expect(() => hasher.update(new ArrayBuffer(1))).toThrow(BlobError);
+    expect(() => hasher.digest()).toThrow(BlobError);
+  });
+
+  it('should wrap native errors', () => {
+    mockStreaming.createHasher.mockImplementation(() => {
+      throw new Error('[INVALID_ARGUMENT] Unsupported hash algorithm: sha1');
+    });
+
+    expect(() => createHasher('sha1' as HashAlgorithm)).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+  });
+});
+
+describe('hashFileTree', () => {
+  let mockStreaming: jest.Mocked<StreamingProxy>;
+
+  beforeAll(() => {
+    mockStreaming = globalThis.__BufferedBlobStreaming as jest.Mocked<StreamingProxy>;
+  });
+
+  beforeEach(() => {
+    jest.clearAllMocks();
+  });
+
+  it('should default to BLAKE3 with 1MB chunks', async () => {
+    mockStreaming.hashFileTree.mockResolvedValue({
+      digest: 'abc',
+      chunkSize: 1048576,
+    });
+
+    const result = await hashFileTree('/test/big.bin');
+
+    expect(mockStreaming.hashFileTree).toHaveBeenCalledWith(
+      '/test/big.bin',
+      HashAlgorithm.BLAKE3,
+      1048576,
+      false
+    );
+    expect(result).toEqual({ digest: 'abc', chunkSize: 1048576 });
+  });
+
+  it('should pass algorithm, chunk size and chunk digest options', async () => {
+    mockStreaming.hashFileTree.mockResolvedValue({
+      digest: 'root',
+      chunkSize: 65536,
+      chunkDigests: ['a', 'b'],
+    });
+
+    const result = await hashFileTree('/test/big.bin', {
+      algorithm: HashAlgorithm.SHA256,
+      chunkSize: 65536,
+      includeChunkDigests: true,
+    });
+
+    expect(mockStreaming.hashFileTree).toHaveBeenCalledWith(
+      '/test/big.bin',
+      HashAlgorithm.SHA256,
+      65536,
+      true
+    );
+    expect(result.chunkDigests).toEqual(['a', 'b']);
+  });
+
+  it('should wrap errors with path', async () => {
+    mockStreaming.hashFileTree.mockImplementation(() => {
+      throw new Error(
+        '[INVALID_ARGUMENT] Tree hashing supports blake3 and sha256, got: md5'
+      );
+    });
+
+    await expect(
+      hashFileTree('/test/big.bin', { algorithm: HashAlgorithm.MD5 })
+    ).rejects.toThrow(
+      expect.objectContaining({
+        code: ErrorCode.INVALID_ARGUMENT,
+        path: '/test/big.bin',
+      })
+    );
+  });
 });
@@ -2,19 +2,40 @@
 jest.mock('../NativeBufferedBlob');
 
 import NativeModule from '../NativeBufferedBlob';
-import { createReader } from '../api/readFile';
+import { createReader, createMappedReader } from '../api/readFile';
 import { BlobError, ErrorCode } from '../errors';
 import type { StreamingProxy } from '../module';
+import { CompressionFormat } from '../types';
+import type { BlobHasher } from '../types';
 
 // Set up global streaming proxy
 beforeAll(() => {
   const mockStreaming: StreamingProxy = {
     readNextChunk: jest.fn(),
+    readChunks: jest.fn(),
+    readAt: jest.fn(),
     write: jest.fn(),
+    writev: jest.fn(),
+    setWriteBehind: jest.fn(),
+    setCompression: jest.fn(),
     flush: jest.fn(),
     close: jest.fn(),
+    setReadAhead: jest.fn(),
+    setDecompression: jest.fn(),
+    openMapped: jest.fn(),
+    readMapped: jest.fn(),
     startDownload: jest.fn(),
     cancelDownload: jest.fn(),
+    setDownloadPriority: jest.fn(),
+    setDownloadLimits: jest.fn(),
+    getDownloadQueueStats: jest.fn(),
+    verifyDownload: jest.fn(),
+    hashFile: jest.fn(),
+    hashFileTree: jest.fn(),
+    createHasher: jest.fn(),
+    updateHasher: jest.fn(),
+    digestHasher: jest.fn(),
+    attachHasher: jest.fn(),
     getReaderInfo: jest.fn(() => ({
       fileSize: 1024,
       bytesRead: 0,
@@ -22,7 +43,12 @@ beforeAll(() => {
     })),
     getWriterInfo: jest.fn(() => ({
       bytesWritten: 0,
+      pendingBytes: 0,
     })),
+    getBufferPoolStats: jest.fn(),
+    setBufferPoolLimit: jest.fn(),
+    getStats: jest.fn(),
+    resetStats: jest.fn(),
   };
   globalThis.__BufferedBlobStreaming = mockStreaming;
 });
@@ -111,4 +137,141 @@ describe('createReader', () => {
       })
     );
   });
+
+  it('should not enable read-ahead by default', () => {
+    createReader('/test/file.txt');
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(streaming.setReadAhead).not.toHaveBeenCalled();
+  });
+
+  it('should enable read-ahead on the new handle', () => {
+    (NativeModule.openRead as jest.Mock).mockReturnValue(7);
+
+    createReader('/test/file.txt', 8192, { readAhead: 2 });
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(NativeModule.openRead).toHaveBeenCalledWith('/test/file.txt', 8192);
+    expect(streaming.setReadAhead).toHaveBeenCalledWith(7, 2);
+  });
+
+  it('should throw INVALID_ARGUMENT for out-of-range readAhead', () => {
+    expect(() =>
+      createReader('/test/file.txt', undefined, { readAhead: 17 })
+    ).toThrow(
+      expect.objectContaining({
+        code: ErrorCode.INVALID_ARGUMENT,
+        message: expect.stringContaining('readAhead must be an integer'),
+      })
+    );
+    expect(() =>
+      createReader('/test/file.txt', undefined, { readAhead: 1.5 })
+    ).toThrow(BlobError);
+    expect(NativeModule.openRead).not.toHaveBeenCalled();
+  });
+
+  it('should attach a hasher to the new handle', () => {
+    (NativeModule.openRead as jest.Mock).mockReturnValue(9);
+    const hasher = { handleId: 42 } as BlobHasher;
+
+    createReader('/test/file.txt', undefined, { hasher });
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(streaming.attachHasher).toHaveBeenCalledWith(9, 42);
+  });
+
+  it('should close the reader when the hasher cannot be attached', () => {
+    (NativeModule.openRead as jest.Mock).mockReturnValue(9);
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    (streaming.attachHasher as jest.Mock).mockImplementationOnce(() => {
+      throw new Error('[INVALID_ARGUMENT] Hasher handle not found: 42');
+    });
+    const hasher = { handleId: 42 } as BlobHasher;
+
+    expect(() => createReader('/test/file.txt', undefined, { hasher })).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(streaming.close).toHaveBeenCalledWith(9);
+  });
+
+  it('should enable decompression before read-ahead', () => {
+    (NativeModule.openRead as jest.Mock).mockReturnValue(12);
+    const streaming = globalThis.__BufferedBlobStreaming as jest.Mocked<StreamingProxy>;
+
+    createReader('/test/log.json.gz', undefined, {
+      decompress: CompressionFormat.GZIP,
+      readAhead: 2,
+    });
+
+    expect(streaming.setDecompression).toHaveBeenCalledWith(
+      12,
+      'gzip',
+      undefined
+    );
+    expect(
+      streaming.setDecompression.mock.invocationCallOrder[0]
+    ).toBeLessThan(streaming.setReadAhead.mock.invocationCallOrder[0]!);
+  });
+
+  it('should close the reader when decompression cannot be enabled', () => {
+    (NativeModule.openRead as jest.Mock).mockReturnValue(13);
+    const streaming = globalThis.__BufferedBlobStreaming as jest.Mocked<StreamingProxy>;
+    streaming.setDecompression.mockImplementationOnce(() => {
+      throw new Error(
+        '[INVALID_ARGUMENT] zstd support is not compiled into this build'
+      );
+    });
+
+    expect(() =>
+      createReader('/test/data.zst', undefined, {
+        decompress: CompressionFormat.ZSTD,
+        windowBits: 31,
+      })
+    ).toThrow(
+      expect.objectContaining({
+        code: ErrorCode.INVALID_ARGUMENT,
+        path: '/test/data.zst',
+      })
+    );
+    expect(streaming.setDecompression).toHaveBeenCalledWith(13, 'zstd', 31);
+    expect(streaming.close).toHaveBeenCalledWith(13);
+  });
+});
+
+describe('createMappedReader', () => {
+  let streaming: jest.Mocked<StreamingProxy>;
+
+  beforeEach(() => {
+    jest.clearAllMocks();
+    streaming = globalThis.__BufferedBlobStreaming as jest.Mocked<StreamingProxy>;
+    streaming.openMapped.mockReturnValue({ handleId: 11, fileSize: 2048 });
+  });
+
+  it('should map the file and report its size', () => {
+    const reader = createMappedReader('/test/model.bin');
+
+    expect(streaming.openMapped).toHaveBeenCalledWith('/test/model.bin');
+    expect(reader.handleId).toBe(11);
+    expect(reader.fileSize).toBe(2048);
+  });
+
+  it('should throw INVALID_ARGUMENT for a non-positive chunkSize', () => {
+    expect(() => createMappedReader('/test/model.bin', 0)).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(streaming.openMapped).not.toHaveBeenCalled();
+  });
+
+  it('should wrap native errors with path', () => {
+    streaming.openMapped.mockImplementation(() => {
+      throw new Error('[FILE_NOT_FOUND] File does not exist');
+    });
+
+    expect(() => createMappedReader('/missing.bin')).toThrow(
+      expect.objectContaining({
+        code: ErrorCode.FILE_NOT_FOUND,
+        path: '/missing.bin',
+      })
+    );
+  });
 });
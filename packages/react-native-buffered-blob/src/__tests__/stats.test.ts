@@ -0,0 +1,135 @@
+// Mock NativeBufferedBlob before any imports
+jest.mock('../NativeBufferedBlob');
+
+import { getStats, resetStats } from '../api/stats';
+import { BlobError, ErrorCode } from '../errors';
+import type { StreamingProxy } from '../module';
+import type { LatencySummary, StreamingStats } from '../types';
+
+const emptyLatency: LatencySummary = {
+  count: 0,
+  minUs: 0,
+  meanUs: 0,
+  p50Us: 0,
+  p90Us: 0,
+  p99Us: 0,
+  p999Us: 0,
+  maxUs: 0,
+};
+
+const readLatency: LatencySummary = {
+  count: 3,
+  minUs: 120,
+  meanUs: 410.5,
+  p50Us: 383,
+  p90Us: 895,
+  p99Us: 895,
+  p999Us: 895,
+  maxUs: 880,
+};
+
+function operation(completed: number, bytes: number) {
+  const latency = completed > 0 ? readLatency : emptyLatency;
+  return {
+    completed,
+    failed: 0,
+    bytes,
+    latency: {
+      bridge: latency,
+      queue: latency,
+      io: latency,
+      delivery: latency,
+      total: latency,
+    },
+  };
+}
+
+const stats: StreamingStats = {
+  windowMs: 1500,
+  operations: {
+    readNextChunk: operation(3, 196608),
+    readChunks: operation(0, 0),
+    readAt: operation(0, 0),
+    write: operation(0, 0),
+    writev: operation(0, 0),
+    flush: operation(0, 0),
+    hashFile: operation(0, 0),
+    hashFileTree: operation(0, 0),
+  },
+};
+
+let mockStreaming: StreamingProxy;
+
+beforeAll(() => {
+  mockStreaming = {
+    readNextChunk: jest.fn(),
+    readChunks: jest.fn(),
+    readAt: jest.fn(),
+    write: jest.fn(),
+    writev: jest.fn(),
+    setWriteBehind: jest.fn(),
+    setCompression: jest.fn(),
+    flush: jest.fn(),
+    close: jest.fn(),
+    setReadAhead: jest.fn(),
+    setDecompression: jest.fn(),
+    openMapped: jest.fn(),
+    readMapped: jest.fn(),
+    startDownload: jest.fn(),
+    cancelDownload: jest.fn(),
+    setDownloadPriority: jest.fn(),
+    setDownloadLimits: jest.fn(),
+    getDownloadQueueStats: jest.fn(),
+    verifyDownload: jest.fn(),
+    hashFile: jest.fn(),
+    hashFileTree: jest.fn(),
+    createHasher: jest.fn(),
+    updateHasher: jest.fn(),
+    digestHasher: jest.fn(),
+    attachHasher: jest.fn(),
+    getReaderInfo: jest.fn(),
+    getWriterInfo: jest.fn(),
+    getBufferPoolStats: jest.fn(),
+    setBufferPoolLimit: jest.fn(),
+    getStats: jest.fn(() => stats),
+    resetStats: jest.fn(),
+  };
+  globalThis.__BufferedBlobStreaming = mockStreaming;
+});
+
+beforeEach(() => {
+  jest.clearAllMocks();
+});
+
+describe('getStats', () => {
+  it('should return native operation statistics', () => {
+    expect(getStats()).toEqual(stats);
+    expect(mockStreaming.getStats).toHaveBeenCalledTimes(1);
+  });
+
+  it('should wrap native errors', () => {
+    (mockStreaming.getStats as jest.Mock).mockImplementationOnce(() => {
+      throw new Error('[IO_ERROR] stats unavailable');
+    });
+
+    expect(() => getStats()).toThrow(BlobError);
+  });
+});
+
+describe('resetStats', () => {
+  it('should reset native statistics', () => {
+    resetStats();
+
+    expect(mockStreaming.resetStats).toHaveBeenCalledTimes(1);
+  });
+
+  it('should wrap native errors', () => {
+    (mockStreaming.resetStats as jest.Mock).mockImplementationOnce(() => {
+      throw new Error('[IO_ERROR] reset failed');
+    });
+
+    expect(() => resetStats()).toThrow(
+      expect.objectContaining({ code: ErrorCode.IO_ERROR })
+    );
+  });
+});
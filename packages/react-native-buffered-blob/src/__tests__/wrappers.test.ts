@@ -1,7 +1,7 @@
 // Mock NativeBufferedBlob before any imports
 jest.mock('../NativeBufferedBlob');
 
-import { wrapReader, wrapWriter } from '../wrappers';
+import { wrapReader, wrapMappedReader, wrapWriter } from '../wrappers';
 import type { StreamingProxy } from '../module';
 import { BlobError, ErrorCode } from '../errors';
 
@@ -11,11 +11,30 @@ describe('wrapReader', () => {
   beforeEach(() => {
     mockStreaming = {
       readNextChunk: jest.fn(),
+      readChunks: jest.fn(),
+      readAt: jest.fn(),
       write: jest.fn(),
+      writev: jest.fn(),
+      setWriteBehind: jest.fn(),
+      setCompression: jest.fn(),
       flush: jest.fn(),
       close: jest.fn(),
+      setReadAhead: jest.fn(),
+      setDecompression: jest.fn(),
+      openMapped: jest.fn(),
+      readMapped: jest.fn(),
       startDownload: jest.fn(),
       cancelDownload: jest.fn(),
+      setDownloadPriority: jest.fn(),
+      setDownloadLimits: jest.fn(),
+      getDownloadQueueStats: jest.fn(),
+      verifyDownload: jest.fn(),
+      hashFile: jest.fn(),
+      hashFileTree: jest.fn(),
+      createHasher: jest.fn(),
+      updateHasher: jest.fn(),
+      digestHasher: jest.fn(),
+      attachHasher: jest.fn(),
       getReaderInfo: jest.fn((_handleId: number) => ({
         fileSize: 1024,
         bytesRead: 512,
@@ -23,7 +42,12 @@ describe('wrapReader', () => {
       })),
       getWriterInfo: jest.fn((_handleId: number) => ({
         bytesWritten: 256,
+        pendingBytes: 0,
       })),
+      getBufferPoolStats: jest.fn(),
+      setBufferPoolLimit: jest.fn(),
+      getStats: jest.fn(),
+      resetStats: jest.fn(),
     };
   });
 
@@ -83,6 +107,52 @@ describe('wrapReader', () => {
     );
   });
 
+  it('should delegate readChunks with unlimited maxBytes by default', async () => {
+    const chunks = [new ArrayBuffer(8), new ArrayBuffer(8)];
+    mockStreaming.readChunks.mockResolvedValue(chunks);
+
+    const reader = wrapReader(1, mockStreaming);
+    const result = await reader.readChunks(8);
+
+    expect(mockStreaming.readChunks).toHaveBeenCalledWith(1, 8, Infinity);
+    expect(result).toBe(chunks);
+  });
+
+  it('should throw INVALID_ARGUMENT for invalid readChunks limits', () => {
+    const reader = wrapReader(1, mockStreaming);
+
+    expect(() => reader.readChunks(0)).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(() => reader.readChunks(1025)).toThrow(BlobError);
+    expect(() => reader.readChunks(4, 0)).toThrow(BlobError);
+    expect(mockStreaming.readChunks).not.toHaveBeenCalled();
+  });
+
+  it('should delegate readAt to streaming proxy', async () => {
+    const mockBuffer = new ArrayBuffer(16);
+    mockStreaming.readAt.mockResolvedValue(mockBuffer);
+
+    const reader = wrapReader(1, mockStreaming);
+    const result = await reader.readAt(4096, 16);
+
+    expect(mockStreaming.readAt).toHaveBeenCalledWith(1, 4096, 16);
+    expect(result).toBe(mockBuffer);
+  });
+
+  it('should throw INVALID_ARGUMENT for invalid readAt ranges', () => {
+    const reader = wrapReader(1, mockStreaming);
+
+    expect(() => reader.readAt(-1, 16)).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(() => reader.readAt(0, 4194305)).toThrow(
+      expect.objectContaining({ code: ErrorCode.INVALID_ARGUMENT })
+    );
+    expect(() => reader.readAt(0.5, 16)).toThrow(BlobError);
+    expect(mockStreaming.readAt).not.toHaveBeenCalled();
+  });
+
   it('should support Symbol.dispose', () => {
     const reader = wrapReader(7, mockStreaming);
     reader[Symbol.dispose]();
@@ -99,17 +169,153 @@ describe('wrapReader', () => {
   });
 });
 
+describe('wrapMappedReader', () => {
+  let mockStreaming: jest.Mocked<StreamingProxy>;
+
+  beforeEach(() => {
+    mockStreaming = {
+      readNextChunk: jest.fn(),
+      readChunks: jest.fn(),
+      readAt: jest.fn(),
+      write: jest.fn(),
+      writev: jest.fn(),
+      setWriteBehind: jest.fn(),
+      setCompression: jest.fn(),
+      flush: jest.fn(),
+      close: jest.fn(),
+      setReadAhead: jest.fn(),
+      setDecompression: jest.fn(),
+      openMapped: jest.fn(),
+      readMapped: jest.fn(),
+      startDownload: jest.fn(),
+      cancelDownload: jest.fn(),
+      setDownloadPriority: jest.fn(),
+      setDownloadLimits: jest.fn(),
+      getDownloadQueueStats: jest.fn(),
+      verifyDownload: jest.fn(),
+      hashFile: jest.fn(),
+      hashFileTree: jest.fn(),
+      createHasher: jest.fn(),
+      updateHasher: jest.fn(),
+      digestHasher: jest.fn(),
+      attachHasher: jest.fn(),
+      getReaderInfo: jest.fn((_handleId: number) => ({
+        fileSize: 1024,
+        bytesRead: 512,
+        isEOF: false,
+      })),
+      getWriterInfo: jest.fn((_handleId: number) => ({
+        bytesWritten: 256,
+        pendingBytes: 0,
+      })),
+      getBufferPoolStats: jest.fn(),
+      setBufferPoolLimit: jest.fn(),
+      getStats: jest.fn(),
+      resetStats: jest.fn(),
+    };
+    mockStreaming.readMapped.mockImplementation(
+      (_handleId: number, offset: number, length: number) =>
+        new ArrayBuffer(Math.max(0, Math.min(length, 10 - offset)))
+    );
+  });
+
+  it('should read views sequentially until EOF', async () => {
+    const reader = wrapMappedReader(9, 10, 4, mockStreaming);
+
+    expect((await reader.readNextChunk())?.byteLength).toBe(4);
+    expect((await reader.readNextChunk())?.byteLength).toBe(4);
+    expect((await reader.readNextChunk())?.byteLength).toBe(2);
+    expect(reader.bytesRead).toBe(10);
+    expect(reader.isEOF).toBe(false);
+
+    expect(await reader.readNextChunk()).toBeNull();
+    expect(reader.isEOF).toBe(true);
+    expect(mockStreaming.readMapped.mock.calls).toEqual([
+      [9, 0, 4],
+      [9, 4, 4],
+      [9, 8, 4],
+    ]);
+  });
+
+  it('should expose fileSize without native calls', () => {
+    const reader = wrapMappedReader(9, 10, 4, mockStreaming);
+
+    expect(reader.fileSize).toBe(10);
+    expect(mockStreaming.getReaderInfo).not.toHaveBeenCalled();
+  });
+
+  it('should batch mapped views in readChunks', async () => {
+    const reader = wrapMappedReader(9, 10, 4, mockStreaming);
+
+    const first = await reader.readChunks(2);
+    expect(first.map((c) => c.byteLength)).toEqual([4, 4]);
+    const rest = await reader.readChunks(8, 1);
+    expect(rest.map((c) => c.byteLength)).toEqual([2]);
+    expect(reader.isEOF).toBe(false);
+
+    expect(await reader.readChunks(8)).toEqual([]);
+    expect(reader.isEOF).toBe(true);
+  });
+
+  it('should serve readAt from the mapping', async () => {
+    const reader = wrapMappedReader(9, 10, 4, mockStreaming);
+    const result = await reader.readAt(2, 3);
+
+    expect(mockStreaming.readMapped).toHaveBeenCalledWith(9, 2, 3);
+    expect(result.byteLength).toBe(3);
+    expect(reader.bytesRead).toBe(0);
+  });
+
+  it('should delegate slice to readMapped', () => {
+    const reader = wrapMappedReader(9, 10, 4, mockStreaming);
+    reader.slice(6, 3);
+
+    expect(mockStreaming.readMapped).toHaveBeenCalledWith(9, 6, 3);
+  });
+
+  it('should throw READER_CLOSED after close', () => {
+    const reader = wrapMappedReader(9, 10, 4, mockStreaming);
+    reader.close();
+    reader.close();
+
+    expect(mockStreaming.close).toHaveBeenCalledTimes(1);
+    expect(() => reader.slice(0, 1)).toThrow(
+      expect.objectContaining({ code: ErrorCode.READER_CLOSED })
+    );
+    expect(() => reader.readNextChunk()).toThrow(BlobError);
+  });
+});
+
 describe('wrapWriter', () => {
   let mockStreaming: jest.Mocked<StreamingProxy>;
 
   beforeEach(() => {
     mockStreaming = {
       readNextChunk: jest.fn(),
+      readChunks: jest.fn(),
+      readAt: jest.fn(),
       write: jest.fn(),
+      writev: jest.fn(),
+      setWriteBehind: jest.fn(),
+      setCompression: jest.fn(),
       flush: jest.fn(),
       close: jest.fn(),
+      setReadAhead: jest.fn(),
+      setDecompression: jest.fn(),
+      openMapped: jest.fn(),
+      readMapped: jest.fn(),
       startDownload: jest.fn(),
       cancelDownload: jest.fn(),
+      setDownloadPriority: jest.fn(),
+      setDownloadLimits: jest.fn(),
+      getDownloadQueueStats: jest.fn(),
+      verifyDownload: jest.fn(),
+      hashFile: jest.fn(),
+      hashFileTree: jest.fn(),
+      createHasher: jest.fn(),
+      updateHasher: jest.fn(),
+      digestHasher: jest.fn(),
+      attachHasher: jest.fn(),
       getReaderInfo: jest.fn((_handleId: number) => ({
         fileSize: 1024,
         bytesRead: 512,
@@ -117,7 +323,12 @@ describe('wrapWriter', () => {
       })),
       getWriterInfo: jest.fn((_handleId: number) => ({
         bytesWritten: 256,
+        pendingBytes: 0,
       })),
+      getBufferPoolStats: jest.fn(),
+      setBufferPoolLimit: jest.fn(),
+      getStats: jest.fn(),
+      resetStats: jest.fn(),
     };
   });
 
@@ -137,6 +348,17 @@ describe('wrapWriter', () => {
     expect(bytesWritten).toBe(128);
   });
 
+  it('should delegate writev to streaming proxy', async () => {
+    mockStreaming.writev.mockResolvedValue(96);
+
+    const writer = wrapWriter(3, mockStreaming);
+    const buffers = [new ArrayBuffer(32), new ArrayBuffer(64)];
+    const bytesWritten = await writer.writev(buffers);
+
+    expect(mockStreaming.writev).toHaveBeenCalledWith(3, buffers);
+    expect(bytesWritten).toBe(96);
+  });
+
   it('should delegate flush to streaming proxy', async () => {
     mockStreaming.flush.mockResolvedValue(undefined);
 
@@ -183,6 +405,15 @@ describe('wrapWriter', () => {
     );
   });
 
+  it('should throw BlobError(WRITER_CLOSED) after close on writev', () => {
+    const writer = wrapWriter(10, mockStreaming);
+    writer.close();
+
+    expect(() => writer.writev([new ArrayBuffer(8)])).toThrow(
+      expect.objectContaining({ code: ErrorCode.WRITER_CLOSED })
+    );
+  });
+
   it('should throw BlobError(WRITER_CLOSED) after close on flush', () => {
     const writer = wrapWriter(10, mockStreaming);
     writer.close();
@@ -5,16 +5,37 @@ import NativeModule from '../NativeBufferedBlob';
 import { createWriter } from '../api/writeFile';
 import { BlobError, ErrorCode } from '../errors';
 import type { StreamingProxy } from '../module';
+import { CompressionFormat } from '../types';
+import type { BlobHasher } from '../types';
 
 // Set up global streaming proxy
 beforeAll(() => {
   const mockStreaming: StreamingProxy = {
     readNextChunk: jest.fn(),
+    readChunks: jest.fn(),
+    readAt: jest.fn(),
     write: jest.fn(),
+    writev: jest.fn(),
+    setWriteBehind: jest.fn(),
+    setCompression: jest.fn(),
     flush: jest.fn(),
     close: jest.fn(),
+    setReadAhead: jest.fn(),
+    setDecompression: jest.fn(),
+    openMapped: jest.fn(),
+    readMapped: jest.fn(),
     startDownload: jest.fn(),
     cancelDownload: jest.fn(),
+    setDownloadPriority: jest.fn(),
+    setDownloadLimits: jest.fn(),
+    getDownloadQueueStats: jest.fn(),
+    verifyDownload: jest.fn(),
+    hashFile: jest.fn(),
+    hashFileTree: jest.fn(),
+    createHasher: jest.fn(),
+    updateHasher: jest.fn(),
+    digestHasher: jest.fn(),
+    attachHasher: jest.fn(),
     getReaderInfo: jest.fn(() => ({
       fileSize: 1024,
       bytesRead: 0,
@@ -22,7 +43,12 @@ beforeAll(() => {
     })),
     getWriterInfo: jest.fn(() => ({
       bytesWritten: 0,
+      pendingBytes: 0,
     })),
+    getBufferPoolStats: jest.fn(),
+    setBufferPoolLimit: jest.fn(),
+    getStats: jest.fn(),
+    resetStats: jest.fn(),
   };
   globalThis.__BufferedBlobStreaming = mockStreaming;
 });
@@ -87,4 +113,91 @@ describe('createWriter', () => {
       })
     );
   });
+
+  it('should not enable write-behind by default', () => {
+    createWriter('/test/file.txt');
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(streaming.setWriteBehind).not.toHaveBeenCalled();
+  });
+
+  it('should enable write-behind with default water marks', () => {
+    (NativeModule.openWrite as jest.Mock).mockReturnValue(8);
+
+    createWriter('/test/log.ndjson', true, { writeBehind: true });
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(streaming.setWriteBehind).toHaveBeenCalledWith(8, 1048576, 262144);
+  });
+
+  it('should pass custom water marks', () => {
+    createWriter('/test/log.ndjson', false, {
+      writeBehind: true,
+      highWaterMark: 65536,
+      lowWaterMark: 0,
+    });
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(streaming.setWriteBehind).toHaveBeenCalledWith(2, 65536, 0);
+  });
+
+  it('should throw INVALID_ARGUMENT when lowWaterMark exceeds highWaterMark', () => {
+    expect(() =>
+      createWriter('/test/log.ndjson', false, {
+        writeBehind: true,
+        highWaterMark: 1024,
+        lowWaterMark: 2048,
+      })
+    ).toThrow(
+      expect.objectContaining({
+        code: ErrorCode.INVALID_ARGUMENT,
+        path: '/test/log.ndjson',
+      })
+    );
+    expect(NativeModule.openWrite).not.toHaveBeenCalled();
+  });
+
+  it('should attach a hasher to the new handle', () => {
+    (NativeModule.openWrite as jest.Mock).mockReturnValue(8);
+    const hasher = { handleId: 42 } as BlobHasher;
+
+    createWriter('/test/file.txt', false, { hasher });
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(streaming.attachHasher).toHaveBeenCalledWith(8, 42);
+  });
+
+  it('should enable compression with level and window', () => {
+    (NativeModule.openWrite as jest.Mock).mockReturnValue(8);
+
+    createWriter('/test/log.ndjson.gz', false, {
+      compress: CompressionFormat.GZIP,
+      compressionLevel: 9,
+      windowBits: 12,
+    });
+
+    const streaming = globalThis.__BufferedBlobStreaming as StreamingProxy;
+    expect(streaming.setCompression).toHaveBeenCalledWith(8, 'gzip', 9, 12);
+  });
+
+  it('should close the writer when compression cannot be enabled', () => {
+    (NativeModule.openWrite as jest.Mock).mockReturnValue(8);
+    const streaming = globalThis.__BufferedBlobStreaming as jest.Mocked<StreamingProxy>;
+    streaming.setCompression.mockImplementationOnce(() => {
+      throw new Error('[INVALID_ARGUMENT] level must be between 0 and 9, got 12');
+    });
+
+    expect(() =>
+      createWriter('/test/out.gz', false, {
+        compress: CompressionFormat.GZIP,
+        compressionLevel: 12,
+      })
+    ).toThrow(
+      expect.objectContaining({
+        code: ErrorCode.INVALID_ARGUMENT,
+        path: '/test/out.gz',
+      })
+    );
+    expect(streaming.close).toHaveBeenCalledWith(8);
+  });
 });
@@ -0,0 +1,33 @@
+import { getStreamingProxy } from '../module';
+import { wrapError, BlobError, ErrorCode } from '../errors';
+import type { BufferPoolStats } from '../types';
+
+/**
+ * Counters for the native pool that recycles read chunk storage.
+ * Counters are cumulative for the lifetime of the process.
+ */
+export function getBufferPoolStats(): BufferPoolStats {
+  try {
+    return getStreamingProxy().getBufferPoolStats();
+  } catch (e) {
+    throw wrapError(e);
+  }
+}
+
+/**
+ * Cap the memory the pool keeps cached for reuse (default 16MB).
+ * Lowering the limit frees cached chunks immediately; 0 disables pooling.
+ */
+export function setBufferPoolLimit(maxRetainedBytes: number): void {
+  try {
+    if (Number.isNaN(maxRetainedBytes) || maxRetainedBytes < 0) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        `maxRetainedBytes must be >= 0, got ${maxRetainedBytes}`
+      );
+    }
+    getStreamingProxy().setBufferPoolLimit(maxRetainedBytes);
+  } catch (e) {
+    throw wrapError(e);
+  }
+}
@@ -1,25 +1,142 @@
 import { NativeModule, getStreamingProxy } from '../module';
-import { wrapError } from '../errors';
-import type { DownloadProgress } from '../types';
+import { wrapError, BlobError, ErrorCode } from '../errors';
+import { DownloadPriority } from '../types';
+import type {
+  BlobHasher,
+  DownloadProgress,
+  DownloadStreamReader,
+  HashAlgorithm,
+} from '../types';
+import { wrapDownloadStream } from '../wrappers';
 
 export interface DownloadOptions {
   url: string;
-  destPath: string;
+  /** Where to save the body. Optional only with `stream: true`. */
+  destPath?: string;
   headers?: Record<string, string>;
   onProgress?: (progress: DownloadProgress) => void;
+  /** Minimum milliseconds between progress reports (default: 100). */
+  progressInterval?: number;
+  /** Minimum new bytes between progress reports (default: 0). */
+  progressBytes?: number;
+  /**
+   * Continue a download that an earlier attempt left incomplete, using the
+   * checkpoint kept next to destPath, and leave one behind if this attempt
+   * fails or is cancelled (default: false).
+   */
+  resume?: boolean;
+  /**
+   * Fetch the body as up to this many concurrent byte ranges written into
+   * a preallocated destPath, when the server supports ranges (default: 1,
+   * max 16). Ignored when resuming.
+   */
+  segments?: number;
+  /** Smallest range worth its own request, in bytes (default: 1048576). */
+  minSegmentSize?: number;
+  /**
+   * Queue position relative to other downloads waiting for a slot
+   * (default: NORMAL). See setDownloadLimits.
+   */
+  priority?: DownloadPriority;
+  /**
+   * Also hand the body to JS as it arrives, through the handle's `stream`.
+   * Without destPath nothing is written to disk. Ignores resume and
+   * segments (default: false).
+   */
+  stream?: boolean;
+  /**
+   * Bytes the stream holds before the download waits for reads
+   * (default: 1048576).
+   */
+  streamBufferSize?: number;
+  /** Hash the response body natively as it is written to destPath. */
+  hasher?: BlobHasher;
+  /**
+   * Digest (hex) the body must hash to. Checked natively while the body is
+   * written; on a mismatch destPath is removed and the promise rejects
+   * with INTEGRITY_MISMATCH.
+   */
+  expectedHash?: { algorithm: HashAlgorithm; digest: string };
+  /** Exact body length in bytes, checked the same way as expectedHash. */
+  expectedSize?: number;
 }
 
 export interface DownloadHandle {
   promise: Promise<void>;
+  /** Abort the download; one that has not started yet never connects. */
   cancel: () => void;
+  /**
+   * Move the download to another priority class while it is queued.
+   * Returns false once it has started.
+   */
+  setPriority: (priority: DownloadPriority) => boolean;
+  /** Present with `stream: true`. */
+  stream?: DownloadStreamReader;
 }
 
 export function download(options: DownloadOptions): DownloadHandle {
-  const { url, destPath, headers = {}, onProgress } = options;
+  const {
+    url,
+    destPath = '',
+    headers = {},
+    onProgress,
+    progressInterval = 100,
+    progressBytes = 0,
+    resume = false,
+    segments = 1,
+    minSegmentSize = 1024 * 1024,
+    priority = DownloadPriority.NORMAL,
+    stream = false,
+    streamBufferSize = 1024 * 1024,
+    hasher,
+    expectedHash,
+    expectedSize,
+  } = options;
 
   try {
+    if (!destPath && !stream) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        'destPath is required unless stream is set'
+      );
+    }
+    if (
+      stream &&
+      (!Number.isInteger(streamBufferSize) || streamBufferSize < 1)
+    ) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        `streamBufferSize must be an integer >= 1, got ${streamBufferSize}`
+      );
+    }
+    if (
+      expectedSize !== undefined &&
+      (!Number.isInteger(expectedSize) || expectedSize < 0)
+    ) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        `expectedSize must be a non-negative integer, got ${expectedSize}`
+      );
+    }
     const handleId = NativeModule.createDownload(url, destPath, headers);
     const streaming = getStreamingProxy();
+    try {
+      if (hasher) {
+        streaming.attachHasher(handleId, hasher.handleId);
+      }
+      if (expectedHash || expectedSize !== undefined) {
+        streaming.verifyDownload(
+          handleId,
+          destPath,
+          expectedHash?.algorithm ?? '',
+          expectedHash?.digest ?? '',
+          expectedSize ?? -1
+        );
+      }
+    } catch (e) {
+      NativeModule.closeHandle(handleId);
+      throw e;
+    }
 
     const progressCallback = onProgress
       ? (bytesDownloaded: number, totalBytes: number, progress: number) => {
@@ -27,11 +144,31 @@ export function download(options: DownloadOptions): DownloadHandle {
         }
       : (_b: number, _t: number, _p: number) => {};
 
+    // A streaming download's handle also serves its reads, so it is released
+    // only once both the transfer and the stream are done with it.
+    let users = stream ? 2 : 1;
+    const release = () => {
+      users -= 1;
+      if (users === 0) NativeModule.closeHandle(handleId);
+    };
+
     const promise = (async () => {
       try {
-        await streaming.startDownload(handleId, progressCallback);
+        await streaming.startDownload(
+          handleId,
+          progressCallback,
+          progressInterval,
+          progressBytes,
+          resume,
+          segments,
+          minSegmentSize,
+          priority,
+          stream,
+          destPath !== '',
+          streamBufferSize
+        );
       } finally {
-        NativeModule.closeHandle(handleId);
+        release();
       }
     })();
 
@@ -39,7 +176,23 @@ export function download(options: DownloadOptions): DownloadHandle {
       streaming.cancelDownload(handleId);
     };
 
-    return { promise, cancel };
+    const setPriority = (newPriority: DownloadPriority) => {
+      try {
+        return streaming.setDownloadPriority(handleId, newPriority);
+      } catch (e) {
+        throw wrapError(e);
+      }
+    };
+
+    if (stream) {
+      return {
+        promise,
+        cancel,
+        setPriority,
+        stream: wrapDownloadStream(handleId, streaming, release),
+      };
+    }
+    return { promise, cancel, setPriority };
   } catch (e) {
     throw wrapError(e, destPath);
   }
@@ -0,0 +1,44 @@
+import { getStreamingProxy } from '../module';
+import { wrapError, BlobError, ErrorCode } from '../errors';
+import type { DownloadQueueStats } from '../types';
+
+/**
+ * Current state and cumulative wait-time counters of the native download
+ * queue. Counters are cumulative for the lifetime of the process.
+ */
+export function getDownloadQueueStats(): DownloadQueueStats {
+  try {
+    return getStreamingProxy().getDownloadQueueStats();
+  } catch (e) {
+    throw wrapError(e);
+  }
+}
+
+/**
+ * Cap how many downloads transfer at once, in total (default 6) and
+ * against any one host (default 4). Further downloads wait in the queue;
+ * raising a limit starts waiting downloads immediately.
+ */
+export function setDownloadLimits(limits: {
+  maxConcurrent: number;
+  maxPerHost: number;
+}): void {
+  try {
+    const { maxConcurrent, maxPerHost } = limits;
+    if (!Number.isInteger(maxConcurrent) || maxConcurrent < 1) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        `maxConcurrent must be an integer >= 1, got ${maxConcurrent}`
+      );
+    }
+    if (!Number.isInteger(maxPerHost) || maxPerHost < 1) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        `maxPerHost must be an integer >= 1, got ${maxPerHost}`
+      );
+    }
+    getStreamingProxy().setDownloadLimits(maxConcurrent, maxPerHost);
+  } catch (e) {
+    throw wrapError(e);
+  }
+}
@@ -1,14 +1,64 @@
-import { NativeModule } from '../module';
+import { getStreamingProxy } from '../module';
 import { wrapError } from '../errors';
+import { wrapHasher } from '../wrappers';
 import { HashAlgorithm } from '../types';
+import type { BlobHasher, TreeHashOptions, TreeHashResult } from '../types';
 
+/**
+ * Hash a file natively. Runs in the shared C++ engine on a worker thread
+ * (hardware SHA-256/CRC32C where the CPU supports it) and resolves
+ * through JSI with the lowercase hex digest.
+ */
 export async function hashFile(
   path: string,
   algorithm: HashAlgorithm = HashAlgorithm.SHA256
 ): Promise<string> {
   try {
-    return await NativeModule.hashFile(path, algorithm);
+    return await getStreamingProxy().hashFile(path, algorithm);
   } catch (e) {
     throw wrapError(e, path);
   }
 }
+
+/**
+ * Hash a large file in parallel. The file is split into fixed-size chunks
+ * that are read with pread and hashed across the native worker pool, then
+ * combined as a tree, so throughput scales with cores instead of being
+ * bound to one thread.
+ */
+export async function hashFileTree(
+  path: string,
+  options: TreeHashOptions = {}
+): Promise<TreeHashResult> {
+  const {
+    algorithm = HashAlgorithm.BLAKE3,
+    chunkSize = 1024 * 1024,
+    includeChunkDigests = false,
+  } = options;
+  try {
+    return await getStreamingProxy().hashFileTree(
+      path,
+      algorithm,
+      chunkSize,
+      includeChunkDigests
+    );
+  } catch (e) {
+    throw wrapError(e, path);
+  }
+}
+
+/**
+ * Create an incremental native hasher. Close it when done; attaching it
+ * to a reader, writer or download keeps it fed until that handle closes.
+ */
+export function createHasher(
+  algorithm: HashAlgorithm = HashAlgorithm.SHA256
+): BlobHasher {
+  try {
+    const streaming = getStreamingProxy();
+    const handleId = streaming.createHasher(algorithm);
+    return wrapHasher(handleId, algorithm, streaming);
+  } catch (e) {
+    throw wrapError(e);
+  }
+}
@@ -1,14 +1,17 @@
 import { NativeModule, getStreamingProxy } from '../module';
 import { wrapError, BlobError, ErrorCode } from '../errors';
-import { wrapReader } from '../wrappers';
-import type { BlobReader } from '../types';
+import { wrapReader, wrapMappedReader } from '../wrappers';
+import type { BlobReader, MappedBlobReader, ReaderOptions } from '../types';
 
 const DEFAULT_BUFFER_SIZE = 65536; // 64KB
+const MAX_READ_AHEAD = 16;
 
 export function createReader(
   path: string,
-  bufferSize: number = DEFAULT_BUFFER_SIZE
+  bufferSize: number = DEFAULT_BUFFER_SIZE,
+  options: ReaderOptions = {}
 ): BlobReader {
+  const { readAhead = 0, hasher, decompress, windowBits } = options;
   try {
     if (
       !Number.isFinite(bufferSize) ||
@@ -21,6 +24,17 @@ export function createReader(
         path
       );
     }
+    if (
+      !Number.isInteger(readAhead) ||
+      readAhead < 0 ||
+      readAhead > MAX_READ_AHEAD
+    ) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        `readAhead must be an integer between 0 and ${MAX_READ_AHEAD}, got ${readAhead}`,
+        path
+      );
+    }
     const handleId = NativeModule.openRead(path, bufferSize);
     if (handleId < 0) {
       throw new BlobError(
@@ -30,8 +44,48 @@ export function createReader(
       );
     }
     const streaming = getStreamingProxy();
+    try {
+      // Before read-ahead, which may start reading straight away.
+      if (decompress) {
+        streaming.setDecompression(handleId, decompress, windowBits);
+      }
+      if (hasher) {
+        streaming.attachHasher(handleId, hasher.handleId);
+      }
+    } catch (e) {
+      streaming.close(handleId);
+      throw e;
+    }
+    if (readAhead > 0) {
+      streaming.setReadAhead(handleId, readAhead);
+    }
     return wrapReader(handleId, streaming);
   } catch (e) {
     throw wrapError(e, path);
   }
 }
+
+/**
+ * Map a file into memory for zero-copy reads. Best suited to large,
+ * read-mostly files that are not truncated while mapped.
+ * `chunkSize` only sets the size of readNextChunk() views.
+ */
+export function createMappedReader(
+  path: string,
+  chunkSize: number = DEFAULT_BUFFER_SIZE
+): MappedBlobReader {
+  try {
+    if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        `chunkSize must be a positive integer, got ${chunkSize}`,
+        path
+      );
+    }
+    const streaming = getStreamingProxy();
+    const { handleId, fileSize } = streaming.openMapped(path);
+    return wrapMappedReader(handleId, fileSize, chunkSize, streaming);
+  } catch (e) {
+    throw wrapError(e, path);
+  }
+}
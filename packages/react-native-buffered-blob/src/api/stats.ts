@@ -0,0 +1,25 @@
+import { getStreamingProxy } from '../module';
+import { wrapError } from '../errors';
+import type { StreamingStats } from '../types';
+
+/**
+ * Per-operation counters and latency histograms for the streaming calls
+ * (reads, writes, flush, hashing), split by phase. Collection is always
+ * on; numbers cover the window since the last resetStats().
+ */
+export function getStats(): StreamingStats {
+  try {
+    return getStreamingProxy().getStats();
+  } catch (e) {
+    throw wrapError(e);
+  }
+}
+
+/** Clear all counters and histograms and start a new window. */
+export function resetStats(): void {
+  try {
+    getStreamingProxy().resetStats();
+  } catch (e) {
+    throw wrapError(e);
+  }
+}
@@ -1,13 +1,45 @@
 import { NativeModule, getStreamingProxy } from '../module';
 import { wrapError, BlobError, ErrorCode } from '../errors';
 import { wrapWriter } from '../wrappers';
-import type { BlobWriter } from '../types';
+import type { BlobWriter, WriterOptions } from '../types';
+
+const DEFAULT_HIGH_WATER_MARK = 1048576; // 1MB
 
 export function createWriter(
   path: string,
-  append: boolean = false
+  append: boolean = false,
+  options: WriterOptions = {}
 ): BlobWriter {
+  const {
+    writeBehind = false,
+    highWaterMark = DEFAULT_HIGH_WATER_MARK,
+    lowWaterMark = Math.floor(highWaterMark / 4),
+    hasher,
+    compress,
+    compressionLevel,
+    windowBits,
+  } = options;
   try {
+    if (writeBehind) {
+      if (!Number.isInteger(highWaterMark) || highWaterMark < 1) {
+        throw new BlobError(
+          ErrorCode.INVALID_ARGUMENT,
+          `highWaterMark must be a positive integer, got ${highWaterMark}`,
+          path
+        );
+      }
+      if (
+        !Number.isInteger(lowWaterMark) ||
+        lowWaterMark < 0 ||
+        lowWaterMark > highWaterMark
+      ) {
+        throw new BlobError(
+          ErrorCode.INVALID_ARGUMENT,
+          `lowWaterMark must be between 0 and highWaterMark, got ${lowWaterMark}`,
+          path
+        );
+      }
+    }
     const handleId = NativeModule.openWrite(path, append);
     if (handleId < 0) {
       throw new BlobError(
@@ -17,6 +49,25 @@ export function createWriter(
       );
     }
     const streaming = getStreamingProxy();
+    try {
+      if (compress) {
+        streaming.setCompression(
+          handleId,
+          compress,
+          compressionLevel,
+          windowBits
+        );
+      }
+      if (hasher) {
+        streaming.attachHasher(handleId, hasher.handleId);
+      }
+    } catch (e) {
+      streaming.close(handleId);
+      throw e;
+    }
+    if (writeBehind) {
+      streaming.setWriteBehind(handleId, highWaterMark, lowWaterMark);
+    }
     return wrapWriter(handleId, streaming);
   } catch (e) {
     throw wrapError(e, path);
@@ -9,6 +9,7 @@ export enum ErrorCode {
   INVALID_ARGUMENT = 'INVALID_ARGUMENT',
   DOWNLOAD_FAILED = 'DOWNLOAD_FAILED',
   DOWNLOAD_CANCELLED = 'DOWNLOAD_CANCELLED',
+  INTEGRITY_MISMATCH = 'INTEGRITY_MISMATCH',
   READER_CLOSED = 'READER_CLOSED',
   WRITER_CLOSED = 'WRITER_CLOSED',
   UNKNOWN = 'UNKNOWN',
@@ -9,20 +9,48 @@ export type {
   FileInfo,
   DownloadProgress,
   BlobReader,
+  MappedBlobReader,
   BlobWriter,
+  ReaderOptions,
+  WriterOptions,
+  BufferPoolStats,
+  StreamingStats,
+  StatsOperationName,
+  OperationStats,
+  LatencySummary,
+  DownloadQueueStats,
+  DownloadStreamReader,
+  BlobHasher,
+  TreeHashOptions,
+  TreeHashResult,
+} from './types';
+export {
+  HashAlgorithm,
+  CompressionFormat,
+  FileType,
+  DownloadPriority,
 } from './types';
-export { HashAlgorithm, FileType } from './types';
 
 // API - Streaming
-export { createReader } from './api/readFile';
+export { createReader, createMappedReader } from './api/readFile';
 export { createWriter } from './api/writeFile';
 
+// API - Buffer Pool
+export { getBufferPoolStats, setBufferPoolLimit } from './api/bufferPool';
+
+// API - Statistics
+export { getStats, resetStats } from './api/stats';
+
 // API - File Operations
 export { exists, stat, unlink, mkdir, ls, cp, mv } from './api/fileOps';
 
 // API - Hashing
-export { hashFile } from './api/hash';
+export { hashFile, hashFileTree, createHasher } from './api/hash';
 
 // API - Download
 export { download } from './api/download';
+export {
+  getDownloadQueueStats,
+  setDownloadLimits,
+} from './api/downloadQueue';
 export type { DownloadOptions, DownloadHandle } from './api/download';
@@ -1,4 +1,5 @@
 import NativeModule from './NativeBufferedBlob';
+import type { StreamingStats } from './types';
 
 // Install JSI HostObject on first import
 const installed = NativeModule.install();
@@ -10,24 +11,99 @@ if (!installed) {
 
 export interface StreamingProxy {
   readNextChunk(handleId: number): Promise<ArrayBuffer | null>;
+  readChunks(
+    handleId: number,
+    maxChunks: number,
+    maxBytes: number
+  ): Promise<ArrayBuffer[]>;
+  readAt(handleId: number, offset: number, length: number): Promise<ArrayBuffer>;
   write(handleId: number, data: ArrayBuffer): Promise<number>;
+  writev(handleId: number, buffers: ArrayBuffer[]): Promise<number>;
+  setWriteBehind(
+    handleId: number,
+    highWaterMark: number,
+    lowWaterMark: number
+  ): void;
+  setCompression(
+    handleId: number,
+    format: string,
+    level?: number,
+    windowBits?: number
+  ): void;
   flush(handleId: number): Promise<void>;
   close(handleId: number): void;
+  setReadAhead(handleId: number, depth: number): void;
+  setDecompression(handleId: number, format: string, windowBits?: number): void;
+  openMapped(path: string): { handleId: number; fileSize: number };
+  readMapped(handleId: number, offset: number, length: number): ArrayBuffer;
   startDownload(
     handleId: number,
     onProgress: (
       bytesDownloaded: number,
       totalBytes: number,
       progress: number
-    ) => void
+    ) => void,
+    progressInterval?: number,
+    progressBytes?: number,
+    resume?: boolean,
+    segments?: number,
+    minSegmentSize?: number,
+    priority?: number,
+    stream?: boolean,
+    writeFile?: boolean,
+    streamBufferSize?: number
   ): Promise<void>;
   cancelDownload(handleId: number): void;
+  setDownloadPriority(handleId: number, priority: number): boolean;
+  setDownloadLimits(maxConcurrent: number, maxPerHost: number): void;
+  getDownloadQueueStats(): {
+    running: number;
+    queued: number;
+    started: number;
+    cancelledWhileQueued: number;
+    totalWaitMs: number;
+    maxWaitMs: number;
+    maxConcurrent: number;
+    maxPerHost: number;
+  };
+  verifyDownload(
+    handleId: number,
+    destPath: string,
+    algorithm: string,
+    digest: string,
+    expectedSize: number
+  ): void;
+  hashFile(path: string, algorithm: string): Promise<string>;
+  hashFileTree(
+    path: string,
+    algorithm: string,
+    chunkSize: number,
+    includeChunkDigests: boolean
+  ): Promise<{ digest: string; chunkSize: number; chunkDigests?: string[] }>;
+  createHasher(algorithm: string): number;
+  updateHasher(hasherId: number, data: ArrayBuffer): void;
+  digestHasher(hasherId: number): string;
+  attachHasher(handleId: number, hasherId: number): void;
   getReaderInfo(handleId: number): {
     fileSize: number;
     bytesRead: number;
     isEOF: boolean;
   };
-  getWriterInfo(handleId: number): { bytesWritten: number };
+  getWriterInfo(handleId: number): {
+    bytesWritten: number;
+    pendingBytes: number;
+  };
+  getBufferPoolStats(): {
+    hits: number;
+    misses: number;
+    releases: number;
+    discards: number;
+    retainedBytes: number;
+    maxRetainedBytes: number;
+  };
+  setBufferPoolLimit(maxRetainedBytes: number): void;
+  getStats(): StreamingStats;
+  resetStats(): void;
 }
 
 declare global {
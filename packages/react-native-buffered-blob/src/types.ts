@@ -2,6 +2,26 @@
 export enum HashAlgorithm {
   SHA256 = 'sha256',
   MD5 = 'md5',
+  /** BLAKE3, 256-bit. Cryptographic and faster than SHA-256 in software. */
+  BLAKE3 = 'blake3',
+  /** XXH3 64-bit. Non-cryptographic; for integrity checks and dedup only. */
+  XXH3 = 'xxh3',
+  /** CRC32C (Castagnoli). Non-cryptographic; hardware-accelerated. */
+  CRC32C = 'crc32c',
+}
+
+/**
+ * Streaming compression formats for readers and writers. ZSTD is only
+ * available in builds linked against libzstd; elsewhere it throws
+ * INVALID_ARGUMENT.
+ */
+export enum CompressionFormat {
+  GZIP = 'gzip',
+  /** zlib-wrapped deflate (RFC 1950). */
+  DEFLATE = 'deflate',
+  /** Raw deflate without a header or checksum (RFC 1951). */
+  DEFLATE_RAW = 'deflate-raw',
+  ZSTD = 'zstd',
 }
 
 export enum FileType {
@@ -24,19 +44,249 @@ export interface DownloadProgress {
   progress: number;
 }
 
+/**
+ * Network chunks of a `download({ stream: true })` in arrival order. The
+ * download holds back once `streamBufferSize` bytes are waiting here, so
+ * read steadily or close() the stream; the download's handle is released
+ * when the stream has ended (EOF, error or close) and the download's
+ * promise has settled.
+ */
+export interface DownloadStreamReader extends Disposable {
+  readonly bytesRead: number;
+  readonly isEOF: boolean;
+  /**
+   * Next chunk, or null once the whole body has been read. Rejects with
+   * the download's error if it fails. One read at a time.
+   */
+  readNextChunk(): Promise<ArrayBuffer | null>;
+  /** Stop reading; cancels the download if it is still running. */
+  close(): void;
+}
+
+/** Scheduling class of a download; higher classes leave the queue first. */
+export enum DownloadPriority {
+  LOW = 0,
+  NORMAL = 1,
+  HIGH = 2,
+}
+
+export interface DownloadQueueStats {
+  /** Downloads holding a slot. */
+  running: number;
+  /** Downloads waiting for a slot. */
+  queued: number;
+  /** Downloads that have left the queue since launch. */
+  started: number;
+  /** Downloads cancelled before they started. */
+  cancelledWhileQueued: number;
+  /** Time started downloads spent queued, summed. */
+  totalWaitMs: number;
+  /** Longest time a started download spent queued. */
+  maxWaitMs: number;
+  maxConcurrent: number;
+  maxPerHost: number;
+}
+
+export interface BufferPoolStats {
+  /** Chunk allocations served from the pool. */
+  hits: number;
+  /** Chunk allocations that fell through to the system allocator. */
+  misses: number;
+  /** Chunks returned after their ArrayBuffer was garbage collected. */
+  releases: number;
+  /** Returned chunks freed because the pool was at its limit. */
+  discards: number;
+  retainedBytes: number;
+  maxRetainedBytes: number;
+}
+
+/**
+ * Latency distribution of one phase, in microseconds. Percentiles come
+ * from a log-linear histogram and are accurate to about 12%.
+ */
+export interface LatencySummary {
+  count: number;
+  minUs: number;
+  meanUs: number;
+  p50Us: number;
+  p90Us: number;
+  p99Us: number;
+  p999Us: number;
+  maxUs: number;
+}
+
+export interface OperationStats {
+  /** Promises resolved. */
+  completed: number;
+  /** Promises rejected. */
+  failed: number;
+  /** Bytes read or written by completed calls. */
+  bytes: number;
+  latency: {
+    /** Call until the work was queued natively. */
+    bridge: LatencySummary;
+    /** Waiting for a native worker, behind earlier calls on the handle. */
+    queue: LatencySummary;
+    /** Syscalls and hashing on the worker. */
+    io: LatencySummary;
+    /** Result handed to the JS thread until the promise settled. */
+    delivery: LatencySummary;
+    /** Call until the promise settled. */
+    total: LatencySummary;
+  };
+}
+
+export type StatsOperationName =
+  | 'readNextChunk'
+  | 'readChunks'
+  | 'readAt'
+  | 'write'
+  | 'writev'
+  | 'flush'
+  | 'hashFile'
+  | 'hashFileTree';
+
+export interface StreamingStats {
+  /** Milliseconds since the last resetStats() (or process start). */
+  windowMs: number;
+  operations: Record<StatsOperationName, OperationStats>;
+}
+
+/**
+ * Incremental hasher running natively. Feed it from JS with update(), or
+ * pass it as the `hasher` option of createReader/createWriter/download to
+ * hash the data natively as it streams through, without a second pass.
+ */
+export interface BlobHasher extends Disposable {
+  readonly handleId: number;
+  readonly algorithm: HashAlgorithm;
+  /** Hash the buffer's bytes in place (synchronous, no copy). */
+  update(data: ArrayBuffer): void;
+  /**
+   * Lowercase hex digest of everything hashed so far. Finalizes the
+   * hasher: later update() calls throw and attached streams stop feeding
+   * it. Calling digest() again returns the same value.
+   */
+  digest(): string;
+  close(): void;
+}
+
+export interface TreeHashOptions {
+  /** BLAKE3 (default) or SHA256; other algorithms cannot be split. */
+  algorithm?: HashAlgorithm;
+  /** Bytes per chunk: a power of two from 16KB to 64MB. Default 1MB. */
+  chunkSize?: number;
+  /** Also return one digest per chunk, in file order. Default false. */
+  includeChunkDigests?: boolean;
+}
+
+export interface TreeHashResult {
+  /**
+   * Root digest. For BLAKE3 this is the standard BLAKE3 hash of the file;
+   * for SHA256 it is a Merkle root over per-chunk SHA-256 digests and
+   * only equals hashFile() when the file fits in one chunk.
+   */
+  digest: string;
+  chunkSize: number;
+  /**
+   * Per-chunk digests (BLAKE3 chunk chaining values or SHA-256 leaves).
+   * Compare against a previous run with the same chunkSize to find the
+   * ranges that changed.
+   */
+  chunkDigests?: string[];
+}
+
+export interface ReaderOptions {
+  /**
+   * Number of chunks to read ahead in the background (0-16, default 0).
+   * readNextChunk() then resolves from memory while the next chunks load.
+   * Buffered memory is bounded by readAhead * bufferSize.
+   */
+  readAhead?: number;
+  /** Hash every chunk read sequentially (readAt() is not included). */
+  hasher?: BlobHasher;
+  /**
+   * Decompress the file natively; chunks and bytesRead are then
+   * decompressed data, while fileSize stays the size on disk. readAt()
+   * is not available on decompressing readers.
+   */
+  decompress?: CompressionFormat;
+  /**
+   * Largest window (log2) to accept when decompressing: 9-15 for the
+   * deflate formats (default 15), 10-31 for zstd (default 27).
+   */
+  windowBits?: number;
+}
+
 export interface BlobReader extends Disposable {
   readonly handleId: number;
   readonly fileSize: number;
   readonly bytesRead: number;
   readonly isEOF: boolean;
   readNextChunk(): Promise<ArrayBuffer | null>;
+  /**
+   * Read up to `maxChunks` chunks (1-1024) in a single native call,
+   * stopping after the chunk that reaches `maxBytes`. Resolves with an
+   * empty array at EOF. Fewer round trips than calling readNextChunk()
+   * in a loop when chunks are small.
+   */
+  readChunks(maxChunks: number, maxBytes?: number): Promise<ArrayBuffer[]>;
+  /**
+   * Read up to `length` bytes (max 4MB) at `offset` without moving the
+   * sequential position. Calls may overlap; the result is shorter than
+   * `length` when the range runs past the end of the file.
+   */
+  readAt(offset: number, length: number): Promise<ArrayBuffer>;
   close(): void;
 }
 
+/**
+ * Reader over a memory-mapped file. Chunks and slices are views into the
+ * mapping rather than copies; the file stays mapped until the reader is
+ * closed and every returned ArrayBuffer has been garbage collected.
+ * Writes to a returned ArrayBuffer are private to this process and are
+ * visible through other views of the same range.
+ */
+export interface MappedBlobReader extends BlobReader {
+  /** Synchronous view of `length` bytes at `offset`, clamped to the file. */
+  slice(offset: number, length: number): ArrayBuffer;
+}
+
+export interface WriterOptions {
+  /**
+   * Buffer writes natively and write them out in large batches in the
+   * background. Suited to many small writes (log lines, NDJSON).
+   */
+  writeBehind?: boolean;
+  /** Pending bytes above which write() waits for a drain (default 1MB). */
+  highWaterMark?: number;
+  /** Pending bytes at which waiting writes resume (default highWaterMark / 4). */
+  lowWaterMark?: number;
+  /** Hash every byte as it is written to the file. */
+  hasher?: BlobHasher;
+  /**
+   * Compress natively before writing. write() results, bytesWritten and
+   * an attached hasher all see the uncompressed data. flush() makes the
+   * file decodable up to that point; the stream is ended on close().
+   * Appending only makes sense for GZIP and ZSTD, whose concatenated
+   * streams decode as one.
+   */
+  compress?: CompressionFormat;
+  /** 0-9 for the deflate formats (default 6); zstd levels (default 3). */
+  compressionLevel?: number;
+  /** Window size (log2): 9-15 for deflate formats, 10-31 for zstd. */
+  windowBits?: number;
+}
+
 export interface BlobWriter extends Disposable {
   readonly handleId: number;
+  /** Bytes written to the file. */
   readonly bytesWritten: number;
+  /** Bytes accepted by write() but not yet written (write-behind only). */
+  readonly pendingBytes: number;
   write(data: ArrayBuffer): Promise<number>;
+  /** Write several buffers in order as one native call; resolves to the total. */
+  writev(buffers: ArrayBuffer[]): Promise<number>;
   flush(): Promise<void>;
   close(): void;
 }
@@ -1,7 +1,55 @@
 import type { StreamingProxy } from './module';
-import type { BlobReader, BlobWriter } from './types';
+import type {
+  BlobHasher,
+  BlobReader,
+  BlobWriter,
+  DownloadStreamReader,
+  HashAlgorithm,
+  MappedBlobReader,
+} from './types';
 import { BlobError, ErrorCode } from './errors';
 
+const MAX_READ_AT_LENGTH = 4194304; // 4MB
+const MAX_BATCH_CHUNKS = 1024;
+
+function validateBatch(maxChunks: number, maxBytes: number): void {
+  if (
+    !Number.isInteger(maxChunks) ||
+    maxChunks < 1 ||
+    maxChunks > MAX_BATCH_CHUNKS
+  ) {
+    throw new BlobError(
+      ErrorCode.INVALID_ARGUMENT,
+      `maxChunks must be between 1 and ${MAX_BATCH_CHUNKS}, got ${maxChunks}`
+    );
+  }
+  if (Number.isNaN(maxBytes) || maxBytes < 1) {
+    throw new BlobError(
+      ErrorCode.INVALID_ARGUMENT,
+      `maxBytes must be >= 1, got ${maxBytes}`
+    );
+  }
+}
+
+function validateRange(offset: number, length: number): void {
+  if (!Number.isSafeInteger(offset) || offset < 0) {
+    throw new BlobError(
+      ErrorCode.INVALID_ARGUMENT,
+      `offset must be a non-negative integer, got ${offset}`
+    );
+  }
+  if (
+    !Number.isInteger(length) ||
+    length < 0 ||
+    length > MAX_READ_AT_LENGTH
+  ) {
+    throw new BlobError(
+      ErrorCode.INVALID_ARGUMENT,
+      `length must be between 0 and ${MAX_READ_AT_LENGTH}, got ${length}`
+    );
+  }
+}
+
 /**
  * Wraps a native reader handle with explicit getter delegation.
  * IMPORTANT: Does NOT use spread operator on HostObject (getters would be lost).
@@ -35,6 +83,26 @@ export function wrapReader(
       }
       return streaming.readNextChunk(handleId);
     },
+    readChunks(maxChunks: number, maxBytes: number = Infinity) {
+      if (closed) {
+        throw new BlobError(
+          ErrorCode.READER_CLOSED,
+          'Reader is already closed'
+        );
+      }
+      validateBatch(maxChunks, maxBytes);
+      return streaming.readChunks(handleId, maxChunks, maxBytes);
+    },
+    readAt(offset: number, length: number) {
+      if (closed) {
+        throw new BlobError(
+          ErrorCode.READER_CLOSED,
+          'Reader is already closed'
+        );
+      }
+      validateRange(offset, length);
+      return streaming.readAt(handleId, offset, length);
+    },
     close() {
       if (!closed) {
         closed = true;
@@ -50,6 +118,152 @@ export function wrapReader(
   };
 }
 
+/**
+ * Wraps the stream of a `download({ stream: true })`. Counters are kept
+ * here because the download handle may already be released natively once
+ * the stream ends. `onEnd` runs once, when the stream ends for any reason.
+ */
+export function wrapDownloadStream(
+  handleId: number,
+  streaming: StreamingProxy,
+  onEnd: () => void
+): DownloadStreamReader {
+  let closed = false;
+  let ended = false;
+  let bytesRead = 0;
+  let eof = false;
+
+  const end = () => {
+    if (!ended) {
+      ended = true;
+      onEnd();
+    }
+  };
+  const close = () => {
+    if (closed) return;
+    closed = true;
+    if (!ended) streaming.cancelDownload(handleId);
+    end();
+  };
+
+  return {
+    get bytesRead() {
+      return bytesRead;
+    },
+    get isEOF() {
+      return eof;
+    },
+    async readNextChunk() {
+      if (closed) {
+        throw new BlobError(
+          ErrorCode.READER_CLOSED,
+          'Reader is already closed'
+        );
+      }
+      if (eof) return null;
+      try {
+        const chunk = await streaming.readNextChunk(handleId);
+        if (chunk === null) {
+          eof = true;
+          end();
+        } else {
+          bytesRead += chunk.byteLength;
+        }
+        return chunk;
+      } catch (e) {
+        end();
+        throw e;
+      }
+    },
+    close,
+    [Symbol.dispose]: close,
+  };
+}
+
+/**
+ * Wraps a memory-mapped reader handle. The read position is tracked here;
+ * the native side only hands out views into the mapping.
+ */
+export function wrapMappedReader(
+  handleId: number,
+  fileSize: number,
+  chunkSize: number,
+  streaming: StreamingProxy
+): MappedBlobReader {
+  let closed = false;
+  let position = 0;
+  let eof = false;
+
+  const ensureOpen = () => {
+    if (closed) {
+      throw new BlobError(
+        ErrorCode.READER_CLOSED,
+        'Reader is already closed'
+      );
+    }
+  };
+
+  const close = () => {
+    if (!closed) {
+      closed = true;
+      streaming.close(handleId);
+    }
+  };
+
+  return {
+    get handleId() {
+      return handleId;
+    },
+    get fileSize() {
+      return fileSize;
+    },
+    get bytesRead() {
+      return position;
+    },
+    get isEOF() {
+      return eof;
+    },
+    readNextChunk() {
+      ensureOpen();
+      if (position >= fileSize) {
+        eof = true;
+        return Promise.resolve(null);
+      }
+      const chunk = streaming.readMapped(handleId, position, chunkSize);
+      position += chunk.byteLength;
+      return Promise.resolve(chunk);
+    },
+    readChunks(maxChunks: number, maxBytes: number = Infinity) {
+      ensureOpen();
+      validateBatch(maxChunks, maxBytes);
+      const chunks: ArrayBuffer[] = [];
+      let bytes = 0;
+      while (chunks.length < maxChunks && bytes < maxBytes) {
+        if (position >= fileSize) {
+          if (chunks.length === 0) eof = true;
+          break;
+        }
+        const chunk = streaming.readMapped(handleId, position, chunkSize);
+        position += chunk.byteLength;
+        bytes += chunk.byteLength;
+        chunks.push(chunk);
+      }
+      return Promise.resolve(chunks);
+    },
+    readAt(offset: number, length: number) {
+      ensureOpen();
+      validateRange(offset, length);
+      return Promise.resolve(streaming.readMapped(handleId, offset, length));
+    },
+    slice(offset: number, length: number) {
+      ensureOpen();
+      return streaming.readMapped(handleId, offset, length);
+    },
+    close,
+    [Symbol.dispose]: close,
+  };
+}
+
 /**
  * Wraps a native writer handle with explicit getter delegation.
  * IMPORTANT: Does NOT use spread operator on HostObject (getters would be lost).
@@ -67,13 +281,25 @@ export function wrapWriter(
     get bytesWritten() {
       return streaming.getWriterInfo(handleId).bytesWritten;
     },
+    get pendingBytes() {
+      return streaming.getWriterInfo(handleId).pendingBytes;
+    },
     /**
      * Write data to the file.
      *
      * **Backpressure warning:** Each call queues data to the native write
      * pipeline. You MUST await each write() call before issuing the next
      * one. Failing to await writes can cause unbounded memory growth as
-     * ArrayBuffer copies accumulate in the native queue.
+     * pending ArrayBuffers accumulate in the native queue.
+     *
+     * The data is written directly from the ArrayBuffer's memory without
+     * an intermediate copy. Do not modify `data` until the returned
+     * promise settles.
+     *
+     * With `writeBehind` enabled the data is copied into a bounded native
+     * buffer instead: the promise resolves at once while the buffer is
+     * under its high water mark, and acts as a "drain" signal (resolving
+     * once the backlog falls to the low water mark) when it is over.
      *
      * @example
      * ```ts
@@ -98,6 +324,24 @@ export function wrapWriter(
       }
       return streaming.write(handleId, data);
     },
+    /**
+     * Write several buffers in order with a single native call (writev),
+     * saving a bridge crossing and syscall per buffer. Resolves once with
+     * the total number of bytes written. The same backpressure and
+     * no-modification rules as write() apply to every buffer.
+     *
+     * @param buffers - The ArrayBuffers to write, in order
+     * @returns Promise resolving to the total number of bytes written
+     */
+    writev(buffers: ArrayBuffer[]) {
+      if (closed) {
+        throw new BlobError(
+          ErrorCode.WRITER_CLOSED,
+          'Writer is already closed'
+        );
+      }
+      return streaming.writev(handleId, buffers);
+    },
     flush() {
       if (closed) {
         throw new BlobError(
@@ -121,3 +365,50 @@ export function wrapWriter(
     },
   };
 }
+
+/**
+ * Wraps a native hasher handle. update() and digest() are synchronous
+ * calls into the native hasher.
+ */
+export function wrapHasher(
+  handleId: number,
+  algorithm: HashAlgorithm,
+  streaming: StreamingProxy
+): BlobHasher {
+  let closed = false;
+
+  const ensureOpen = () => {
+    if (closed) {
+      throw new BlobError(
+        ErrorCode.INVALID_ARGUMENT,
+        'Hasher is already closed'
+      );
+    }
+  };
+
+  const close = () => {
+    if (!closed) {
+      closed = true;
+      streaming.close(handleId);
+    }
+  };
+
+  return {
+    get handleId() {
+      return handleId;
+    },
+    get algorithm() {
+      return algorithm;
+    },
+    update(data: ArrayBuffer) {
+      ensureOpen();
+      streaming.updateHasher(handleId, data);
+    },
+    digest() {
+      ensureOpen();
+      return streaming.digestHasher(handleId);
+    },
+    close,
+    [Symbol.dispose]: close,
+  };
+}